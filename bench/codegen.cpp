@@ -0,0 +1,61 @@
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/runtime/inference/profiles.h"
+#include "isaac/tools/cpp/string.hpp"
+
+#include <vector>
+#include <iostream>
+#include <cmath>
+
+#include "common.hpp"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+namespace rt = isaac::runtime;
+
+//Time to generate the sources of every template of a profile, without compiling them
+long bench(drv::CommandQueue & queue, sc::expression_type etype, sc::expression_tree const & tree, size_t & bytes)
+{
+  Timer tmr;
+  rt::profiles::snapshot_type profiles = rt::profiles::get(queue);
+  std::vector< std::shared_ptr<sc::templates::base> > const & templates = profiles->at(std::make_pair(etype, tree.dtype()))->templates();
+  drv::Device const & device = queue.device();
+  std::vector<long> times;
+  double total_time = 0;
+  while(total_time*1e-9 < 1)
+  {
+    bytes = 0;
+    tmr.start();
+    for(size_t i = 0 ; i < templates.size() ; ++i)
+      bytes += templates[i]->generate(sc::tools::to_string(i), tree, device).size();
+    times.push_back(tmr.get().count());
+    total_time += times.back();
+  }
+  return median(times);
+}
+
+int main()
+{
+  drv::Context const & context = drv::backend::contexts::get_default();
+  drv::CommandQueue & queue = drv::backend::queues::get(context, 0);
+  std::cout << "Device: " << context.device().name() << std::endl;
+  std::cout << "-------------------------" << std::endl;
+
+  sc::int_t N = 1024;
+  sc::array x(N, sc::FLOAT_TYPE, context), y(N, sc::FLOAT_TYPE, context);
+  sc::array A(N, N, sc::FLOAT_TYPE, context), B(N, N, sc::FLOAT_TYPE, context), C(N, N, sc::FLOAT_TYPE, context);
+
+  std::vector<std::pair<std::string, std::pair<sc::expression_type, sc::expression_tree> > > benchmarks;
+  benchmarks.push_back(std::make_pair("axpy", std::make_pair(sc::ELEMENTWISE_1D, sc::assign(y, 2*x + y))));
+  benchmarks.push_back(std::make_pair("gemv", std::make_pair(sc::REDUCE_2D_ROWS, sc::assign(y, dot(A, x)))));
+  benchmarks.push_back(std::make_pair("gemm", std::make_pair(sc::MATRIX_PRODUCT_NN, sc::assign(C, dot(A, B)))));
+
+  for(auto const & b: benchmarks)
+  {
+    size_t bytes;
+    long time = bench(queue, b.second.first, b.second.second, bytes);
+    std::cout << b.first << ": " << time*1e-3 << "us (" << bytes << " bytes of source)" << std::endl;
+  }
+
+  std::cout << "-------------------------" << std::endl;
+}
@@ -1,54 +1,60 @@
 #include "isaac/array.h"
-#include <vector>
+#include "isaac/driver/backend.h"
+#include "isaac/driver/program.h"
+#include "isaac/driver/kernel.h"
+#include "isaac/runtime/execute.h"
 
-namespace sc = isaac;
+#include <vector>
+#include <iostream>
+#include <cmath>
 
-#ifdef BENCH_CUBLAS
-__global__ void dummy(){}
-#endif
+#include "common.hpp"
 
+namespace sc = isaac;
+namespace drv = isaac::driver;
+
+#define BENCHMARK_OVERHEAD(OP, RESULT) \
+  {\
+  std::vector<long> times;\
+  double total_time = 0;\
+  OP;\
+  queue.synchronize();\
+  while(total_time*1e-9 < 1e-1){\
+    tmr.start();\
+    OP;\
+    queue.synchronize();\
+    times.push_back(tmr.get().count());\
+    total_time+=times.back();\
+  }\
+  RESULT = median(times);\
+  }
 
 int main()
 {
-  for(sc::driver::backend::data_type::const_iterator it = sc::driver::queues.data().begin() ; it != sc::driver::queues.data().end() ; ++it)
-  {
-    cl::CommandQueue queue = it->second[0];
-    cl::Context context = it->first;
-    cl::Device device = queue.getInfo<CL_QUEUE_DEVICE>();
-    cl::Program program(context,"__kernel void dummy(){}");
-    program.build();
-    cl::Kernel kernel(program, "dummy");
-
-    cl::NDRange offset = cl::NullRange;
-    cl::NDRange global(1);
-    cl::NDRange local(1);
-
-    cl::Event event;
-    std::cout << "Device: " << device.getInfo<CL_DEVICE_NAME>() << std::endl;
-    std::cout << "-------------------------" << std::endl;
-
-    queue.enqueueNDRangeKernel(kernel, offset, global, local, NULL, &event);
-    queue.flush();
-    queue.finish();
-
-    {
-    long time = event.getProfilingInfo<CL_PROFILING_COMMAND_END>() - event.getProfilingInfo<CL_PROFILING_COMMAND_START>();
-    std::cout << "Kernel launch overhead: " << time << std::endl;
-    }
-
-#ifdef BENCH_CUBLAS
-    float time;
-    cudaEvent_t start, stop;
-    cudaEventCreate(&start);
-    cudaEventCreate(&stop);
-    cudaEventRecord(start);
-    dummy<<<1, 1>>>();
-    cudaEventRecord(stop);
-    cudaEventSynchronize(stop);
-    cudaEventElapsedTime(&time, start, stop);
-    std::cout << "CUDA Kernel launch overhead: " << time << std::endl;
-#endif
-    std::cout << "-------------------------" << std::endl;
-  }
-
+  Timer tmr;
+  drv::Context const & context = drv::backend::contexts::get_default();
+  drv::CommandQueue & queue = drv::backend::queues::get(context, 0);
+  std::cout << "Device: " << context.device().name() << std::endl;
+  std::cout << "-------------------------" << std::endl;
+
+  //Raw driver launch
+  std::string src = (context.backend()==drv::CUDA)?"extern \"C\" __global__ void dummy(){}":"__kernel void dummy(){}";
+  drv::Program program(context, src);
+  drv::Kernel kernel(program, "dummy");
+  long raw;
+  BENCHMARK_OVERHEAD(queue.enqueue(kernel, drv::NDRange(1), drv::NDRange(1), NULL, NULL), raw);
+  std::cout << "Kernel launch overhead: " << raw << "ns" << std::endl;
+
+  //ISAAC dispatch: hashing, program lookup, prediction, argument setting
+  sc::array x(1, sc::FLOAT_TYPE, context), y(1, sc::FLOAT_TYPE, context), z(1, sc::FLOAT_TYPE, context);
+  long elementwise;
+  BENCHMARK_OVERHEAD(x = y + z, elementwise);
+  std::cout << "Elementwise dispatch overhead: " << elementwise - raw << "ns" << std::endl;
+
+  sc::scalar s(sc::FLOAT_TYPE, context);
+  long reduction;
+  BENCHMARK_OVERHEAD(s = sum(y), reduction);
+  std::cout << "Reduction dispatch overhead: " << reduction - 2*raw << "ns" << std::endl;
+
+  std::cout << "-------------------------" << std::endl;
 }
@@ -61,6 +61,10 @@ def main():
     libraries = ['dl']
     library_dirs = []
 
+    #Background compilation
+    if not for_android:
+      libraries += ['pthread']
+
     #Include directories
     numpy_include = os.path.join(find_module("numpy")[1], "core", "include")
     include ='${INCLUDE_DIRECTORIES_STR}'.split() + ['external/boost/', 'external/boost/boost/', numpy_include]
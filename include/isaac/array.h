@@ -61,6 +61,8 @@ public:
   template<typename DT>
   array_base(tuple const & shape, std::vector<DT> const & data, driver::Context const & context = driver::backend::contexts::get_default());
   array_base(tuple const & shape, numeric_type dtype, driver::Context const & context = driver::backend::contexts::get_default());
+  //Zero-copy array over host memory, which must outlive it
+  array_base(tuple const & shape, numeric_type dtype, void* host, driver::Context const & context = driver::backend::contexts::get_default());
   array_base(tuple const & shape, numeric_type dtype, int_t start, tuple const & stride, driver::Context const & context = driver::backend::contexts::get_default());
   array_base(tuple const & shape, numeric_type dtype, int_t start, tuple const & stride, driver::Buffer const & data);
   explicit array_base(runtime::execution_handler const &);
@@ -144,6 +146,8 @@ public:
   array(array_base const &);
   array(array const &);
   array(expression_tree const & proxy);
+  //Copies the content
+  array & operator=(array const &);
   using array_base::operator=;
 };
 
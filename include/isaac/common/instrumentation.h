@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#ifndef ISAAC_COMMON_INSTRUMENTATION_H
+#define ISAAC_COMMON_INSTRUMENTATION_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "isaac/defines.h"
+#include "isaac/common/expression_type.h"
+
+namespace isaac
+{
+
+namespace instrumentation
+{
+
+//Instrumented events. Timed events also accumulate their duration
+enum event_type
+{
+  CODEGEN,
+  OPENCL_COMPILATION,
+  CUDA_COMPILATION,
+  BINARY_CACHE_HIT,
+  BINARY_CACHE_MISS,
+  PREDICTION,
+  NUM_EVENTS
+};
+
+static const unsigned int NUM_EXPRESSION_TYPES = MATRIX_PRODUCT_TT + 1;
+
+struct statistics_type
+{
+  struct event_statistics
+  {
+    uint64_t count;
+    double time;
+  };
+  event_statistics events[NUM_EVENTS];
+  uint64_t dispatches[NUM_EXPRESSION_TYPES];
+  //Program caches
+  size_t programs;
+  size_t program_bytes;
+  size_t program_hits;
+  size_t program_misses;
+  size_t program_evictions;
+};
+
+//Times its scope and records it as an event
+class ISAACAPI timer
+{
+public:
+  timer(event_type event);
+  ~timer();
+private:
+  event_type event_;
+  std::chrono::high_resolution_clock::time_point start_;
+};
+
+ISAACAPI void record(event_type event, uint64_t nanoseconds = 0);
+ISAACAPI void dispatch(expression_type type);
+ISAACAPI statistics_type statistics();
+ISAACAPI void reset();
+//Human-readable summary, also printed at exit when ISAAC_STATS is set
+ISAACAPI std::string summary();
+ISAACAPI const char * to_string(event_type event);
+
+}
+
+}
+
+#endif
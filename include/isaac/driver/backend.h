@@ -25,6 +25,7 @@
 #include <map>
 #include <list>
 #include <vector>
+#include <cstdint>
 
 #include "isaac/common/expression_type.h"
 #include "isaac/common/numeric_type.h"
@@ -39,11 +40,15 @@ namespace driver
 {
 
 class Buffer;
+class HostBuffer;
 class CommandQueue;
 class Context;
+class Device;
+class Event;
 class Platform;
 class Program;
 class Kernel;
+class MemoryPool;
 class ProgramCache;
 
 class ISAACAPI backend
@@ -52,21 +57,72 @@ public:
   class ISAACAPI workspaces
   {
   public:
-      static const size_t SIZE = 8000000; //8MB of temporary workspace per queue
+      static const size_t SIZE = 8000000; //8MB of temporary workspace per queue, initially
       static void release();
-      static driver::Buffer & get(CommandQueue const & key);
+      //Grows the workspace of the queue to at least size bytes
+      static driver::Buffer & get(CommandQueue const & key, size_t size = 0);
+      //Largest workspace of a queue, in bytes (ISAAC_WORKSPACE_LIMIT)
+      static size_t max_size;
   private:
       DISABLE_MSVC_WARNING_C4251
-      static std::map<CommandQueue, Buffer * > cache_;
+      static std::map<CommandQueue, std::pair<Buffer *, size_t> > cache_;
       RESTORE_MSVC_WARNING_C4251
   };
 
+  //Page-locked host memory through which large transfers are pipelined
+  class ISAACAPI staging
+  {
+  public:
+      static const size_t CHUNK = 4 << 20; //Each queue stages two chunks of 4MB
+      static void release();
+      static HostBuffer & get(CommandQueue const & key);
+      //Transfers bypass the staging memory when ISAAC_STAGING=0
+      static bool enabled;
+  private:
+      DISABLE_MSVC_WARNING_C4251
+      static std::map<CommandQueue, HostBuffer *> cache_;
+      RESTORE_MSVC_WARNING_C4251
+  };
+
+  class ISAACAPI pools
+  {
+      friend class backend;
+  public:
+      static void release();
+      static MemoryPool & get(Context const & context);
+      //Gives the unused memory of every pool back to the driver
+      static void trim();
+      //Buffers bypass the pools when ISAAC_MEMORY_POOL=0
+      static bool enabled;
+  private:
+DISABLE_MSVC_WARNING_C4251
+      static std::map<Context, MemoryPool * > cache_;
+RESTORE_MSVC_WARNING_C4251
+  };
+
   class ISAACAPI programs
   {
       friend class backend;
   public:
+      struct statistics_type
+      {
+          statistics_type(): size(0), bytes(0), hits(0), misses(0), evictions(0), collisions(0){}
+          size_t size;
+          size_t bytes;
+          size_t hits;
+          size_t misses;
+          size_t evictions;
+          size_t collisions;
+      };
+
       static void release();
       static ProgramCache & get(CommandQueue const & queue, expression_type expression, numeric_type dtype);
+      static statistics_type statistics();
+      //Loads a bundle of pre-compiled binaries (see runtime::warmup)
+      static void load(std::string const & bundle);
+      //Budget of each cache (0 means unbounded)
+      static size_t max_entries;
+      static size_t max_bytes;
   private:
 DISABLE_MSVC_WARNING_C4251
       static std::map<std::tuple<CommandQueue, expression_type, numeric_type>, ProgramCache * > cache_;
@@ -95,6 +151,8 @@ RESTORE_MSVC_WARNING_C4251
       static Context const & get_default();
       static Context const & import(CUcontext context);
       static Context const & import(cl_context context);
+      //Context of a device outside of the default ones (e.g. a sub-device), created on first use
+      static Context const & get(Device const & device);
       static void get(std::list<Context const *> &);
   private:
 DISABLE_MSVC_WARNING_C4251
@@ -110,13 +168,46 @@ RESTORE_MSVC_WARNING_C4251
       static void release();
   public:
       static void get(Context const &, std::vector<CommandQueue *> &queues);
+      //Queues are created on demand, up to the requested id
       static CommandQueue & get(Context const &, unsigned int id = 0);
+      static size_t size(Context const &);
+      //Default queue of the calling thread. Each thread is lazily given the lowest id
+      //no other thread holds, so that threads submit to the device concurrently
+      static unsigned int current();
+      //Makes a queue the default one of the calling thread (see also queue_guard)
+      static void set_current(unsigned int id);
+      //Reserves an id that no thread gets as its default queue, until it is relinquished
+      static unsigned int acquire();
+      static void relinquish(unsigned int id);
+      //Every thread defaults to queue 0 when ISAAC_THREAD_QUEUES=0
+      static bool per_thread;
   private:
 DISABLE_MSVC_WARNING_C4251
       static std::map< Context, std::vector<CommandQueue*> > cache_;
 RESTORE_MSVC_WARNING_C4251
   };
 
+  //Commands touching each buffer, so that commands crossing queues wait for the conflicting ones.
+  //Events are only recorded once a buffer is used by a second queue
+  class ISAACAPI accesses
+  {
+      friend class backend;
+  private:
+      static void release();
+  public:
+      //Only needed once a context has several queues
+      static bool enabled(Context const & context);
+      //Appends the events a command on the given queue must wait for before reading and writing the buffers.
+      //Returns whether one of them is shared with another queue, in which case the command must be recorded
+      static bool dependencies(CommandQueue const & queue, std::vector<uintptr_t> const & reads, std::vector<uintptr_t> const & writes, std::vector<Event> & events);
+      //Records that the event, on the given queue, reads and writes the buffers
+      static void record(CommandQueue const & queue, std::vector<uintptr_t> const & reads, std::vector<uintptr_t> const & writes, Event const & event);
+      //Forgets a buffer being destroyed. Appends the queues it was used on without being recorded,
+      //and the events of the commands it is still used by
+      static void retire(uintptr_t buffer, std::vector<CommandQueue> & queues, std::vector<std::pair<CommandQueue, Event> > & events);
+      static uintptr_t key(Buffer const & buffer);
+  };
+
   static void init();
   static void release();
 
@@ -128,6 +219,16 @@ public:
   static cl_command_queue_properties default_queue_properties;
 };
 
+//Makes a queue the default one of the calling thread, for the lifetime of the guard
+class ISAACAPI queue_guard
+{
+public:
+  explicit queue_guard(unsigned int id);
+  ~queue_guard();
+private:
+  unsigned int previous_;
+};
+
 }
 }
 
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+
+#ifndef ISAAC_DRIVER_BINARY_CACHE_H
+#define ISAAC_DRIVER_BINARY_CACHE_H
+
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "isaac/defines.h"
+
+namespace isaac
+{
+
+namespace driver
+{
+
+//On-disk cache of compiled binaries. Entries are written to a temporary file
+//and synced before they are renamed, and carry a version tag and a checksum.
+//Each process counts the bytes it adds to the directory, which is only scanned
+//when that count passes max_size: the least recently used entries are then
+//evicted, down to three quarters of max_size. On Windows, where
+//the directory lock is a no-op, processes only rely on unique temporaries.
+//Entries can also be captured and packed into a single relocatable bundle,
+//which is looked up before the disk.
+class ISAACAPI BinaryCache
+{
+private:
+    std::string entry(std::string const & key) const;
+    std::string lock() const;
+    size_t evict(std::string const & keep = "") const;
+    bool read(std::istream & is, std::vector<char> & binary) const;
+    void write(std::ostream & os, std::vector<char> const & binary) const;
+    void capture(std::string const & key, std::vector<char> const & binary) const;
+
+public:
+    //Constructors
+    BinaryCache(std::string const & path, std::string const & tag);
+    //Loading an entry; returns false if missing or invalid
+    bool load(std::string const & key, std::vector<char> & binary) const;
+    //Storing an entry
+    void store(std::string const & key, std::vector<char> const & binary) const;
+    //Whether stored entries are kept, on disk or in a capture
+    bool enabled() const;
+    //Evicting entries until the cache fits in max_size
+    void trim() const;
+
+    //Bundles
+    static void import(std::string const & path);
+    static void start_capture();
+    static void stop_capture();
+    static void save_capture(std::string const & path);
+
+    static size_t max_size;
+
+private:
+DISABLE_MSVC_WARNING_C4251
+    std::string path_;
+    std::string tag_;
+    static std::mutex mutex_;
+    static std::map<std::string, std::string> bundle_;
+    static std::map<std::string, std::string> captured_;
+    static bool capture_;
+    static std::map<std::string, size_t> usage_;
+RESTORE_MSVC_WARNING_C4251
+};
+
+}
+
+}
+
+#endif
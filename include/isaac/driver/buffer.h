@@ -28,6 +28,9 @@
 #include "isaac/driver/context.h"
 #include "isaac/driver/handle.h"
 #include "isaac/driver/dispatch.h"
+
+#include <memory>
+
 namespace isaac
 {
 
@@ -56,14 +59,38 @@ public:
   Buffer(CUdeviceptr h = 0, bool take_ownership = true);
   Buffer(cl_mem Buffer = 0, bool take_ownership = true);
   Buffer(Context const & context, size_t size);
+  //Zero-copy buffer over host memory, which must outlive it
+  Buffer(Context const & context, size_t size, void* host);
   //Accessors
   handle_type&  handle();
   handle_type const &  handle() const;
   Context const & context() const;
+  //Host memory backing the buffer, if any (see CommandQueue::map)
+  void* host() const;
 private:
   backend_type backend_;
   Context context_;
   handle_type h_;
+  void* host_;
+DISABLE_MSVC_WARNING_C4251
+  //Pooled block or registered host memory backing h_, if any, which also forgets the commands
+  //touching h_ (see backend::accesses) once the last copy of the buffer is gone
+  std::shared_ptr<void> block_;
+RESTORE_MSVC_WARNING_C4251
+};
+
+//Page-locked host memory, for fast and asynchronous transfers
+class ISAACAPI HostBuffer
+{
+public:
+  HostBuffer(Context const & context, size_t size);
+  void* data() const;
+  size_t size() const;
+private:
+  size_t size_;
+DISABLE_MSVC_WARNING_C4251
+  std::shared_ptr<void> data_;
+RESTORE_MSVC_WARNING_C4251
 };
 
 inline Buffer make_buffer(backend_type backend, cl_mem clh = 0, CUdeviceptr cuh = 0, bool take_ownership = true)
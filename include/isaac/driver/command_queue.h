@@ -22,7 +22,9 @@
 #ifndef ISAAC_DRIVER_COMMAND_QUEUE_H
 #define ISAAC_DRIVER_COMMAND_QUEUE_H
 
+#include <cstdint>
 #include <map>
+#include <vector>
 #include "isaac/defines.h"
 #include "isaac/driver/common.h"
 #include "isaac/driver/context.h"
@@ -58,13 +60,31 @@ public:
   Device const & device() const;
   //Synchronize
   void synchronize();
+  //Submits the commands enqueued so far to the device
+  void flush();
+  //Event completing with the commands enqueued so far
+  void marker(Event & event);
   //Profiling
   void enable_profiling();
   void disable_profiling();
   //Enqueue calls
   void enqueue(Kernel const & kernel, NDRange global, driver::NDRange local, std::vector<Event> const *, Event *event);
-  void write(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t size, void const* ptr);
-  void read(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t size, void* ptr);
+  void write(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t size, void const* ptr, Event* event = NULL);
+  void read(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t size, void* ptr, Event* event = NULL);
+  //Repeats the pattern over size bytes of the buffer. The pattern need not outlive the call
+  void fill(Buffer const & buffer, std::size_t offset, std::size_t size, void const* pattern, std::size_t pattern_size, Event* event = NULL);
+  //Copies height rows of width bytes, which are pitch bytes apart in the buffer and host_pitch bytes apart on the host
+  void write_rect(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t pitch, std::size_t width, std::size_t height, void const* ptr, std::size_t host_pitch, Event* event = NULL);
+  void read_rect(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t pitch, std::size_t width, std::size_t height, void* ptr, std::size_t host_pitch, Event* event = NULL);
+  //Host view of a region of the buffer, valid until unmap. CUDA only maps buffers backed by host memory
+  void* map(Buffer const & buffer, std::size_t offset, std::size_t size);
+  void unmap(Buffer const & buffer, void* ptr);
+
+private:
+  static std::vector<cl_event> events(std::vector<Event> const & events);
+  //Waits for the other queues touching the buffer, if any, and tells whether the command must be recorded (see backend::accesses)
+  bool track(Buffer const & buffer, bool write, std::vector<Event> & dependencies);
+  void record(Buffer const & buffer, bool write, Event const & event);
 
 private:
   backend_type backend_;
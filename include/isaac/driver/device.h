@@ -27,6 +27,10 @@
 #include "isaac/driver/platform.h"
 #include "isaac/driver/handle.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace isaac
 {
 
@@ -85,10 +89,42 @@ public:
       UNKNOWN
   };
 
+  //Properties, queried once per device
+  struct properties_type
+  {
+    properties_type(Platform const & _platform): platform(_platform){}
+    Platform platform;
+    std::string name;
+    std::string vendor_str;
+    std::string extensions;
+    Vendor vendor;
+    Architecture architecture;
+    Type type;
+    unsigned int address_bits;
+    size_t clock_rate;
+    size_t compute_units;
+    size_t global_mem_size;
+    size_t local_mem_size;
+    size_t mem_base_addr_align;
+    size_t max_work_group_size;
+    std::vector<size_t> max_work_item_sizes;
+    size_t warp_wavefront_size;
+    std::pair<unsigned int, unsigned int> nv_compute_capability;
+    bool fp64_support;
+    bool host_unified_memory;
+    bool fill_support;
+    unsigned int max_sub_devices;
+    bool numa_partition_support;
+  };
+
 private:
   //Metaprogramming elper to get cuda info from attribute
   template<CUdevice_attribute attr>
   int cuGetInfo() const;
+  //Queries the driver
+  properties_type query() const;
+  //Shares the properties of all the copies of a device
+  std::shared_ptr<properties_type const> snapshot() const;
 
 public:
   //Constructors
@@ -96,11 +132,13 @@ public:
   explicit Device(cl_device_id const & device, bool take_ownership = true);
   //Accessors
   handle_type const & handle() const;
+  properties_type const & properties() const;
   Vendor vendor() const;
   Architecture architecture() const;
   backend_type backend() const;
   //Informations
   std::string infos() const;
+  //In MHz
   size_t clock_rate() const;
   unsigned int address_bits() const;
   driver::Platform platform() const;
@@ -111,13 +149,29 @@ public:
   std::string extensions() const;
   size_t max_work_group_size() const;
   size_t local_mem_size() const;
+  size_t global_mem_size() const;
+  size_t compute_units() const;
+  size_t mem_base_addr_align() const;
   size_t warp_wavefront_size() const;
   bool fp64_support() const;
+  //Device memory is host memory (CPUs, integrated GPUs)
+  bool host_unified_memory() const;
+  //Buffers can be filled asynchronously from a pattern (OpenCL 1.2)
+  bool fill_support() const;
+  //Sub-devices the device can be split in (OpenCL 1.2), 0 if it cannot be partitioned
+  unsigned int max_sub_devices() const;
+  //Sub-devices sharing a NUMA node. A device that cannot be partitioned is its only sub-device
+  void partition_numa(std::vector<Device> & devices) const;
+  //Sub-devices of the given number of compute units each
+  void partition_equally(size_t compute_units, std::vector<Device> & devices) const;
   std::pair<unsigned int, unsigned int> nv_compute_capability() const;
 
 private:
   backend_type backend_;
   handle_type h_;
+DISABLE_MSVC_WARNING_C4251
+  std::shared_ptr<properties_type const> properties_;
+RESTORE_MSVC_WARNING_C4251
 };
 
 }
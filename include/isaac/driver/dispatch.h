@@ -22,6 +22,8 @@
 #ifndef ISAAC_DRIVER_DISPATCHER_H
 #define ISAAC_DRIVER_DISPATCHER_H
 
+#include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <dlfcn.h>
 
@@ -59,12 +61,16 @@ private:
     {
         initializer();
         if(cache == nullptr)
-            cache = dlsym(lib_h, name);
+            cache = symbol(lib_h, name);
+        if(cache == nullptr)
+            throw std::runtime_error(std::string("ISAAC: unable to load ") + name);
         FunPtrT fptr;
         *reinterpret_cast<void **>(&fptr) = cache;
         return (*fptr)(args...);
     }
 
+    static void* symbol(void* lib_h, const char * name);
+
 public:
     static bool clinit();
     static bool cuinit();
@@ -88,6 +94,7 @@ public:
     static cl_int clReleaseDevice(cl_device_id);
     static cl_context clCreateContext(const cl_context_properties *, cl_uint, const cl_device_id *, void (*)(const char *, const void *, size_t, void *), void *, cl_int *);
     static cl_int clGetDeviceIDs(cl_platform_id, cl_device_type, cl_uint, cl_device_id *, cl_uint *);
+    static cl_int clCreateSubDevices(cl_device_id, const cl_device_partition_property *, cl_uint, cl_device_id *, cl_uint *);
     static cl_int clGetContextInfo(cl_context, cl_context_info, size_t, void *, size_t *);
     static cl_int clGetDeviceInfo(cl_device_id, cl_device_info, size_t, void *, size_t *);
     static cl_int clReleaseCommandQueue(cl_command_queue);
@@ -104,8 +111,16 @@ public:
     static cl_int clGetKernelWorkGroupInfo(cl_kernel, cl_device_id, cl_kernel_work_group_info, size_t, void *, size_t *);
     static cl_kernel clCreateKernel(cl_program, const char *, cl_int *);
     static cl_mem clCreateBuffer(cl_context, cl_mem_flags, size_t, void *, cl_int *);
+    static cl_mem clCreateSubBuffer(cl_mem, cl_mem_flags, cl_buffer_create_type, const void *, cl_int *);
     static cl_program clCreateProgramWithSource(cl_context, cl_uint, const char **, const size_t *, cl_int *);
     static cl_int clReleaseKernel(cl_kernel);
+    static void* clEnqueueMapBuffer(cl_command_queue, cl_mem, cl_bool, cl_map_flags, size_t, size_t, cl_uint, const cl_event *, cl_event *, cl_int *);
+    static cl_int clEnqueueUnmapMemObject(cl_command_queue, cl_mem, void *, cl_uint, const cl_event *, cl_event *);
+    static cl_int clEnqueueMarkerWithWaitList(cl_command_queue, cl_uint, const cl_event *, cl_event *);
+    static cl_int clWaitForEvents(cl_uint, const cl_event *);
+    static cl_int clEnqueueWriteBufferRect(cl_command_queue, cl_mem, cl_bool, const size_t *, const size_t *, const size_t *, size_t, size_t, size_t, size_t, const void *, cl_uint, const cl_event *, cl_event *);
+    static cl_int clEnqueueFillBuffer(cl_command_queue, cl_mem, const void *, size_t, size_t, size_t, cl_uint, const cl_event *, cl_event *);
+    static cl_int clEnqueueReadBufferRect(cl_command_queue, cl_mem, cl_bool, const size_t *, const size_t *, const size_t *, size_t, size_t, size_t, size_t, void *, cl_uint, const cl_event *, cl_event *);
 
     //CUDA
     static CUresult cuCtxDestroy_v2(CUcontext ctx);
@@ -118,6 +133,7 @@ public:
     static CUresult cuMemcpyDtoHAsync_v2(void *dstHost, CUdeviceptr srcDevice, size_t ByteCount, CUstream hStream);
     static CUresult cuDriverGetVersion(int *driverVersion);
     static CUresult cuDeviceGetName(char *name, int len, CUdevice dev);
+    static CUresult cuDeviceTotalMem_v2(size_t *bytes, CUdevice dev);
     static CUresult cuMemcpyHtoDAsync_v2(CUdeviceptr dstDevice, const void *srcHost, size_t ByteCount, CUstream hStream);
     static CUresult cuModuleLoad(CUmodule *module, const char *fname);
     static CUresult cuLaunchKernel(CUfunction f, unsigned int gridDimX, unsigned int gridDimY, unsigned int gridDimZ, unsigned int blockDimX, unsigned int blockDimY, unsigned int blockDimZ, unsigned int sharedMemBytes, CUstream hStream, void **kernelParams, void **extra);
@@ -136,6 +152,20 @@ public:
     static CUresult cuMemAlloc_v2(CUdeviceptr *dptr, size_t bytesize);
     static CUresult cuPointerGetAttribute(void * data, CUpointer_attribute attribute, CUdeviceptr ptr);
     static CUresult cuCtxGetDevice(CUdevice* result);
+    static CUresult cuCtxPushCurrent_v2(CUcontext ctx);
+    static CUresult cuCtxPopCurrent_v2(CUcontext *pctx);
+    static CUresult cuStreamWaitEvent(CUstream hStream, CUevent hEvent, unsigned int Flags);
+    static CUresult cuMemHostAlloc(void **pp, size_t bytesize, unsigned int Flags);
+    static CUresult cuMemFreeHost(void *p);
+    static CUresult cuMemHostGetDevicePointer_v2(CUdeviceptr *pdptr, void *p, unsigned int Flags);
+    static CUresult cuMemHostRegister_v2(void *p, size_t bytesize, unsigned int Flags);
+    static CUresult cuMemHostUnregister(void *p);
+    static CUresult cuEventSynchronize(CUevent hEvent);
+    static CUresult cuMemcpy2D_v2(const CUDA_MEMCPY2D *pCopy);
+    static CUresult cuMemcpy2DAsync_v2(const CUDA_MEMCPY2D *pCopy, CUstream hStream);
+    static CUresult cuMemsetD8Async(CUdeviceptr dstDevice, unsigned char uc, size_t N, CUstream hStream);
+    static CUresult cuMemsetD16Async(CUdeviceptr dstDevice, unsigned short us, size_t N, CUstream hStream);
+    static CUresult cuMemsetD32Async(CUdeviceptr dstDevice, unsigned int ui, size_t N, CUstream hStream);
 
     static nvrtcResult nvrtcCompileProgram(nvrtcProgram prog, int numOptions, const char **options);
     static nvrtcResult nvrtcGetProgramLogSize(nvrtcProgram prog, size_t *logSizeRet);
@@ -165,6 +195,7 @@ private:
     static void* clReleaseDevice_;
     static void* clCreateContext_;
     static void* clGetDeviceIDs_;
+    static void* clCreateSubDevices_;
     static void* clGetContextInfo_;
     static void* clGetDeviceInfo_;
     static void* clReleaseCommandQueue_;
@@ -181,8 +212,16 @@ private:
     static void* clGetKernelWorkGroupInfo_;
     static void* clCreateKernel_;
     static void* clCreateBuffer_;
+    static void* clCreateSubBuffer_;
     static void* clCreateProgramWithSource_;
     static void* clReleaseKernel_;
+    static void* clEnqueueMapBuffer_;
+    static void* clEnqueueUnmapMemObject_;
+    static void* clEnqueueMarkerWithWaitList_;
+    static void* clWaitForEvents_;
+    static void* clEnqueueWriteBufferRect_;
+    static void* clEnqueueReadBufferRect_;
+    static void* clEnqueueFillBuffer_;
 
     //CUDA
     static void* cuCtxDestroy_v2_;
@@ -195,6 +234,7 @@ private:
     static void* cuMemcpyDtoHAsync_v2_;
     static void* cuDriverGetVersion_;
     static void* cuDeviceGetName_;
+    static void* cuDeviceTotalMem_v2_;
     static void* cuMemcpyHtoDAsync_v2_;
     static void* cuModuleLoad_;
     static void* cuLaunchKernel_;
@@ -213,6 +253,20 @@ private:
     static void* cuMemAlloc_v2_;
     static void* cuPointerGetAttribute_;
     static void* cuCtxGetDevice_;
+    static void* cuCtxPushCurrent_v2_;
+    static void* cuCtxPopCurrent_v2_;
+    static void* cuStreamWaitEvent_;
+    static void* cuMemHostAlloc_;
+    static void* cuMemFreeHost_;
+    static void* cuMemHostGetDevicePointer_v2_;
+    static void* cuMemHostRegister_v2_;
+    static void* cuMemHostUnregister_;
+    static void* cuEventSynchronize_;
+    static void* cuMemcpy2D_v2_;
+    static void* cuMemcpy2DAsync_v2_;
+    static void* cuMemsetD8Async_;
+    static void* cuMemsetD16Async_;
+    static void* cuMemsetD32Async_;
 
     static void* nvrtcCompileProgram_;
     static void* nvrtcGetProgramLogSize_;
@@ -47,6 +47,8 @@ public:
   Event(backend_type backend);
   //Accessors
   handle_type const & handle() const;
+  //Waits for the command to complete
+  void synchronize() const;
   //Profiling
   long elapsed_time() const;
 
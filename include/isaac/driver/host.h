@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#ifndef ISAAC_DRIVER_HOST_H
+#define ISAAC_DRIVER_HOST_H
+
+#include <string>
+#include <vector>
+
+#include "isaac/defines.h"
+
+namespace isaac
+{
+namespace driver
+{
+
+/** @brief Execution of the generated kernels on the host
+ *
+ *  Enabled by ISAAC_BACKEND=host, or by enable() before any other call to ISAAC. The in-process
+ *  platform of driver::recording then exposes a CPU device and runs the kernels it records:
+ *  programs are compiled by the system compiler (ISAAC_HOST_COMPILER, c++ by default) into
+ *  shared objects, which the binary cache of Program keeps in Context::cache_path(), and
+ *  work-groups are spread over a thread pool.
+ */
+class ISAACAPI host
+{
+public:
+  //Shared object built from OpenCL C sources
+  class ISAACAPI module
+  {
+  public:
+    module(std::string const & source, std::string const & options);
+    module(std::vector<char> const & binary);
+    ~module();
+    std::vector<char> const & binary() const;
+    bool has(std::string const & name) const;
+    //Runs the given kernel. Arguments point to their values, buffers to their host pointer
+    void launch(std::string const & name, std::vector<void*> const & arguments, unsigned int work_dim, const size_t * global, const size_t * local) const;
+
+  private:
+    module(module const &);
+    module & operator=(module const &);
+    void load();
+
+  private:
+DISABLE_MSVC_WARNING_C4251
+    std::vector<char> binary_;
+RESTORE_MSVC_WARNING_C4251
+    void* handle_;
+    bool barriers_;
+  };
+
+public:
+  static void enable();
+  static bool enabled();
+  static unsigned int threads();
+  //Instruction set of the compiled kernels: native- followed by a hash of the CPU features, or generic when
+  //they are unknown. It is part of the driver version, so that hosts never share cached kernels they cannot run
+  static std::string const & target();
+};
+
+}
+}
+
+#endif
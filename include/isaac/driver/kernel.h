@@ -28,7 +28,8 @@
 #include "isaac/driver/handle.h"
 #include "isaac/value_scalar.h"
 
-#include <memory>
+#include <cstddef>
+#include <vector>
 
 namespace isaac
 {
@@ -44,6 +45,10 @@ class ISAACAPI Kernel: public has_handle_comparators<Kernel>
   friend class CommandQueue;
 public:
   typedef Handle<cl_kernel, CUfunction> handle_type;
+  //CUDA arguments of index i live at offset i*cu_param_size: inline for the first
+  //cu_inline_size bytes, on the heap only for kernels with more arguments
+  static const std::size_t cu_param_size = 8;
+  static const std::size_t cu_inline_size = 256;
 
 public:
   //Constructors
@@ -58,10 +63,14 @@ public:
   template<class T> void setArg(unsigned int index, T value) { setArg(index, sizeof(T), (void*)&value); }
 
 private:
+  char* cu_data();
+  char const * cu_data() const;
+
   backend_type backend_;
   unsigned int address_bits_;
-  std::vector<std::shared_ptr<void> >  cu_params_store_;
-  std::vector<void*>  cu_params_;
+  unsigned int cu_nparams_;
+  alignas(16) char cu_inline_[cu_inline_size];
+  std::vector<char> cu_heap_;
   handle_type h_;
 };
 
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#ifndef ISAAC_DRIVER_MEMORY_POOL_H
+#define ISAAC_DRIVER_MEMORY_POOL_H
+
+#include <memory>
+
+#include "isaac/defines.h"
+#include "isaac/driver/buffer.h"
+
+namespace isaac
+{
+
+namespace driver
+{
+
+class CommandQueue;
+
+//Caching allocator of device memory.
+//Requests are rounded up to size classes. Small classes are carved out of larger slabs on demand
+//(offsets on CUDA, sub-buffers on OpenCL) and released blocks are kept around for reuse.
+class ISAACAPI MemoryPool
+{
+public:
+    struct statistics_type
+    {
+        statistics_type(): reserved(0), in_use(0), peak(0), slabs(0), hits(0), misses(0){}
+        size_t reserved;
+        size_t in_use;
+        size_t peak;
+        size_t slabs;
+        size_t hits;
+        size_t misses;
+    };
+
+    //Size classes up to SMALL_SIZE share slabs of SLAB_SIZE bytes
+    static const size_t SMALL_SIZE = 1 << 20;
+    static const size_t SLAB_SIZE = 1 << 21;
+
+private:
+    struct slab_type;
+    struct block_type;
+    struct state_type;
+    struct releaser;
+
+    static void trim(state_type & state);
+
+public:
+    //Constructors
+    MemoryPool(Context const & context);
+    //Hands out a block of at least size bytes, which returns to the pool when owner is released.
+    //A cached block is reused right away by the queue it was last used on; other queues first wait for
+    //the commands that may still use it.
+    Buffer::handle_type allocate(size_t size, CommandQueue & queue, std::shared_ptr<void> & owner);
+    //Gives the unused slabs back to the driver
+    void trim();
+    //Metrics
+    statistics_type statistics() const;
+    size_t size_class(size_t size) const;
+
+private:
+DISABLE_MSVC_WARNING_C4251
+    std::shared_ptr<state_type> state_;
+RESTORE_MSVC_WARNING_C4251
+};
+
+}
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 #define ISAAC_DRIVER_PROGRAM_H
 
 #include <map>
+#include <vector>
 
 #include "isaac/defines.h"
 #include "isaac/driver/common.h"
@@ -37,6 +38,34 @@ namespace driver
 class Context;
 class Device;
 
+//Options forwarded to the device compiler
+struct ISAACAPI CompilerOptions
+{
+  CompilerOptions();
+  //Flags for the given device's compiler
+  std::vector<std::string> flags(Device const & device) const;
+  //Source as compiled (unroll hints)
+  std::string apply(std::string const & source) const;
+  //Identifies the options in program keys
+  std::string fingerprint() const;
+  uint64_t hash() const;
+
+  //-cl-fast-relaxed-math / --use_fast_math
+  bool fast_math;
+  //-cl-denorms-are-zero / --ftz=true
+  bool denormals_are_zero;
+  //-cl-mad-enable / --fmad=true
+  bool mad_enable;
+  //Factor given to bare '#pragma unroll' (0: left to the compiler)
+  unsigned int unroll;
+  //Registers per thread on NVIDIA devices (0: no cap)
+  unsigned int max_registers;
+  //Additional flags, space-separated
+DISABLE_MSVC_WARNING_C4251
+  std::string extra;
+RESTORE_MSVC_WARNING_C4251
+};
+
 class ISAACAPI Program: public has_handle_comparators<Program>
 {
 public:
@@ -47,10 +76,11 @@ private:
 
 public:
   //Constructors
-  Program(Context const & context, std::string const & source);
+  Program(Context const & context, std::string const & source, CompilerOptions const & options = CompilerOptions());
   //Accessors
   handle_type const & handle() const;
   Context const & context() const;
+  std::string const & source() const;
 
 private:
 DISABLE_MSVC_WARNING_C4251
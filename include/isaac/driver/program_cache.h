@@ -22,7 +22,11 @@
 #ifndef ISAAC_DRIVER_PROGRAM_CACHE_H
 #define ISAAC_DRIVER_PROGRAM_CACHE_H
 
-#include <map>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
 #include "isaac/defines.h"
 #include "isaac/driver/program.h"
 
@@ -32,21 +36,65 @@ namespace isaac
 namespace driver
 {
 
+//Programs are identified by a 64-bit hash of a fingerprint of the expression structure, so that
+//lookups never require generating the source. The fingerprint is stored next to the key and
+//compared on every insertion and lookup, so that colliding keys never share a program
 class ISAACAPI ProgramCache
 {
     friend class backend;
 
 public:
+    struct statistics_type
+    {
+        statistics_type(): size(0), bytes(0), hits(0), misses(0), evictions(0), collisions(0){}
+        size_t size;
+        size_t bytes;
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+        size_t collisions;
+    };
+
+private:
+    struct entry_type
+    {
+        uint64_t key;
+        std::string fingerprint;
+        uint64_t scope;
+        size_t bytes;
+        Program program;
+    };
+    typedef std::list<entry_type> lru_type;
+
+    void evict();
+    void erase(lru_type::iterator it);
+
+public:
+    //Constructors
+    ProgramCache(size_t max_entries, size_t max_bytes);
     //Clearing the cache
     void clear();
-    //Adding a program to the cache
-    Program & add(Context const & context, std::string const & name, std::string const & src);
-    //Finding a program in the cache
-    Program const *find(std::string const & name);
+    //Dropping the programs of a given scope (e.g., a profile)
+    void invalidate(uint64_t scope);
+    //Adding a program to the cache. Programs are returned by value, since other threads may evict them
+    Program add(Context const & context, uint64_t key, std::string const & fingerprint, std::string const & src, uint64_t scope = 0, CompilerOptions const & options = CompilerOptions());
+    //Adding a program compiled elsewhere (e.g., in a background thread)
+    Program add(uint64_t key, std::string const & fingerprint, Program const & program, uint64_t scope = 0);
+    //Full source of a program, as compiled by add()
+    static std::string prepare(Context const & context, std::string const & src);
+    //Finding a program in the cache (NULL if absent, or if the key belongs to another fingerprint)
+    std::unique_ptr<Program> find(uint64_t key, std::string const & fingerprint);
+    //Metrics
+    statistics_type statistics() const;
 
 private:
+    size_t max_entries_;
+    size_t max_bytes_;
+    statistics_type statistics_;
 DISABLE_MSVC_WARNING_C4251
-    std::map<std::string, Program> cache_;
+    mutable std::mutex mutex_;
+    lru_type lru_;
+    std::unordered_map<uint64_t, lru_type::iterator> index_;
 RESTORE_MSVC_WARNING_C4251
 };
 
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#ifndef ISAAC_DRIVER_RECORDING_H
+#define ISAAC_DRIVER_RECORDING_H
+
+#include <string>
+#include <vector>
+
+#include "isaac/defines.h"
+
+namespace isaac
+{
+namespace driver
+{
+
+/** @brief In-process OpenCL platform that records commands instead of executing them
+ *
+ *  Enabled by ISAAC_BACKEND=recording, or by enable() before any other call to ISAAC. The
+ *  driver then resolves the OpenCL entry points to this platform instead of libOpenCL, and
+ *  ignores CUDA. Kernels are generated and "built" as usual but never run: buffers are plain
+ *  host memory, so transfers round-trip while kernel outputs keep their previous content.
+ *  This makes the dispatch decisions (fusion, caching, launch configurations) observable
+ *  without a device, and isolates the host overhead of ISAAC in benchmarks. The device is
+ *  unknown to the inference database, so it does not advertise double precision.
+ *  In host mode (see driver::host), the platform also runs the kernels it records.
+ */
+class ISAACAPI recording
+{
+public:
+  struct argument_type
+  {
+    std::vector<char> value;
+    //Index of the buffer passed, in creation order, or -1 for other arguments
+    long buffer;
+  };
+
+  struct command_type
+  {
+    enum kind_type
+    {
+      KERNEL,
+      WRITE,
+      READ,
+      FILL,
+      MAP,
+      UNMAP,
+      MARKER
+    };
+    kind_type kind;
+    //Index of the queue, in creation order
+    unsigned int queue;
+    //Kernels only
+    std::string name;
+    std::vector<argument_type> arguments;
+    std::vector<size_t> global;
+    std::vector<size_t> local;
+    //Transfers only
+    long buffer;
+    size_t bytes;
+    //Events waited for
+    size_t dependencies;
+  };
+
+  struct build_type
+  {
+    std::string source;
+    std::string options;
+    //Built from a cached binary rather than from source
+    bool binary;
+  };
+
+public:
+  static void enable();
+  static bool enabled();
+  //Commands enqueued and programs built so far
+  static std::vector<command_type> commands();
+  static std::vector<build_type> builds();
+  static void clear();
+  //Entry point of the platform for the given OpenCL function, NULL if not implemented
+  static void* symbol(const char * name);
+};
+
+}
+}
+
+#endif
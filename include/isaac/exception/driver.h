@@ -146,6 +146,7 @@ namespace ocl
    ISAAC_CREATE_CL_EXCEPTION(image_format_not_supported,        "image format not supported");
    ISAAC_CREATE_CL_EXCEPTION(build_program_failure,             "build program failure");
    ISAAC_CREATE_CL_EXCEPTION(map_failure,                       "map failure");
+   ISAAC_CREATE_CL_EXCEPTION(device_partition_failed,           "device partition failed");
    ISAAC_CREATE_CL_EXCEPTION(invalid_value,                     "invalid value");
    ISAAC_CREATE_CL_EXCEPTION(invalid_device_type,               "invalid device type");
    ISAAC_CREATE_CL_EXCEPTION(invalid_platform,                  "invalid platform");
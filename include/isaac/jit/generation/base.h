@@ -83,6 +83,7 @@ public:
   };
 private:
   virtual std::string generate_impl(std::string const & suffix, expression_tree const & expressions, driver::Device const & device, symbolic::symbols_table const & mapping) const = 0;
+  virtual std::string specialize_impl(std::string const & suffix, expression_tree const & expressions, driver::Device const & device, symbolic::symbols_table const & mapping) const;
 public:
   base(fusion_policy_t fusion_policy);
   virtual unsigned int temporary_workspace(expression_tree const &) const;
@@ -91,6 +92,8 @@ public:
   virtual std::vector<int_t> input_sizes(expression_tree const & expressions) const = 0;
   virtual ~base();
   std::string generate(std::string const & suffix, expression_tree const & expressions, driver::Device const & device);
+  //Same kernels, with the sizes and strides of the expression as constants. Empty if not supported
+  std::string specialize(std::string const & suffix, expression_tree const & expressions, driver::Device const & device);
   virtual int is_invalid(expression_tree const & expressions, driver::Device const & device) const = 0;
   virtual void enqueue(driver::CommandQueue & queue, driver::Program const & program, std::string const & suffix, runtime::execution_handler const & expressions) = 0;
   virtual std::shared_ptr<base> clone() const = 0;
@@ -66,9 +66,11 @@ private:
   unsigned int lmem_usage(expression_tree const & expressions) const;
   unsigned int registers_usage(expression_tree const & expressions) const;
   int is_invalid_impl(driver::Device const &, expression_tree const &) const;
+  std::string generate_kernel(std::string const & suffix, expression_tree const & expressions, driver::Device const & device, symbolic::symbols_table const & symbols, bool specialized) const;
   std::string generate_impl(std::string const & suffix, expression_tree const & expressions, driver::Device const & device, symbolic::symbols_table const &) const;
-  void enqueue_block(driver::CommandQueue & queue, int_t M, int_t N, int_t K, const expression_tree::node &A, const expression_tree::node &B, const expression_tree::node &C,
-                     value_scalar const &alpha, value_scalar const &beta, driver::Program const & program, std::string const & suffix, runtime::execution_options_type const & options);
+  std::string specialize_impl(std::string const & suffix, expression_tree const & expressions, driver::Device const & device, symbolic::symbols_table const &) const;
+  void enqueue_block(driver::CommandQueue & queue, int_t M, int_t N, int_t K, expression_tree const & tree, isaac::symbolic::preset::matrix_product::args const & args,
+                     driver::Program const & program, std::string const & suffix, runtime::execution_options_type const & options);
   std::vector<int_t> infos(expression_tree const & expressions,  isaac::symbolic::preset::matrix_product::args &arguments) const;
 public:
   matrix_product(matrix_product::parameters_type const & parameters, char A_trans, char B_trans);
@@ -22,7 +22,9 @@
 #ifndef ISAAC_SYMBOLIC_ENGINE_MACRO_H
 #define ISAAC_SYMBOLIC_ENGINE_MACRO_H
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace isaac
@@ -35,17 +37,34 @@ namespace symbolic
 //Macro
 class macro
 {
+  //Body split around the occurrences of the arguments, parsed once per code
+  struct pattern_type
+  {
+    struct fragment
+    {
+      int arg;
+      std::string text;
+    };
+    std::string name;
+    size_t nargs;
+    std::vector<fragment> fragments;
+  };
+
+  static std::shared_ptr<pattern_type const> compile(std::string const & code);
+
 public:
+  //Characters [first, second) of a string, such as the arguments of a call
+  typedef std::pair<char const *, char const *> range_type;
+
   macro(std::string const & code);
   macro(const char * code);
-  int expand(std::string & str) const;
+  std::string const & name() const;
+  size_t nargs() const;
+  void render(range_type const * args, std::string & out) const;
   bool operator<(macro const & o) const;
 
 private:
-  std::string code_;
-  std::string name_;
-  std::vector<std::string> args_;
-  std::vector<std::string> tokens_;
+  std::shared_ptr<pattern_type const> pattern_;
 };
 
 }
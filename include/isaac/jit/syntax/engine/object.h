@@ -59,6 +59,7 @@ protected:
 //Object
 class object
 {
+  void process(char const * begin, char const * end, std::string & out) const;
 protected:
   void add_base(std::string const & name);
   void add_load(bool contiguous);
@@ -136,6 +137,13 @@ public:
   reduce_2d(unsigned int id, size_t root, op_element op, expression_tree const & tree, symbols_table const & table);
 };
 
+//Matrix product, evaluated to its value in registers by fused epilogues
+class matrix_product : public object, public node
+{
+public:
+  matrix_product(unsigned int id, size_t root, op_element op, expression_tree const & tree, symbols_table const & table);
+};
+
 //Host scalar
 class host_scalar : public leaf
 {
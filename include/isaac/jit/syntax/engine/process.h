@@ -4,6 +4,7 @@
 #include <functional>
 #include <typeinfo>
 #include "isaac/tools/cpp/string.hpp"
+#include "isaac/tools/cpp/hash.hpp"
 #include "isaac/jit/syntax/expression/expression.h"
 #include "isaac/jit/syntax/engine/binder.h"
 #include "isaac/jit/syntax/engine/object.h"
@@ -78,6 +79,26 @@ inline std::vector<T*> extract(expression_tree const & tree, symbols_table const
   return extract<T>(tree, table, tree.root());
 }
 
+//Extract symbolic types of the subtree, without visiting the children of the nodes for which recurse is false
+template<class T>
+inline std::vector<T*> extract(expression_tree const & tree, symbols_table const & table, size_t root, std::function<bool(size_t)> const & recurse)
+{
+  std::vector<T*> result;
+  std::set<std::string> processed;
+  auto extract_impl = [&](size_t index)
+  {
+    symbols_table::const_iterator it = table.find(index);
+    if(it!=table.end())
+    {
+      T* obj = dynamic_cast<T*>(&*it->second);
+      if(obj && processed.insert(obj->process("#name")).second)
+        result.push_back(obj);
+    }
+  };
+  traverse(tree, root, extract_impl, recurse);
+  return result;
+}
+
 // Filter nodes
 std::vector<size_t> find(expression_tree const & tree, size_t root, std::function<bool (expression_tree::node const &)> const & pred);
 std::vector<size_t> find(expression_tree const & tree, std::function<bool (expression_tree::node const &)> const & pred);
@@ -87,10 +108,12 @@ std::vector<size_t> lhs_of(expression_tree const & tree, std::vector<size_t> con
 std::vector<size_t> rhs_of(expression_tree const & tree, std::vector<size_t> const & in);
 
 // Hash
-std::string hash(expression_tree const & tree);
+std::string fingerprint(expression_tree const & tree);
+uint64_t hash(expression_tree const & tree);
 
 //Set arguments
 void set_arguments(expression_tree const & tree, driver::Kernel & kernel, unsigned int & current_arg, fusion_policy_t fusion_policy);
+void set_arguments(expression_tree const & tree, size_t root, std::function<bool(size_t)> const & recurse, driver::Kernel & kernel, unsigned int & current_arg, fusion_policy_t fusion_policy);
 
 //Symbolize
 symbols_table symbolize(fusion_policy_t fusion_policy, isaac::expression_tree const & expression);
@@ -33,6 +33,8 @@ namespace symbolic
 namespace preset
 {
 
+//Whether the expression at rootidx reads the buffer of C through another view than C itself
+bool reads_other_view(expression_tree::data_type const &tree, size_t rootidx, expression_tree::node const & C);
 
 class matrix_product
 {
@@ -40,13 +42,17 @@ class matrix_product
 public:
     struct args
     {
-        args(): A(NULL), B(NULL), C(NULL), type(INVALID_EXPRESSION_TYPE){ }
+        args(): A(NULL), B(NULL), C(NULL), type(INVALID_EXPRESSION_TYPE), fused(false), epilogue(0), product(0){ }
         value_scalar alpha;
         expression_tree::node const * A;
         expression_tree::node const * B;
         value_scalar beta;
         expression_tree::node const * C;
         expression_type type;
+        //C = f(dot(A,B), ...) for an elementwise f, evaluated when C is written back
+        bool fused;
+        size_t epilogue;
+        size_t product;
 
         operator bool() const
         {
@@ -55,6 +61,7 @@ public:
     };
 private:
     static void handle_node( expression_tree::data_type const &tree, size_t rootidx, args & a);
+    static bool handle_epilogue(expression_tree::data_type const &tree, size_t rootidx, tuple const & shape, std::vector<size_t> & products);
 
 public:
     static args check(expression_tree::data_type const &tree, size_t rootidx);
@@ -38,7 +38,7 @@ namespace detail
 }
 
 /** @brief Executes a expression_tree on the given queue for the given models map*/
-void execute(execution_handler const & , profiles::map_type &);
+void execute(execution_handler const & , profiles::map_type const &);
 
 /** @brief Executes a expression_tree on the default models map*/
 void execute(execution_handler const &);
@@ -23,6 +23,8 @@
 #define _ISAAC_SYMBOLIC_HANDLER_H
 
 #include "isaac/jit/syntax/expression/expression.h"
+#include "isaac/driver/program.h"
+#include "isaac/tools/sys/getenv.hpp"
 
 namespace isaac
 {
@@ -32,7 +34,7 @@ namespace runtime
 
 struct execution_options_type
 {
-  execution_options_type(unsigned int _queue_id = 0, std::list<driver::Event>* _events = NULL, std::vector<driver::Event>* _dependencies = NULL) :
+  execution_options_type(unsigned int _queue_id = driver::backend::queues::current(), std::list<driver::Event>* _events = NULL, std::vector<driver::Event>* _dependencies = NULL) :
      events(_events), dependencies(_dependencies), queue_id_(_queue_id)
   {}
 
@@ -77,9 +79,27 @@ struct dispatcher_options_type
 
 struct compilation_options_type
 {
-  compilation_options_type(std::string const & _program_name = "", bool _recompile = false) : program_name(_program_name), recompile(_recompile){}
+  compilation_options_type(std::string const & _program_name = "", bool _recompile = false, bool _async = async_default()) : program_name(_program_name), recompile(_recompile), async(_async), specialize_after(specialize_after_default()){}
   std::string program_name;
   bool recompile;
+  //Compile the predicted template in the background, and run a cheaper one until it is ready
+  bool async;
+  //Flags for the device compiler (relaxed math, unrolling, register cap, ...)
+  driver::CompilerOptions compiler;
+  //Number of calls after which a shape gets kernels with constant sizes and strides (0: never)
+  unsigned int specialize_after;
+
+  static bool async_default()
+  {
+    static const std::string value = tools::getenv("ISAAC_ASYNC_COMPILATION");
+    return !value.empty() && value!="0";
+  }
+
+  static unsigned int specialize_after_default()
+  {
+    static const std::string value = tools::getenv("ISAAC_SPECIALIZE_AFTER");
+    return value.empty()?0:(unsigned int)std::atoi(value.c_str());
+  }
 };
 
 class execution_handler
@@ -22,7 +22,11 @@
 #ifndef ISAAC_MODEL_DATABASE_H
 #define ISAAC_MODEL_DATABASE_H
 
+#include <atomic>
 #include <map>
+#include <set>
+#include <future>
+#include <functional>
 #include <memory>
 
 #include "isaac/driver/command_queue.h"
@@ -46,16 +50,26 @@ public:
     {
       typedef std::shared_ptr<templates::base> template_pointer;
       typedef std::vector< template_pointer > templates_container;
+      typedef std::map<std::string, std::future<driver::Program> > pending_type;
 
     private:
       std::string define_extension(std::string const & extensions, std::string const & ext);
-      driver::Program const & init(runtime::execution_handler const &);
+      std::string fingerprint(runtime::execution_handler const &, char kind, int label) const;
+      driver::Program init(runtime::execution_handler const &);
+      driver::Program init(runtime::execution_handler const &, int & label);
+      std::unique_ptr<driver::Program> background(std::string const & name, runtime::execution_handler const &, std::function<std::string()> const & generate, bool wait);
+      std::unique_ptr<driver::Program> specialized(runtime::execution_handler const &, int label);
+      int cheapest(runtime::execution_handler const &) const;
 
     public:
       value_type(expression_type, numeric_type, predictors::random_forest const &, std::vector< std::shared_ptr<templates::base> > const &, driver::CommandQueue const &);
       value_type(expression_type, numeric_type, templates::base const &, driver::CommandQueue const &);
+      ~value_type();
       void execute(runtime::execution_handler const &);
+      void invalidate();
       templates_container const & templates() const;
+      //Predicted performance of the best template on the given input sizes (see templates::base::input_sizes), 0 without a predictor
+      float predict(std::vector<int_t> const & x) const;
 
     private:
       templates_container templates_;
@@ -63,20 +77,27 @@ public:
       std::map<std::vector<int_t>, int> hardcoded_;
       driver::CommandQueue queue_;
       driver::ProgramCache & cache_;
+      uint64_t id_;
+      pending_type pending_;
+      std::set<std::string> failed_;
+      std::map<uint64_t, unsigned int> hits_;
+      static std::atomic<uint64_t> counter_;
     };
 
     typedef std::map<std::pair<expression_type, numeric_type>, std::shared_ptr<value_type> > map_type;
+    //Profiles are never modified in place: set() publishes a new map, and snapshots taken before stay valid
+    typedef std::shared_ptr<map_type const> snapshot_type;
 private:
     static std::shared_ptr<templates::base> create(std::string const & template_name, std::vector<int> const & x);
-    static void import(std::string const & fname, driver::CommandQueue const & queue);
-    static map_type & init(driver::CommandQueue const & queue);
+    static void import(std::string const & fname, driver::CommandQueue const & queue, map_type & result);
+    static snapshot_type init(driver::CommandQueue const & queue);
 public:
     static void release();
-    static map_type & get(driver::CommandQueue const & queue);
+    static snapshot_type get(driver::CommandQueue const & queue);
     static void set(driver::CommandQueue const & queue, expression_type operation, numeric_type dtype, std::shared_ptr<value_type> const & profile);
 private:
     static const presets_type presets_;
-    static std::map<driver::CommandQueue, map_type> cache_;
+    static std::map<driver::CommandQueue, snapshot_type> cache_;
 };
 
 }
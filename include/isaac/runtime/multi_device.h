@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#ifndef ISAAC_RUNTIME_MULTI_DEVICE_H
+#define ISAAC_RUNTIME_MULTI_DEVICE_H
+
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/common/expression_type.h"
+#include "isaac/defines.h"
+#include "isaac/driver/context.h"
+#include "isaac/runtime/out_of_core.h"
+
+namespace isaac
+{
+namespace runtime
+{
+
+/** @brief Splits operations on host arrays across devices with their own memory
+ *
+ *  Each device computes a block of columns (elements for vectors) of the output. The inputs it
+ *  needs are replicated (A in GEMM) or scattered (everything else) to its memory, and its block
+ *  of the output is gathered back to the host. The blocks are proportional to the weights, which
+ *  default to the throughput the profiles of each device predict for the whole operation.
+ */
+class ISAACAPI multi_device
+{
+public:
+  typedef out_of_core::function_type function_type;
+
+  explicit multi_device(std::vector<driver::Context const *> const & contexts);
+  //y = f(x...), where f must not mix columns (elements for vectors)
+  void elementwise(host_array const & y, std::vector<host_array> const & x, function_type const & f);
+  //C = alpha*op(A)*op(B) + beta*C
+  void gemm(value_scalar const & alpha, host_array const & A, bool transA, host_array const & B, bool transB, value_scalar const & beta, host_array const & C);
+  std::vector<driver::Context const *> const & contexts() const;
+
+  //Relative speed of each device. Predicted for each operation when empty
+  std::vector<double> weights;
+
+private:
+  //Weights of an operation of the given type and input sizes (see templates::base::input_sizes)
+  std::vector<double> predict(expression_type type, numeric_type dtype, std::vector<int_t> const & sizes);
+  //Part i owns [bounds[i], bounds[i+1])
+  std::vector<int_t> split(int_t extent, std::vector<double> const & weights) const;
+  driver::CommandQueue & queue(size_t part);
+  void run(size_t part, expression_tree const & tree);
+  void synchronize();
+
+private:
+DISABLE_MSVC_WARNING_C4251
+  std::vector<driver::Context const *> contexts_;
+RESTORE_MSVC_WARNING_C4251
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#ifndef ISAAC_RUNTIME_OUT_OF_CORE_H
+#define ISAAC_RUNTIME_OUT_OF_CORE_H
+
+#include <functional>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/defines.h"
+#include "isaac/driver/backend.h"
+
+namespace isaac
+{
+namespace runtime
+{
+
+//Column-major array in host memory
+struct ISAACAPI host_array
+{
+  host_array(void* _data, numeric_type _dtype, int_t _shape0, int_t _shape1 = 1, int_t _ld = 0);
+  //Vectors are split by elements, matrices by columns
+  int_t extent() const;
+  //Copies the block [r0, r0 + nrows) x [c0, c0 + ncols) to or from a buffer storing it densely, without blocking
+  void upload(driver::CommandQueue & queue, int_t r0, int_t c0, int_t nrows, int_t ncols, driver::Buffer const & buffer) const;
+  void download(driver::CommandQueue & queue, int_t r0, int_t c0, int_t nrows, int_t ncols, driver::Buffer const & buffer) const;
+  //Same for the units [start, start + size)
+  void upload(driver::CommandQueue & queue, int_t start, int_t size, driver::Buffer const & buffer) const;
+  void download(driver::CommandQueue & queue, int_t start, int_t size, driver::Buffer const & buffer) const;
+  void* data;
+  numeric_type dtype;
+  int_t shape0;
+  int_t shape1;
+  int_t ld;
+};
+
+/** @brief Streams expressions over host arrays through the device, tile by tile
+ *
+ *  Tiles are computed on the default queue of the constructing thread, and uploaded and downloaded
+ *  on two queues the executor holds for its lifetime, with two device slots per operand, so that
+ *  the upload of tile i+1, the computation of tile i and the download of tile i-1 overlap. The
+ *  tiles are sized so that the slots fit in the footprint.
+ */
+class ISAACAPI out_of_core
+{
+public:
+  //Builds the expression of a tile from the tiles of the inputs
+  typedef std::function<expression_tree(std::vector<array_base*> const &)> function_type;
+
+  out_of_core(driver::Context const & context = driver::backend::contexts::get_default());
+  out_of_core(out_of_core const &) = delete;
+  out_of_core & operator=(out_of_core const &) = delete;
+  ~out_of_core();
+  //y = f(x...), where f must not mix columns (elements for vectors)
+  void elementwise(host_array const & y, std::vector<host_array> const & x, function_type const & f);
+  //combine(f(x...) for each tile), where f reduces its tiles to a scalar. The partial results are summed by default
+  value_scalar reduce(std::vector<host_array> const & x, function_type const & f, std::function<expression_tree(array_base const &)> const & combine = NULL);
+  //C = alpha*op(A)*op(B) + beta*C
+  void gemm(value_scalar const & alpha, host_array const & A, bool transA, host_array const & B, bool transB, value_scalar const & beta, host_array const & C);
+
+  //Device memory the slots may use, in bytes (ISAAC_OUT_OF_CORE_FOOTPRINT, or half of the device memory)
+  size_t footprint;
+
+private:
+  driver::CommandQueue & queue(unsigned int stage);
+  void run(expression_tree const & tree);
+  void synchronize();
+
+private:
+  driver::Context context_;
+  //Queues of the upload, compute and download stages
+  unsigned int queues_[3];
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#ifndef ISAAC_RUNTIME_PARTITIONED_H
+#define ISAAC_RUNTIME_PARTITIONED_H
+
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/defines.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/context.h"
+#include "isaac/runtime/out_of_core.h"
+
+namespace isaac
+{
+namespace runtime
+{
+
+/** @brief Splits operations on host arrays across devices sharing the host memory
+ *
+ *  Typically the NUMA sub-devices of a multi-socket CPU. Each device owns a contiguous block of
+ *  columns (elements for vectors), which it accesses in place through zero-copy buffers, so
+ *  that a kernel never spans several sockets. Arrays initialized with first_touch have the
+ *  pages of each block on the node of the device that owns it.
+ */
+class ISAACAPI partitioned
+{
+public:
+  typedef out_of_core::function_type function_type;
+
+  explicit partitioned(std::vector<driver::Device> const & devices);
+  //One part per NUMA node of the device
+  explicit partitioned(driver::Device const & device = driver::backend::contexts::get_default().device());
+  //Zeroes x from the devices owning its blocks, so that fresh pages are placed on their nodes
+  void first_touch(host_array const & x);
+  //y = f(x...), where f must not mix columns (elements for vectors)
+  void elementwise(host_array const & y, std::vector<host_array> const & x, function_type const & f);
+  //C = alpha*op(A)*op(B) + beta*C, each device computing a block of columns of C
+  void gemm(value_scalar const & alpha, host_array const & A, bool transA, host_array const & B, bool transB, value_scalar const & beta, host_array const & C);
+  std::vector<driver::Context const *> const & contexts() const;
+
+private:
+  //Part i owns [bounds[i], bounds[i+1])
+  std::vector<int_t> split(int_t extent) const;
+  driver::CommandQueue & queue(size_t part);
+  void run(size_t part, expression_tree const & tree);
+
+private:
+DISABLE_MSVC_WARNING_C4251
+  std::vector<driver::Context const *> contexts_;
+RESTORE_MSVC_WARNING_C4251
+};
+
+}
+}
+
+#endif
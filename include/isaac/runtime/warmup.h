@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+
+#ifndef ISAAC_RUNTIME_WARMUP_H
+#define ISAAC_RUNTIME_WARMUP_H
+
+#include <string>
+#include <vector>
+
+#include "isaac/defines.h"
+#include "isaac/driver/command_queue.h"
+
+namespace isaac
+{
+namespace runtime
+{
+
+/** @brief Compiles ahead of time the programs needed by a list of signatures and recorded traces
+ *
+ *  Signatures have the form operation[:dtype], where operation is one of
+ *  axpy, scal, copy, dot, asum, gemv_n, gemv_t, ger, gemm_nn, gemm_nt, gemm_tn, gemm_tt
+ *  and dtype is float32 (default) or float64. Traces are recorded by running an
+ *  application with ISAAC_TRACE=<path>. The compiled binaries are packed into a
+ *  relocatable bundle, to be loaded with driver::backend::programs::load or ISAAC_BUNDLE=<path>.
+ */
+ISAACAPI void warmup(driver::CommandQueue & queue, std::vector<std::string> const & signatures, std::vector<std::string> const & traces, std::string const & bundle);
+
+}
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+
+#ifndef ISAAC_TOOLS_CPP_HASH_HPP
+#define ISAAC_TOOLS_CPP_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace isaac
+{
+namespace tools
+{
+
+//64-bit FNV-1a
+static const uint64_t hash_seed = 14695981039346656037ULL;
+static const uint64_t hash_prime = 1099511628211ULL;
+
+inline uint64_t hash_combine(uint64_t seed, uint64_t value)
+{
+  for(unsigned int i = 0 ; i < 8 ; ++i, value >>= 8)
+  {
+    seed ^= (value & 0xff);
+    seed *= hash_prime;
+  }
+  return seed;
+}
+
+inline uint64_t hash(char const * data, size_t size, uint64_t seed = hash_seed)
+{
+  for(size_t i = 0 ; i < size ; ++i)
+  {
+    seed ^= (unsigned char)data[i];
+    seed *= hash_prime;
+  }
+  return seed;
+}
+
+inline uint64_t hash(std::string const & str, uint64_t seed = hash_seed)
+{ return hash(str.data(), str.size(), seed); }
+
+//Appends the bytes of value to a fingerprint, i.e., a string that is hashed into a key and compared on lookup
+inline void append(std::string & fingerprint, uint64_t value)
+{ fingerprint.append((char const *)&value, sizeof(value)); }
+
+}
+}
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+
+#ifndef ISAAC_TOOLS_FLOCK
+#define ISAAC_TOOLS_FLOCK
+
+#include <string>
+#include <fcntl.h>
+#if !defined(_WIN32)
+  #include <unistd.h>
+  #include <sys/file.h>
+#endif
+
+namespace isaac
+{
+
+namespace tools
+{
+
+    //Advisory, process-wide file lock (no-op on Windows)
+    class file_lock
+    {
+    public:
+        file_lock(std::string const & path, bool exclusive) : fd_(-1)
+        {
+        #if !defined(_WIN32)
+            fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0666);
+            if(fd_ >= 0 && ::flock(fd_, exclusive?LOCK_EX:LOCK_SH) != 0)
+            {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        #else
+            (void)path;
+            (void)exclusive;
+        #endif
+        }
+
+        ~file_lock()
+        {
+        #if !defined(_WIN32)
+            if(fd_ >= 0)
+            {
+                ::flock(fd_, LOCK_UN);
+                ::close(fd_);
+            }
+        #endif
+        }
+
+    private:
+        file_lock(file_lock const &);
+        file_lock & operator=(file_lock const &);
+        int fd_;
+    };
+
+}
+
+}
+
+#endif
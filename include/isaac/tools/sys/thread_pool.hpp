@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+
+#ifndef ISAAC_TOOLS_THREAD_POOL
+#define ISAAC_TOOLS_THREAD_POOL
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace isaac
+{
+
+namespace tools
+{
+
+    //Fixed-size pool of worker threads. Pending tasks are drained on destruction
+    class thread_pool
+    {
+    public:
+        explicit thread_pool(size_t size) : stop_(false)
+        {
+            for(size_t i = 0 ; i < size ; ++i)
+                workers_.emplace_back([this]{ run(); });
+        }
+
+        ~thread_pool()
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for(std::thread & worker: workers_)
+                worker.join();
+        }
+
+        template<class F>
+        std::future<typename std::result_of<F()>::type> enqueue(F f)
+        {
+            typedef typename std::result_of<F()>::type result_type;
+            std::shared_ptr< std::packaged_task<result_type()> > task(new std::packaged_task<result_type()>(f));
+            std::future<result_type> result = task->get_future();
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                tasks_.push([task]{ (*task)(); });
+            }
+            cv_.notify_one();
+            return result;
+        }
+
+    private:
+        thread_pool(thread_pool const &);
+        thread_pool & operator=(thread_pool const &);
+
+        void run()
+        {
+            while(true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [this]{ return stop_ || !tasks_.empty(); });
+                    if(stop_ && tasks_.empty())
+                        return;
+                    task = std::move(tasks_.front());
+                    tasks_.pop();
+                }
+                task();
+            }
+        }
+
+        std::vector<std::thread> workers_;
+        std::queue< std::function<void()> > tasks_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stop_;
+    };
+
+}
+
+}
+
+#endif
@@ -51,7 +51,7 @@ extern "C"
         {
             std::list<sc::driver::Event> levents;
             sc::runtime::execution_options_type options(sc::driver::CommandQueue(commandQueues[i],false), &levents, &waitlist);
-            sc::runtime::execute(sc::runtime::execution_handler(operation, options), sc::runtime::profiles::get(options.queue(context)));
+            sc::runtime::execute(sc::runtime::execution_handler(operation, options), *sc::runtime::profiles::get(options.queue(context)));
             if(events)
             {
                 events[i] = levents.front().handle().cl();
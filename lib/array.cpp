@@ -23,9 +23,12 @@
 
 #include <cassert>
 #include <algorithm>
+#include <cstring>
+#include <memory>
 #include <stdexcept>
 
 #include "isaac/array.h"
+#include "isaac/driver/event.h"
 #include "isaac/exception/api.h"
 #include "isaac/runtime/execute.h"
 
@@ -64,6 +67,10 @@ array_base::array_base(tuple const & shape, numeric_type dtype, int_t start, tup
 array_base::array_base(tuple const & shape, numeric_type dtype, driver::Context const & context) : array_base(shape, dtype, 0, {1, shape[0]}, context)
 {}
 
+array_base::array_base(tuple const & shape, numeric_type dtype, void* host, driver::Context const & context) :
+  array_base(shape, dtype, 0, {1, shape[0]}, driver::Buffer(context, prod(shape)*size_of(dtype), host))
+{}
+
 array_base::array_base(runtime::execution_handler const & other) : array_base(other.x().shape(), other.x().dtype(), other.x().context())
 { *this = other; }
 
@@ -332,6 +339,12 @@ array::array(array_base const & other): array_base(other.shape(), other.dtype(),
 array::array(array const &other): array((array_base const &)other)
 { }
 
+array & array::operator=(array const & other)
+{
+  array_base::operator=(other);
+  return *this;
+}
+
 
 //---------------------------------------
 /*--- View ---*/
@@ -346,10 +359,11 @@ view::view(int_t size1, numeric_type dtype, driver::Buffer data, int_t start, in
 namespace detail
 {
 
+//Uploads do not wait for the queue to drain
 template<class T>
 void copy(driver::Context const & context, driver::Buffer const & data, T value)
 {
-  driver::backend::queues::get(context,0).write(data, CL_TRUE, 0, sizeof(T), (void*)&value);
+  driver::backend::queues::get(context, driver::backend::queues::current()).fill(data, 0, sizeof(T), (void*)&value, sizeof(T));
 }
 
 }
@@ -386,7 +400,7 @@ void scalar::inject(values_holder & v) const
     int_t dtsize = size_of(dtype_);
   #define HANDLE_CASE(DTYPE, VAL) \
   case DTYPE:\
-    driver::backend::queues::get(context_, 0).read(data_, CL_TRUE, start_*dtsize, dtsize, (void*)&v.VAL); break;\
+    driver::backend::queues::get(context_, driver::backend::queues::current()).read(data_, CL_TRUE, start_*dtsize, dtsize, (void*)&v.VAL); break;\
 
     switch(dtype_)
     {
@@ -433,13 +447,13 @@ TYPE scalar::cast() const
 
 scalar& scalar::operator=(value_scalar const & s)
 {
-  driver::CommandQueue& queue = driver::backend::queues::get(context_, 0);
+  driver::CommandQueue& queue = driver::backend::queues::get(context_, driver::backend::queues::current());
   int_t dtsize = size_of(dtype_);
 
 #define HANDLE_CASE(TYPE, CLTYPE) case TYPE:\
                             {\
                               CLTYPE v = s;\
-                              queue.write(data_, CL_TRUE, start_*dtsize, dtsize, (void*)&v);\
+                              queue.fill(data_, start_*dtsize, dtsize, (void*)&v, dtsize);\
                               return *this;\
                             }
   switch(dtype_)
@@ -973,43 +987,210 @@ ISAACAPI expression_tree sfor(expression_tree const & start, expression_tree con
 //---------------------------------------
 
 //void*
-void copy(void const * data, array_base& x, driver::CommandQueue & queue, bool blocking)
+namespace detail
+{
+
+//Large transfers to discrete devices go through page-locked memory, chunk by chunk,
+//so that copying a chunk on the host overlaps with the DMA of the previous one
+static bool staged(driver::CommandQueue const & queue, size_t size)
+{ return driver::backend::staging::enabled && size > driver::backend::staging::CHUNK && !queue.device().host_unified_memory(); }
+
+static void staged_write(driver::CommandQueue & queue, driver::Buffer const & buffer, size_t offset, size_t size, char const * data)
+{
+  size_t chunk = driver::backend::staging::CHUNK;
+  char* staging = (char*)driver::backend::staging::get(queue).data();
+  std::unique_ptr<driver::Event> events[2];
+  for(size_t done = 0, i = 0 ; done < size ; done += chunk, i = 1 - i)
+  {
+    size_t n = std::min(chunk, size - done);
+    if(events[i])
+      events[i]->synchronize();
+    std::memcpy(staging + i*chunk, data + done, n);
+    events[i].reset(new driver::Event(queue.backend()));
+    queue.write(buffer, false, offset + done, n, staging + i*chunk, events[i].get());
+    queue.flush();
+  }
+  for(std::unique_ptr<driver::Event> const & event: events)
+    if(event)
+      event->synchronize();
+}
+
+static void staged_read(driver::CommandQueue & queue, driver::Buffer const & buffer, size_t offset, size_t size, char* data)
+{
+  size_t chunk = driver::backend::staging::CHUNK;
+  size_t nchunks = (size + chunk - 1)/chunk;
+  char* staging = (char*)driver::backend::staging::get(queue).data();
+  std::unique_ptr<driver::Event> events[2];
+  auto issue = [&](size_t k)
+  {
+    events[k%2].reset(new driver::Event(queue.backend()));
+    queue.read(buffer, false, offset + k*chunk, std::min(chunk, size - k*chunk), staging + (k%2)*chunk, events[k%2].get());
+    queue.flush();
+  };
+  issue(0);
+  for(size_t k = 0 ; k < nchunks ; ++k)
+  {
+    //The other half of the staging memory was drained at the previous iteration
+    if(k + 1 < nchunks)
+      issue(k + 1);
+    events[k%2]->synchronize();
+    std::memcpy(data + k*chunk, staging + (k%2)*chunk, std::min(chunk, size - k*chunk));
+  }
+}
+
+static void write(driver::CommandQueue & queue, driver::Buffer const & buffer, bool blocking, size_t offset, size_t size, void const * data)
 {
-  unsigned int dtypesize = size_of(x.dtype());
-  if(x.start()==0 && x.shape()[0]*prod(x.stride())==prod(x.shape()))
+  //Zero-copy buffers are written in place, which is free when they already wrap data
+  if(buffer.host())
   {
-    queue.write(x.data(), blocking, 0, prod(x.shape())*dtypesize, data);
+    void* ptr = queue.map(buffer, offset, size);
+    if(ptr != data)
+      std::memcpy(ptr, data, size);
+    queue.unmap(buffer, ptr);
   }
+  else if(staged(queue, size))
+    staged_write(queue, buffer, offset, size, (char const *)data);
   else
+    queue.write(buffer, blocking, offset, size, data);
+}
+
+static void read(driver::CommandQueue & queue, driver::Buffer const & buffer, bool blocking, size_t offset, size_t size, void* data)
+{
+  if(buffer.host())
   {
-    array tmp(x.shape(), x.dtype(), x.context());
-    queue.write(tmp.data(), blocking, 0, prod(tmp.shape())*dtypesize, data);
-    x = tmp;
+    void* ptr = queue.map(buffer, offset, size);
+    if(ptr != data)
+      std::memcpy(data, ptr, size);
+    queue.unmap(buffer, ptr);
   }
+  else if(staged(queue, size))
+    staged_read(queue, buffer, offset, size, (char*)data);
+  else
+    queue.read(buffer, blocking, offset, size, data);
 }
 
-void copy(array_base const & x, void* data, driver::CommandQueue & queue, bool blocking)
+//Strided arrays seen as rows of contiguous bytes, pitch bytes apart
+struct rect_type
+{
+  size_t offset;
+  size_t pitch;
+  size_t width;
+  size_t height;
+};
+
+static bool rect(array_base const & x, rect_type & r)
+{
+  size_t dtsize = size_of(x.dtype());
+  tuple const & shape = x.shape();
+  tuple const & stride = x.stride();
+  r.offset = x.start()*dtsize;
+  //Dense arrays
+  bool dense = true;
+  for(size_t d = 0, ld = 1 ; d < std::min(x.dim(), stride.size()) ; ld *= shape[d++])
+    dense = dense && (shape[d]==1 || stride[d]==(int_t)ld);
+  if(dense)
+  {
+    r.width = r.pitch = prod(shape)*dtsize;
+    r.height = 1;
+    return true;
+  }
+  //Vectors, rows and columns
+  if(x.dim()==1 || max(shape)==prod(shape))
+  {
+    size_t dim = 0;
+    while(dim + 1 < x.dim() && shape[dim]==1)
+      dim++;
+    bool unit = stride[dim]==1;
+    r.width = unit?shape[dim]*dtsize:dtsize;
+    r.height = unit?1:shape[dim];
+    r.pitch = unit?r.width:stride[dim]*dtsize;
+    return true;
+  }
+  //Matrices with contiguous columns
+  if(x.dim()==2 && stride[0]==1 && stride[1]>=shape[0])
+  {
+    r.width = shape[0]*dtsize;
+    r.height = shape[1];
+    r.pitch = stride[1]*dtsize;
+    return true;
+  }
+  return false;
+}
+
+//Other layouts are packed on the host, from the span of memory they cover
+static void pack(array_base const & x, char* span, char* data, bool to_span)
+{
+  size_t dtsize = size_of(x.dtype());
+  tuple const & shape = x.shape();
+  std::vector<int_t> idx(x.dim(), 0);
+  for(int_t i = 0 ; i < prod(shape) ; ++i)
+  {
+    int_t offset = 0;
+    for(size_t d = 0 ; d < x.dim() ; ++d)
+      offset += idx[d]*x.stride()[d];
+    if(to_span)
+      std::memcpy(span + offset*dtsize, data + i*dtsize, dtsize);
+    else
+      std::memcpy(data + i*dtsize, span + offset*dtsize, dtsize);
+    for(size_t d = 0 ; d < x.dim() && ++idx[d]==shape[d] ; ++d)
+      idx[d] = 0;
+  }
+}
+
+static size_t span(array_base const & x)
+{
+  int_t last = 0;
+  for(size_t d = 0 ; d < x.dim() ; ++d)
+    last += (x.shape()[d] - 1)*x.stride()[d];
+  return (last + 1)*size_of(x.dtype());
+}
+
+}
+
+void copy(void const * data, array_base& x, driver::CommandQueue & queue, bool blocking)
 {
-  unsigned int dtypesize = size_of(x.dtype());
-  if(x.start()==0 && prod(x.stride())==prod(x.shape())){
-    queue.read(x.data(), blocking, 0, prod(x.shape())*dtypesize, data);
+  if(min(x.shape())==0)
+    return;
+  detail::rect_type r;
+  if(!detail::rect(x, r))
+  {
+    //The gaps of the span are preserved
+    std::vector<char> span(detail::span(x));
+    detail::read(queue, x.data(), true, x.start()*size_of(x.dtype()), span.size(), span.data());
+    detail::pack(x, span.data(), (char*)data, true);
+    detail::write(queue, x.data(), true, x.start()*size_of(x.dtype()), span.size(), span.data());
   }
+  else if(r.height==1 || r.pitch==r.width)
+    detail::write(queue, x.data(), blocking, r.offset, r.width*r.height, data);
   else
+    queue.write_rect(x.data(), blocking, r.offset, r.pitch, r.width, r.height, data, r.width);
+}
+
+void copy(array_base const & x, void* data, driver::CommandQueue & queue, bool blocking)
+{
+  if(min(x.shape())==0)
+    return;
+  detail::rect_type r;
+  if(!detail::rect(x, r))
   {
-    array tmp(x.shape(), x.dtype(), x.context());
-    tmp = x;
-    queue.read(tmp.data(), blocking, 0, prod(tmp.shape())*dtypesize, data);
+    std::vector<char> span(detail::span(x));
+    detail::read(queue, x.data(), true, x.start()*size_of(x.dtype()), span.size(), span.data());
+    detail::pack(x, span.data(), (char*)data, false);
   }
+  else if(r.height==1 || r.pitch==r.width)
+    detail::read(queue, x.data(), blocking, r.offset, r.width*r.height, data);
+  else
+    queue.read_rect(x.data(), blocking, r.offset, r.pitch, r.width, r.height, data, r.width);
 }
 
 void copy(void const *data, array_base &x, bool blocking)
 {
-  copy(data, x, driver::backend::queues::get(x.context(), 0), blocking);
+  copy(data, x, driver::backend::queues::get(x.context(), driver::backend::queues::current()), blocking);
 }
 
 void copy(array_base const & x, void* data, bool blocking)
 {
-    copy(x, data, driver::backend::queues::get(x.context(), 0), blocking);
+    copy(x, data, driver::backend::queues::get(x.context(), driver::backend::queues::current()), blocking);
 }
 
 //std::vector<>
@@ -1030,13 +1211,13 @@ void copy(array_base const & x, std::vector<T> & cx, driver::CommandQueue & queu
 template<class T>
 void copy(std::vector<T> const & cx, array_base & x, bool blocking)
 {
-    copy(cx, x, driver::backend::queues::get(x.context(), 0), blocking);
+    copy(cx, x, driver::backend::queues::get(x.context(), driver::backend::queues::current()), blocking);
 }
 
 template<class T>
 void copy(array_base const & x, std::vector<T> & cx, bool blocking)
 {
-    copy(x, cx, driver::backend::queues::get(x.context(), 0), blocking);
+    copy(x, cx, driver::backend::queues::get(x.context(), driver::backend::queues::current()), blocking);
 }
 
 #define INSTANTIATE(T) \
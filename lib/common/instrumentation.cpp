@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "isaac/common/instrumentation.h"
+#include "isaac/driver/backend.h"
+#include "isaac/tools/sys/getenv.hpp"
+
+namespace isaac
+{
+
+namespace instrumentation
+{
+
+static std::atomic<uint64_t> counts[NUM_EVENTS];
+static std::atomic<uint64_t> times[NUM_EVENTS];
+static std::atomic<uint64_t> dispatches[NUM_EXPRESSION_TYPES];
+
+static void print_summary()
+{ std::cerr << summary() << std::flush; }
+
+//Registered on the first event, so that it runs before the driver caches are destroyed
+static void enable_summary()
+{
+  static const bool enabled = !tools::getenv("ISAAC_STATS").empty() && std::atexit(&print_summary)==0;
+  (void)enabled;
+}
+
+timer::timer(event_type event) : event_(event), start_(std::chrono::high_resolution_clock::now())
+{}
+
+timer::~timer()
+{
+  record(event_, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_).count());
+}
+
+void record(event_type event, uint64_t nanoseconds)
+{
+  enable_summary();
+  counts[event]++;
+  times[event] += nanoseconds;
+}
+
+void dispatch(expression_type type)
+{
+  enable_summary();
+  dispatches[type]++;
+}
+
+statistics_type statistics()
+{
+  statistics_type result;
+  for(unsigned int i = 0 ; i < NUM_EVENTS ; ++i)
+  {
+    result.events[i].count = counts[i];
+    result.events[i].time = 1e-9*times[i];
+  }
+  for(unsigned int i = 0 ; i < NUM_EXPRESSION_TYPES ; ++i)
+    result.dispatches[i] = dispatches[i];
+  driver::backend::programs::statistics_type programs = driver::backend::programs::statistics();
+  result.programs = programs.size;
+  result.program_bytes = programs.bytes;
+  result.program_hits = programs.hits;
+  result.program_misses = programs.misses;
+  result.program_evictions = programs.evictions;
+  return result;
+}
+
+void reset()
+{
+  for(unsigned int i = 0 ; i < NUM_EVENTS ; ++i)
+  {
+    counts[i] = 0;
+    times[i] = 0;
+  }
+  for(unsigned int i = 0 ; i < NUM_EXPRESSION_TYPES ; ++i)
+    dispatches[i] = 0;
+}
+
+const char * to_string(event_type event)
+{
+  switch(event)
+  {
+    case CODEGEN: return "codegen";
+    case OPENCL_COMPILATION: return "opencl_compilation";
+    case CUDA_COMPILATION: return "cuda_compilation";
+    case BINARY_CACHE_HIT: return "binary_cache_hit";
+    case BINARY_CACHE_MISS: return "binary_cache_miss";
+    case PREDICTION: return "prediction";
+    default: throw std::invalid_argument("ISAAC: unknown instrumentation event");
+  }
+}
+
+std::string summary()
+{
+  static const char * expressions[] = {"invalid", "elementwise_1d", "elementwise_2d", "reduce_1d", "reduce_2d_rows", "reduce_2d_cols",
+                                       "matrix_product_nn", "matrix_product_tn", "matrix_product_nt", "matrix_product_tt"};
+  statistics_type stats = statistics();
+  std::ostringstream oss;
+  oss << "ISAAC statistics" << std::endl;
+  oss << "  events:" << std::endl;
+  for(unsigned int i = 0 ; i < NUM_EVENTS ; ++i)
+    oss << "    " << std::left << std::setw(20) << to_string((event_type)i) << std::right << std::setw(10) << stats.events[i].count
+        << std::setw(12) << std::fixed << std::setprecision(3) << stats.events[i].time*1e3 << "ms" << std::endl;
+  oss << "  dispatches:" << std::endl;
+  for(unsigned int i = 1 ; i < NUM_EXPRESSION_TYPES ; ++i)
+    if(stats.dispatches[i])
+      oss << "    " << std::left << std::setw(20) << expressions[i] << std::right << std::setw(10) << stats.dispatches[i] << std::endl;
+  oss << "  programs: " << stats.programs << " (" << stats.program_bytes << " bytes), "
+      << stats.program_hits << " hits, " << stats.program_misses << " misses, " << stats.program_evictions << " evictions" << std::endl;
+  return oss.str();
+}
+
+}
+
+}
@@ -20,13 +20,20 @@
  */
 
 #include "isaac/driver/backend.h"
+#include "isaac/driver/binary_cache.h"
 #include "isaac/driver/buffer.h"
 #include "isaac/driver/context.h"
 #include "isaac/driver/command_queue.h"
+#include "isaac/driver/event.h"
 #include "isaac/driver/kernel.h"
+#include "isaac/driver/memory_pool.h"
 #include "isaac/driver/program_cache.h"
 
+#include "isaac/tools/sys/getenv.hpp"
+
+#include <algorithm>
 #include <assert.h>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -36,25 +43,122 @@ namespace isaac
 namespace driver
 {
 
+//Each cache below has its own lock, and none of them is held while waiting on a queue
+template<class T, class M = std::mutex>
+static M & mutex()
+{
+  static M result;
+  return result;
+}
+
+//Contexts and queues are created on demand from within their own accessors
+typedef std::recursive_mutex reentrant;
+
 /*-----------------------------------*/
 //----------  Temporaries -----------*/
 /*-----------------------------------*/
 
 void backend::workspaces::release()
 {
+    std::lock_guard<std::mutex> lock(mutex<backend::workspaces>());
+    for(auto & x: cache_)
+        delete x.second.first;
+    cache_.clear();
+}
+
+driver::Buffer & backend::workspaces::get(CommandQueue const & key, size_t size)
+{
+    if(size > max_size)
+        throw std::runtime_error("ISAAC: Temporary workspace exceeds ISAAC_WORKSPACE_LIMIT");
+    std::unique_lock<std::mutex> lock(mutex<backend::workspaces>());
+    auto it = cache_.find(key);
+    if(it==cache_.end())
+        return *cache_.insert(std::make_pair(key, std::make_pair(new Buffer(key.context(), std::max(size, SIZE)), std::max(size, SIZE)))).first->second.first;
+    if(it->second.second < size)
+    {
+        //Kernels in flight on this queue may still use the old workspace
+        lock.unlock();
+        CommandQueue queue = key;
+        queue.synchronize();
+        lock.lock();
+        it = cache_.find(key);
+        if(it->second.second < size)
+        {
+            size = std::min(std::max(size, 2*it->second.second), max_size);
+            *it->second.first = Buffer(key.context(), size);
+            it->second.second = size;
+        }
+    }
+    return *it->second.first;
+}
+
+static size_t max_workspace_default()
+{
+    std::string value = tools::getenv("ISAAC_WORKSPACE_LIMIT");
+    return value.empty()?(size_t)1 << 29:(size_t)std::stoull(value);
+}
+
+const size_t backend::workspaces::SIZE;
+size_t backend::workspaces::max_size = max_workspace_default();
+
+std::map<CommandQueue, std::pair<Buffer *, size_t> > backend::workspaces::cache_;
+
+/*-----------------------------------*/
+//-----------  Staging --------------*/
+/*-----------------------------------*/
+
+void backend::staging::release()
+{
+    std::lock_guard<std::mutex> lock(mutex<backend::staging>());
     for(auto & x: cache_)
         delete x.second;
     cache_.clear();
 }
 
-driver::Buffer & backend::workspaces::get(CommandQueue const & key)
+HostBuffer & backend::staging::get(CommandQueue const & key)
 {
-    if(cache_.find(key)==cache_.end())
-        return *cache_.insert(std::make_pair(key, new Buffer(key.context(), SIZE))).first->second;
-    return *cache_.at(key);
+    std::lock_guard<std::mutex> lock(mutex<backend::staging>());
+    auto it = cache_.find(key);
+    if(it==cache_.end())
+        it = cache_.insert(std::make_pair(key, new HostBuffer(key.context(), 2*CHUNK))).first;
+    return *it->second;
 }
 
-std::map<CommandQueue, Buffer * > backend::workspaces::cache_;
+const size_t backend::staging::CHUNK;
+bool backend::staging::enabled = tools::getenv("ISAAC_STAGING")!="0";
+
+std::map<CommandQueue, HostBuffer * > backend::staging::cache_;
+
+/*-----------------------------------*/
+//------------  Pools ---------------*/
+/*-----------------------------------*/
+
+void backend::pools::release()
+{
+    std::lock_guard<std::mutex> lock(mutex<backend::pools>());
+    for(auto & x: cache_)
+        delete x.second;
+    cache_.clear();
+}
+
+MemoryPool & backend::pools::get(Context const & context)
+{
+    std::lock_guard<std::mutex> lock(mutex<backend::pools>());
+    if(cache_.find(context)==cache_.end())
+        return *cache_.insert(std::make_pair(context, new MemoryPool(context))).first->second;
+    return *cache_.at(context);
+}
+
+void backend::pools::trim()
+{
+    std::lock_guard<std::mutex> lock(mutex<backend::pools>());
+    for(auto & x: cache_)
+        x.second->trim();
+}
+
+bool backend::pools::enabled = tools::getenv("ISAAC_MEMORY_POOL")!="0";
+
+std::map<Context, MemoryPool * > backend::pools::cache_;
 
 /*-----------------------------------*/
 //----------  Programs --------------*/
@@ -62,6 +166,7 @@ std::map<CommandQueue, Buffer * > backend::workspaces::cache_;
 
 void backend::programs::release()
 {
+    std::lock_guard<std::mutex> lock(mutex<backend::programs>());
     for(auto & x: cache_)
         delete x.second;
     cache_.clear();
@@ -69,12 +174,38 @@ void backend::programs::release()
 
 ProgramCache & backend::programs::get(CommandQueue const & queue, expression_type expression, numeric_type dtype)
 {
+    std::lock_guard<std::mutex> lock(mutex<backend::programs>());
     std::tuple<CommandQueue, expression_type, numeric_type> key(queue, expression, dtype);
     if(cache_.find(key)==cache_.end())
-        return *cache_.insert(std::make_pair(key, new ProgramCache())).first->second;
+        return *cache_.insert(std::make_pair(key, new ProgramCache(max_entries, max_bytes))).first->second;
     return *cache_.at(key);
 }
 
+backend::programs::statistics_type backend::programs::statistics()
+{
+    std::lock_guard<std::mutex> lock(mutex<backend::programs>());
+    statistics_type result;
+    for(auto & x: cache_)
+    {
+        ProgramCache::statistics_type current = x.second->statistics();
+        result.size += current.size;
+        result.bytes += current.bytes;
+        result.hits += current.hits;
+        result.misses += current.misses;
+        result.evictions += current.evictions;
+        result.collisions += current.collisions;
+    }
+    return result;
+}
+
+void backend::programs::load(std::string const & bundle)
+{
+    BinaryCache::import(bundle);
+}
+
+size_t backend::programs::max_entries = 64;
+size_t backend::programs::max_bytes = 1 << 25; //32MB of source per cache
+
 std::map<std::tuple<CommandQueue, expression_type, numeric_type>, ProgramCache * >  backend::programs::cache_;
 
 /*-----------------------------------*/
@@ -83,6 +214,7 @@ std::map<std::tuple<CommandQueue, expression_type, numeric_type>, ProgramCache *
 
 void backend::kernels::release()
 {
+    std::lock_guard<std::mutex> lock(mutex<backend::kernels>());
     for(auto & x: cache_)
         delete x.second;
     cache_.clear();
@@ -90,6 +222,7 @@ void backend::kernels::release()
 
 Kernel & backend::kernels::get(Program const & program, std::string const & name)
 {
+    std::lock_guard<std::mutex> lock(mutex<backend::kernels>());
     std::tuple<Program, std::string> key(program, name);
     if(cache_.find(key)==cache_.end())
         return *cache_.insert(std::make_pair(key, new Kernel(program, name.c_str()))).first->second;
@@ -104,6 +237,7 @@ std::map<std::tuple<Program, std::string>, Kernel * > backend::kernels::cache_;
 
 void backend::queues::init(std::list<const Context *> const & contexts)
 {
+    std::lock_guard<reentrant> lock(mutex<backend::queues, reentrant>());
     for(Context const * ctx : contexts)
         if(cache_.find(*ctx)==cache_.end())
         cache_.insert(std::make_pair(*ctx, std::vector<CommandQueue*>{new CommandQueue(*ctx, ctx->device(), default_queue_properties)}));
@@ -111,6 +245,7 @@ void backend::queues::init(std::list<const Context *> const & contexts)
 
 void backend::queues::release()
 {
+    std::lock_guard<reentrant> lock(mutex<backend::queues, reentrant>());
     for(auto & x: cache_)
         for(auto & y: x.second)
             delete y;
@@ -120,27 +255,276 @@ void backend::queues::release()
 
 CommandQueue & backend::queues::get(Context const & context, unsigned int id)
 {
+  std::lock_guard<reentrant> lock(mutex<backend::queues, reentrant>());
   init(std::list<Context const *>(1,&context));
   for(auto & x : cache_)
     if(x.first==context)
+    {
+        while(x.second.size() <= id)
+            x.second.push_back(new CommandQueue(context, context.device(), default_queue_properties));
         return *x.second[id];
+    }
   throw;
 }
 
+size_t backend::queues::size(Context const & context)
+{
+  std::lock_guard<reentrant> lock(mutex<backend::queues, reentrant>());
+  auto it = cache_.find(context);
+  return (it==cache_.end())?0:it->second.size();
+}
+
+//Queue ids held by threads and executors, given back when they are done
+static std::vector<bool> & held_queues()
+{
+  static std::vector<bool> result;
+  return result;
+}
+
+namespace
+{
+
+struct thread_queue
+{
+  thread_queue() : id(0), held(0), assigned(false), holds(false){}
+
+  ~thread_queue()
+  {
+    if(holds)
+      backend::queues::relinquish(held);
+  }
+
+  unsigned int id;
+  unsigned int held;
+  bool assigned;
+  bool holds;
+};
+
+}
+
+static thread_queue & current_queue()
+{
+  static thread_local thread_queue result;
+  if(!result.assigned)
+  {
+    result.assigned = true;
+    if(backend::queues::per_thread)
+    {
+      result.held = result.id = backend::queues::acquire();
+      result.holds = true;
+    }
+  }
+  return result;
+}
+
+unsigned int backend::queues::current()
+{
+  return current_queue().id;
+}
+
+void backend::queues::set_current(unsigned int id)
+{
+  current_queue().id = id;
+}
+
+unsigned int backend::queues::acquire()
+{
+  std::lock_guard<reentrant> lock(mutex<backend::queues, reentrant>());
+  std::vector<bool> & held = held_queues();
+  //Without per-thread queues, queue 0 is the default of every thread
+  if(!per_thread && held.empty())
+    held.push_back(true);
+  unsigned int result = std::find(held.begin(), held.end(), false) - held.begin();
+  if(result==held.size())
+    held.push_back(true);
+  else
+    held[result] = true;
+  return result;
+}
+
+void backend::queues::relinquish(unsigned int id)
+{
+  std::lock_guard<reentrant> lock(mutex<backend::queues, reentrant>());
+  held_queues()[id] = false;
+}
+
+bool backend::queues::per_thread = tools::getenv("ISAAC_THREAD_QUEUES")!="0";
+
 void backend::queues::get(Context const & context, std::vector<CommandQueue*> & queues)
 {
+    std::lock_guard<reentrant> lock(mutex<backend::queues, reentrant>());
     init(std::list<Context const *>(1,&context));
     queues = cache_.at(context);
 }
 
 std::map<Context, std::vector<CommandQueue*> > backend::queues::cache_;
 
+queue_guard::queue_guard(unsigned int id) : previous_(backend::queues::current())
+{
+  backend::queues::set_current(id);
+}
+
+queue_guard::~queue_guard()
+{
+  backend::queues::set_current(previous_);
+}
+
+/*-----------------------------------*/
+//-----------  Accesses -------------*/
+/*-----------------------------------*/
+
+namespace
+{
+
+struct access_type
+{
+  access_type(CommandQueue const & _owner): owner(_owner), shared(false){}
+  //Queue of the commands issued before the buffer was shared, which are not recorded
+  CommandQueue owner;
+  bool shared;
+  //Last write, and reads since then (one per queue)
+  std::vector<std::pair<CommandQueue, Event> > writer;
+  std::vector<std::pair<CommandQueue, Event> > readers;
+};
+
+//Buffers are spread over several locks, so that unrelated commands do not contend
+struct accesses_shard
+{
+  std::mutex mutex;
+  std::map<uintptr_t, access_type> cache;
+};
+
+}
+
+static const size_t NUM_ACCESSES_SHARDS = 16;
+
+//Never freed, since buffers may be destroyed at exit
+static accesses_shard & accesses_shard_of(uintptr_t buffer)
+{
+  static accesses_shard * result = new accesses_shard[NUM_ACCESSES_SHARDS];
+  return result[(buffer >> 8) % NUM_ACCESSES_SHARDS];
+}
+
+void backend::accesses::release()
+{
+    for(size_t i = 0 ; i < NUM_ACCESSES_SHARDS ; ++i)
+    {
+        accesses_shard & shard = accesses_shard_of(i << 8);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cache.clear();
+    }
+}
+
+bool backend::accesses::enabled(Context const & context)
+{
+    return queues::size(context) > 1;
+}
+
+bool backend::accesses::dependencies(CommandQueue const & queue, std::vector<uintptr_t> const & reads, std::vector<uintptr_t> const & writes, std::vector<Event> & events)
+{
+    bool result = false;
+    auto add = [&](uintptr_t buffer, bool write)
+    {
+        accesses_shard & shard = accesses_shard_of(buffer);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.cache.find(buffer);
+        if(it==shard.cache.end())
+        {
+            shard.cache.insert(std::make_pair(buffer, access_type(queue)));
+            return;
+        }
+        access_type & access = it->second;
+        if(!access.shared)
+        {
+            if(access.owner==queue)
+                return;
+            //The commands of the previous owner are summarized by a marker
+            Event marker(access.owner.backend());
+            access.owner.marker(marker);
+            access.writer.assign(1, std::make_pair(access.owner, marker));
+            access.shared = true;
+        }
+        result = true;
+        for(auto const & x: access.writer)
+            if(x.first!=queue)
+                events.push_back(x.second);
+        if(write)
+            for(auto const & x: access.readers)
+                if(x.first!=queue)
+                    events.push_back(x.second);
+    };
+    for(uintptr_t buffer: writes)
+        add(buffer, true);
+    for(uintptr_t buffer: reads)
+        if(std::find(writes.begin(), writes.end(), buffer)==writes.end())
+            add(buffer, false);
+    return result;
+}
+
+void backend::accesses::record(CommandQueue const & queue, std::vector<uintptr_t> const & reads, std::vector<uintptr_t> const & writes, Event const & event)
+{
+    auto add = [&](uintptr_t buffer, bool write)
+    {
+        accesses_shard & shard = accesses_shard_of(buffer);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.cache.find(buffer);
+        if(it==shard.cache.end() || !it->second.shared)
+            return;
+        access_type & access = it->second;
+        if(write)
+        {
+            access.writer.assign(1, std::make_pair(queue, event));
+            access.readers.clear();
+            return;
+        }
+        auto reader = std::find_if(access.readers.begin(), access.readers.end(), [&](std::pair<CommandQueue, Event> const & x){ return x.first==queue; });
+        if(reader==access.readers.end())
+            access.readers.push_back(std::make_pair(queue, event));
+        else
+            reader->second = event;
+    };
+    for(uintptr_t buffer: writes)
+        add(buffer, true);
+    for(uintptr_t buffer: reads)
+        if(std::find(writes.begin(), writes.end(), buffer)==writes.end())
+            add(buffer, false);
+}
+
+void backend::accesses::retire(uintptr_t buffer, std::vector<CommandQueue> & queues, std::vector<std::pair<CommandQueue, Event> > & events)
+{
+    accesses_shard & shard = accesses_shard_of(buffer);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.cache.find(buffer);
+    if(it==shard.cache.end())
+        return;
+    access_type & access = it->second;
+    if(access.shared)
+    {
+        events.insert(events.end(), access.writer.begin(), access.writer.end());
+        events.insert(events.end(), access.readers.begin(), access.readers.end());
+    }
+    else
+        queues.push_back(access.owner);
+    shard.cache.erase(it);
+}
+
+uintptr_t backend::accesses::key(Buffer const & buffer)
+{
+    switch(buffer.context().backend())
+    {
+        case CUDA: return (uintptr_t)buffer.handle().cu();
+        case OPENCL: return (uintptr_t)buffer.handle().cl();
+        default: throw;
+    }
+}
+
 /*-----------------------------------*/
 //------------  Contexts ------------*/
 /*-----------------------------------*/
 
 void backend::contexts::init(std::vector<Platform> const & platforms)
 {
+    std::lock_guard<reentrant> lock(mutex<backend::contexts, reentrant>());
     for(Platform const & platform: platforms)
     {
         std::vector<Device> devices;
@@ -152,6 +536,7 @@ void backend::contexts::init(std::vector<Platform> const & platforms)
 
 void backend::contexts::release()
 {
+    std::lock_guard<reentrant> lock(mutex<backend::contexts, reentrant>());
     for(auto & x: cache_)
         delete x;
     cache_.clear();
@@ -159,6 +544,7 @@ void backend::contexts::release()
 
 Context const & backend::contexts::import(CUcontext context)
 {
+  std::lock_guard<reentrant> lock(mutex<backend::contexts, reentrant>());
   for(driver::Context const * x: cache_)
       if(x->handle().cu()==context)
           return *x;
@@ -168,6 +554,7 @@ Context const & backend::contexts::import(CUcontext context)
 
 Context const & backend::contexts::import(cl_context context)
 {
+  std::lock_guard<reentrant> lock(mutex<backend::contexts, reentrant>());
   for(driver::Context const * x: cache_)
       if(x->handle().cl()==context)
           return *x;
@@ -175,9 +562,20 @@ Context const & backend::contexts::import(cl_context context)
   return *cache_.back();
 }
 
+Context const & backend::contexts::get(Device const & device)
+{
+  std::lock_guard<reentrant> lock(mutex<backend::contexts, reentrant>());
+  backend::init();
+  for(driver::Context const * x: cache_)
+      if(x->device()==device)
+          return *x;
+  cache_.emplace_back(new Context(device));
+  return *cache_.back();
+}
 
 Context const & backend::contexts::get_default()
 {
+  std::lock_guard<reentrant> lock(mutex<backend::contexts, reentrant>());
   backend::init();
   std::list<Context const *>::const_iterator it = cache_.begin();
   std::advance(it, default_device);
@@ -186,6 +584,7 @@ Context const & backend::contexts::get_default()
 
 void backend::contexts::get(std::list<Context const *> & contexts)
 {
+  std::lock_guard<reentrant> lock(mutex<backend::contexts, reentrant>());
   backend::init();
   contexts = cache_;
 }
@@ -234,7 +633,9 @@ void backend::platforms(std::vector<Platform> & platforms)
 
 void backend::synchronize(Context const & context)
 {
-    for(CommandQueue * queue: queues::cache_.at(context))
+    std::vector<CommandQueue*> current;
+    queues::get(context, current);
+    for(CommandQueue * queue: current)
         queue->synchronize();
 }
 
@@ -244,6 +645,9 @@ void backend::release()
     backend::kernels::release();
     backend::programs::release();
     backend::workspaces::release();
+    backend::staging::release();
+    backend::pools::release();
+    backend::accesses::release();
     backend::queues::release();
     backend::contexts::release();
 }
@@ -251,8 +655,12 @@ void backend::release()
 
 void backend::init()
 {
+  std::lock_guard<reentrant> lock(mutex<backend::contexts, reentrant>());
   if(!contexts::cache_.empty())
       return;
+  std::string bundle = tools::getenv("ISAAC_BUNDLE");
+  if(bundle.size())
+    programs::load(bundle);
   std::vector<Platform> platforms;
   backend::platforms(platforms);
   contexts::init(platforms);
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#if defined(_WIN32)
+  #include <io.h>
+  #include <process.h>
+  #include <sys/utime.h>
+#else
+  #include <dirent.h>
+  #include <unistd.h>
+  #include <utime.h>
+#endif
+
+#include "isaac/driver/binary_cache.h"
+#include "isaac/tools/cpp/hash.hpp"
+#include "isaac/tools/cpp/string.hpp"
+#include "isaac/tools/sys/flock.hpp"
+#include "isaac/tools/sys/getenv.hpp"
+
+namespace isaac
+{
+
+namespace driver
+{
+
+static const char magic[8] = {'I', 'S', 'A', 'A', 'C', 'B', 'I', 'N'};
+static const char bundle_magic[8] = {'I', 'S', 'A', 'A', 'C', 'B', 'D', 'L'};
+static const uint32_t format = 1;
+
+static size_t default_max_size()
+{
+    std::string size = tools::getenv("ISAAC_CACHE_SIZE");
+    if(size.size())
+        return std::strtoull(size.c_str(), NULL, 10);
+    return size_t(1) << 30;
+}
+
+static int process_id()
+{
+#if defined(_WIN32)
+    return _getpid();
+#else
+    return getpid();
+#endif
+}
+
+//Unique within the machine: concurrent writers, threads included, never share a temporary
+static std::string temporary(std::string const & path)
+{
+    static std::atomic<uint64_t> counter(0);
+    uint64_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return path + ".tmp" + tools::to_string(process_id()) + "." + tools::to_string(thread) + "." + tools::to_string(counter++);
+}
+
+//Forces the data of a file to the disk, so that a rename after a crash never exposes a partial file
+static bool sync_file(std::string const & path)
+{
+#if defined(_WIN32)
+    int fd = _open(path.c_str(), _O_WRONLY | _O_BINARY);
+    if(fd < 0)
+        return false;
+    bool result = _commit(fd) == 0;
+    _close(fd);
+#else
+    int fd = open(path.c_str(), O_WRONLY);
+    if(fd < 0)
+        return false;
+    bool result = fsync(fd) == 0;
+    close(fd);
+#endif
+    return result;
+}
+
+static size_t file_size(std::string const & path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+BinaryCache::BinaryCache(std::string const & path, std::string const & tag) : path_(path), tag_(tag + "isaac-" ISAAC_VERSION)
+{}
+
+std::string BinaryCache::entry(std::string const & key) const
+{ return path_ + key; }
+
+std::string BinaryCache::lock() const
+{ return path_ + ".lock"; }
+
+bool BinaryCache::read(std::istream & is, std::vector<char> & binary) const
+{
+    //Header
+    char header[sizeof(magic)];
+    uint32_t version = 0, taglen = 0;
+    is.read(header, sizeof(header));
+    is.read((char*)&version, sizeof(version));
+    is.read((char*)&taglen, sizeof(taglen));
+    if(!is || std::memcmp(header, magic, sizeof(magic)) || version != format || taglen != tag_.size())
+        return false;
+    std::string tag(taglen, '\0');
+    is.read(&tag[0], std::streamsize(taglen));
+    uint64_t size = 0, checksum = 0;
+    is.read((char*)&size, sizeof(size));
+    is.read((char*)&checksum, sizeof(checksum));
+    if(!is || tag != tag_)
+        return false;
+    //Payload
+    binary.resize(size);
+    is.read(binary.data(), std::streamsize(size));
+    return is && is.peek() == std::istream::traits_type::eof() && tools::hash(binary.data(), binary.size()) == checksum;
+}
+
+void BinaryCache::write(std::ostream & os, std::vector<char> const & binary) const
+{
+    uint32_t taglen = (uint32_t)tag_.size();
+    uint64_t size = binary.size();
+    uint64_t checksum = tools::hash(binary.data(), binary.size());
+    os.write(magic, sizeof(magic));
+    os.write((char*)&format, sizeof(format));
+    os.write((char*)&taglen, sizeof(taglen));
+    os.write(tag_.data(), std::streamsize(taglen));
+    os.write((char*)&size, sizeof(size));
+    os.write((char*)&checksum, sizeof(checksum));
+    os.write(binary.data(), std::streamsize(size));
+}
+
+void BinaryCache::capture(std::string const & key, std::vector<char> const & binary) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(!capture_)
+        return;
+    std::ostringstream oss;
+    write(oss, binary);
+    captured_[key] = oss.str();
+}
+
+bool BinaryCache::load(std::string const & key, std::vector<char> & binary) const
+{
+    //Pre-compiled bundle
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, std::string>::const_iterator it = bundle_.find(key);
+        if(it != bundle_.end())
+        {
+            std::istringstream iss(it->second);
+            if(read(iss, binary))
+            {
+                if(capture_)
+                    captured_[key] = it->second;
+                return true;
+            }
+        }
+    }
+    if(path_.empty())
+        return false;
+    std::string fname = entry(key);
+    tools::file_lock guard(lock(), false);
+    std::ifstream file(fname.c_str(), std::ios::binary);
+    if(!file || !read(file, binary))
+        return false;
+    //Recently used entries are evicted last
+    utime(fname.c_str(), NULL);
+    capture(key, binary);
+    return true;
+}
+
+void BinaryCache::store(std::string const & key, std::vector<char> const & binary) const
+{
+    capture(key, binary);
+    if(path_.empty())
+        return;
+    std::string fname = entry(key);
+    std::string tmp = temporary(fname);
+    {
+        std::ofstream file(tmp.c_str(), std::ios::binary | std::ios::trunc);
+        write(file, binary);
+        file.close();
+        if(!file || !sync_file(tmp))
+        {
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+    tools::file_lock guard(lock(), true);
+    size_t replaced = file_size(fname);
+#if defined(_WIN32)
+    std::remove(fname.c_str());
+#endif
+    if(std::rename(tmp.c_str(), fname.c_str()) != 0)
+    {
+        std::remove(tmp.c_str());
+        return;
+    }
+    //The directory is only scanned when this process first writes to it, or when its count passes the budget
+    size_t added = file_size(fname);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, size_t>::iterator it = usage_.find(path_);
+        if(it != usage_.end())
+        {
+            size_t usage = it->second + added;
+            usage -= std::min(replaced, usage);
+            if(usage <= max_size)
+            {
+                it->second = usage;
+                return;
+            }
+        }
+    }
+    size_t total = evict(fname);
+    std::lock_guard<std::mutex> lock(mutex_);
+    usage_[path_] = total;
+}
+
+bool BinaryCache::enabled() const
+{
+    if(!path_.empty())
+        return true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capture_;
+}
+
+void BinaryCache::trim() const
+{
+    if(path_.empty())
+        return;
+    tools::file_lock guard(lock(), true);
+    size_t total = evict();
+    std::lock_guard<std::mutex> lock(mutex_);
+    usage_[path_] = total;
+}
+
+//Returns the size of the directory after eviction
+size_t BinaryCache::evict(std::string const & keep) const
+{
+    struct file_info
+    {
+        std::string name;
+        time_t time;
+        size_t size;
+    };
+    std::vector<file_info> files;
+    size_t total = 0;
+    time_t now = std::time(NULL);
+    auto add = [&](std::string const & name, time_t time, size_t size)
+    {
+        //Leftovers of crashed writers
+        if(name.find(".tmp")!=std::string::npos)
+        {
+            if(now - time > 3600)
+                std::remove(name.c_str());
+            return;
+        }
+        file_info info = {name, time, size};
+        files.push_back(info);
+        total += info.size;
+    };
+#if defined(_WIN32)
+    struct _finddata_t ent;
+    intptr_t dir = _findfirst((path_ + "*").c_str(), &ent);
+    if(dir == -1)
+        return 0;
+    do{
+        if(ent.name[0]!='.' && !(ent.attrib & _A_SUBDIR))
+            add(path_ + ent.name, ent.time_write, (size_t)ent.size);
+    }while(_findnext(dir, &ent) == 0);
+    _findclose(dir);
+#else
+    DIR * dir = opendir(path_.c_str());
+    if(!dir)
+        return 0;
+    while(struct dirent * ent = readdir(dir))
+    {
+        std::string name = path_ + ent->d_name;
+        struct stat st;
+        if(ent->d_name[0]=='.' || stat(name.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+            continue;
+        add(name, st.st_mtime, (size_t)st.st_size);
+    }
+    closedir(dir);
+#endif
+    if(total <= max_size)
+        return total;
+    //Evicting below the budget leaves room for the next entries before another scan
+    size_t target = max_size - max_size/4;
+    std::sort(files.begin(), files.end(), [](file_info const & x, file_info const & y){ return x.time < y.time; });
+    for(file_info const & info: files)
+    {
+        if(total <= target)
+            break;
+        if(info.name != keep && std::remove(info.name.c_str())==0)
+            total -= info.size;
+    }
+    return total;
+}
+
+void BinaryCache::import(std::string const & path)
+{
+    std::ifstream file(path.c_str(), std::ios::binary);
+    char header[sizeof(bundle_magic)];
+    uint32_t version = 0, count = 0;
+    file.read(header, sizeof(header));
+    file.read((char*)&version, sizeof(version));
+    file.read((char*)&count, sizeof(count));
+    if(!file || std::memcmp(header, bundle_magic, sizeof(bundle_magic)) || version != format)
+        throw std::runtime_error("ISAAC: invalid program bundle " + path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(uint32_t i = 0 ; i < count ; ++i)
+    {
+        uint32_t keylen = 0;
+        uint64_t size = 0;
+        file.read((char*)&keylen, sizeof(keylen));
+        std::string key(keylen, '\0');
+        file.read(&key[0], std::streamsize(keylen));
+        file.read((char*)&size, sizeof(size));
+        std::string entry(size, '\0');
+        file.read(&entry[0], std::streamsize(size));
+        if(!file)
+            throw std::runtime_error("ISAAC: truncated program bundle " + path);
+        bundle_[key] = entry;
+    }
+}
+
+void BinaryCache::start_capture()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    captured_.clear();
+    capture_ = true;
+}
+
+void BinaryCache::stop_capture()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    captured_.clear();
+    capture_ = false;
+}
+
+void BinaryCache::save_capture(std::string const & path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string tmp = temporary(path);
+    {
+        std::ofstream file(tmp.c_str(), std::ios::binary | std::ios::trunc);
+        uint32_t count = (uint32_t)captured_.size();
+        file.write(bundle_magic, sizeof(bundle_magic));
+        file.write((char*)&format, sizeof(format));
+        file.write((char*)&count, sizeof(count));
+        for(auto const & x: captured_)
+        {
+            uint32_t keylen = (uint32_t)x.first.size();
+            uint64_t size = x.second.size();
+            file.write((char*)&keylen, sizeof(keylen));
+            file.write(x.first.data(), std::streamsize(keylen));
+            file.write((char*)&size, sizeof(size));
+            file.write(x.second.data(), std::streamsize(size));
+        }
+        file.close();
+        if(!file || !sync_file(tmp))
+        {
+            std::remove(tmp.c_str());
+            throw std::runtime_error("ISAAC: could not write program bundle " + path);
+        }
+    }
+#if defined(_WIN32)
+    std::remove(path.c_str());
+#endif
+    std::rename(tmp.c_str(), path.c_str());
+}
+
+size_t BinaryCache::max_size = default_max_size();
+
+std::mutex BinaryCache::mutex_;
+std::map<std::string, std::string> BinaryCache::bundle_;
+std::map<std::string, std::string> BinaryCache::captured_;
+bool BinaryCache::capture_ = false;
+std::map<std::string, size_t> BinaryCache::usage_;
+
+}
+
+}
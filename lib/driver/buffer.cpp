@@ -20,8 +20,12 @@
  */
 
 #include <iostream>
+#include <vector>
 #include "isaac/driver/buffer.h"
 #include "isaac/driver/backend.h"
+#include "isaac/driver/command_queue.h"
+#include "isaac/driver/event.h"
+#include "isaac/driver/memory_pool.h"
 #include "helpers/ocl/infos.hpp"
 
 namespace isaac
@@ -30,18 +34,33 @@ namespace isaac
 namespace driver
 {
 
-Buffer::Buffer(CUdeviceptr h, bool take_ownership) : backend_(CUDA), context_(backend::contexts::import(Buffer::context(h))), h_(backend_, take_ownership)
+//Forgets the commands touching the buffer once its last copy is gone
+static std::shared_ptr<void> retirement(uintptr_t key)
+{
+  return std::shared_ptr<void>((void*)NULL, [key](void*){
+    std::vector<CommandQueue> queues;
+    std::vector<std::pair<CommandQueue, Event> > events;
+    backend::accesses::retire(key, queues, events);
+  });
+}
+
+Buffer::Buffer(CUdeviceptr h, bool take_ownership) : backend_(CUDA), context_(backend::contexts::import(Buffer::context(h))), h_(backend_, take_ownership), host_(NULL)
 {
   h_.cu() = h;
 }
 
-Buffer::Buffer(cl_mem buffer, bool take_ownership) : backend_(OPENCL), context_(backend::contexts::import(ocl::info<CL_MEM_CONTEXT>(buffer))), h_(backend_, take_ownership)
+Buffer::Buffer(cl_mem buffer, bool take_ownership) : backend_(OPENCL), context_(backend::contexts::import(ocl::info<CL_MEM_CONTEXT>(buffer))), h_(backend_, take_ownership), host_(NULL)
 {
   h_.cl() = buffer;
 }
 
-Buffer::Buffer(Context const & context, size_t size) : backend_(context.backend_), context_(context), h_(backend_, true)
+Buffer::Buffer(Context const & context, size_t size) : backend_(context.backend_), context_(context), h_(backend_, true), host_(NULL)
 {
+  if(backend::pools::enabled)
+  {
+    h_ = backend::pools::get(context).allocate(size, backend::queues::get(context, backend::queues::current()), block_);
+    return;
+  }
   switch(backend_)
   {
     case CUDA:
@@ -55,6 +74,33 @@ Buffer::Buffer(Context const & context, size_t size) : backend_(context.backend_
     default:
       throw;
   }
+  block_ = retirement(backend::accesses::key(*this));
+}
+
+Buffer::Buffer(Context const & context, size_t size, void* host) : backend_(context.backend_), context_(context), h_(backend_, backend_==OPENCL), host_(host)
+{
+  switch(backend_)
+  {
+    case CUDA:
+      //The device pointer aliases the host memory, which stays registered as long as a copy of the buffer lives
+      check(dispatch::cuMemHostRegister_v2(host, size, CU_MEMHOSTREGISTER_PORTABLE | CU_MEMHOSTREGISTER_DEVICEMAP));
+      block_ = std::shared_ptr<void>(host, [](void* p){ dispatch::cuMemHostUnregister(p); });
+      check(dispatch::cuMemHostGetDevicePointer_v2(&h_.cu(), host, 0));
+      {
+        //Commands are forgotten before the memory is unregistered
+        std::shared_ptr<void> registration = block_, retired = retirement(backend::accesses::key(*this));
+        block_ = std::shared_ptr<void>(host, [registration, retired](void*) mutable { retired.reset(); registration.reset(); });
+      }
+      break;
+    case OPENCL:
+      cl_int err;
+      h_.cl() = dispatch::clCreateBuffer(context.h_.cl(), CL_MEM_READ_WRITE | CL_MEM_USE_HOST_PTR, size, host, &err);
+      check(err);
+      block_ = retirement(backend::accesses::key(*this));
+      break;
+    default:
+      throw;
+  }
 }
 
 Context const & Buffer::context() const
@@ -66,6 +112,49 @@ Buffer::handle_type & Buffer::handle()
 Buffer::handle_type const & Buffer::handle() const
 { return h_; }
 
+void* Buffer::host() const
+{ return host_; }
+
+HostBuffer::HostBuffer(Context const & context, size_t size) : size_(size)
+{
+  switch(context.backend())
+  {
+    case CUDA:
+    {
+      void* data;
+      check(dispatch::cuMemHostAlloc(&data, size, CU_MEMHOSTALLOC_PORTABLE));
+      data_ = std::shared_ptr<void>(data, [](void* p){ dispatch::cuMemFreeHost(p); });
+      break;
+    }
+    case OPENCL:
+    {
+      //Drivers pin the memory of host-allocated buffers, which stays mapped for the lifetime of the buffer
+      cl_int err;
+      cl_mem mem = dispatch::clCreateBuffer(context.handle().cl(), CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, size, NULL, &err);
+      check(err);
+      CommandQueue queue = backend::queues::get(context, 0);
+      void* data = dispatch::clEnqueueMapBuffer(queue.handle().cl(), mem, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, size, 0, NULL, NULL, &err);
+      if(err != CL_SUCCESS)
+        dispatch::clReleaseMemObject(mem);
+      check(err);
+      data_ = std::shared_ptr<void>(data, [queue, mem](void* p){
+        dispatch::clEnqueueUnmapMemObject(queue.handle().cl(), mem, p, 0, NULL, NULL);
+        dispatch::clFinish(queue.handle().cl());
+        dispatch::clReleaseMemObject(mem);
+      });
+      break;
+    }
+    default:
+      throw;
+  }
+}
+
+void* HostBuffer::data() const
+{ return data_.get(); }
+
+size_t HostBuffer::size() const
+{ return size_; }
+
 }
 
 }
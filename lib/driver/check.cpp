@@ -137,6 +137,7 @@ void check(cl_int err)
         case CL_IMAGE_FORMAT_NOT_SUPPORTED:     throw image_format_not_supported();
         case CL_BUILD_PROGRAM_FAILURE:          throw build_program_failure();
         case CL_MAP_FAILURE:                    throw map_failure();
+        case CL_DEVICE_PARTITION_FAILED:        throw device_partition_failed();
 
         case CL_INVALID_VALUE:                  throw invalid_value();
         case CL_INVALID_DEVICE_TYPE:            throw invalid_device_type();
@@ -19,7 +19,9 @@
  * MA 02110-1301  USA
  */
 
+#include <cstring>
 #include <iostream>
+#include <memory>
 
 #include "isaac/driver/backend.h"
 #include "isaac/driver/command_queue.h"
@@ -30,6 +32,7 @@
 #include "isaac/driver/kernel.h"
 #include "isaac/driver/ndrange.h"
 #include "isaac/driver/buffer.h"
+#include "isaac/exception/driver.h"
 
 #include "helpers/ocl/infos.hpp"
 
@@ -92,29 +95,108 @@ void CommandQueue::synchronize()
   }
 }
 
-void CommandQueue::enqueue(Kernel const & kernel, NDRange global, driver::NDRange local, std::vector<Event> const *, Event* event)
+void CommandQueue::flush()
+{
+  switch(backend_)
+  {
+    case CUDA: break;
+    case OPENCL: check(dispatch::clFlush(h_.cl())); break;
+    default: throw;
+  }
+}
+
+void CommandQueue::marker(Event & event)
+{
+  switch(backend_)
+  {
+    case CUDA: check(dispatch::cuEventRecord(event.h_.cu().second, h_.cu())); break;
+    case OPENCL: check(dispatch::clEnqueueMarkerWithWaitList(h_.cl(), 0, NULL, &event.h_.cl())); break;
+    default: throw;
+  }
+}
+
+void CommandQueue::enqueue(Kernel const & kernel, NDRange global, driver::NDRange local, std::vector<Event> const * dependencies, Event* event)
 {
   switch(backend_)
   {
     case CUDA:
+    {
+      if(dependencies)
+        for(Event const & dependency: *dependencies)
+          check(dispatch::cuStreamWaitEvent(h_.cu(), dependency.h_.cu().second, 0));
+
+      //Addresses are rebuilt from the slots so that kernels stay copyable
+      void* stack[Kernel::cu_inline_size/Kernel::cu_param_size];
+      std::vector<void*> heap;
+      void** params = stack;
+      if(kernel.cu_nparams_ > sizeof(stack)/sizeof(stack[0]))
+      {
+        heap.resize(kernel.cu_nparams_);
+        params = heap.data();
+      }
+      char const * data = kernel.cu_data();
+      for(std::size_t i = 0 ; i < kernel.cu_nparams_ ; ++i)
+        params[i] = (void*)(data + i*Kernel::cu_param_size);
+
       if(event)
         check(dispatch::cuEventRecord(event->h_.cu().first, h_.cu()));
 
       check(dispatch::cuLaunchKernel(kernel.h_.cu(), global[0]/local[0], global[1]/local[1], global[2]/local[2],
-                    local[0], local[1], local[2], 0, h_.cu(),(void**)&kernel.cu_params_[0], NULL));
+                    local[0], local[1], local[2], 0, h_.cu(), params, NULL));
 
       if(event)
         check(dispatch::cuEventRecord(event->h_.cu().second, h_.cu()));
       break;
+    }
     case OPENCL:
-      check(dispatch::clEnqueueNDRangeKernel(h_.cl(), kernel.h_.cl(), global.dimension(), NULL, (const size_t *)global, (const size_t *) local, 0, NULL, event?&event->h_.cl():NULL));
+    {
+      std::vector<cl_event> wait;
+      if(dependencies)
+        wait = events(*dependencies);
+      check(dispatch::clEnqueueNDRangeKernel(h_.cl(), kernel.h_.cl(), global.dimension(), NULL, (const size_t *)global, (const size_t *) local, wait.size(), wait.empty()?NULL:wait.data(), event?&event->h_.cl():NULL));
       break;
+    }
     default: throw;
   }
 }
 
-void CommandQueue::write(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t size, void const* ptr)
+std::vector<cl_event> CommandQueue::events(std::vector<Event> const & events)
+{
+  std::vector<cl_event> result;
+  result.reserve(events.size());
+  for(Event const & event: events)
+    if(event.h_.cl())
+      result.push_back(event.h_.cl());
+  return result;
+}
+
+bool CommandQueue::track(Buffer const & buffer, bool write, std::vector<Event> & dependencies)
 {
+  //Transfers crossing queues wait for the conflicting commands touching the buffer
+  if(!backend::accesses::enabled(context_))
+    return false;
+  std::vector<uintptr_t> key(1, backend::accesses::key(buffer)), none;
+  if(!backend::accesses::dependencies(*this, write?none:key, write?key:none, dependencies))
+    return false;
+  if(backend_==CUDA)
+    for(Event const & dependency: dependencies)
+      check(dispatch::cuStreamWaitEvent(h_.cu(), dependency.h_.cu().second, 0));
+  return true;
+}
+
+void CommandQueue::record(Buffer const & buffer, bool write, Event const & event)
+{
+  std::vector<uintptr_t> key(1, backend::accesses::key(buffer)), none;
+  backend::accesses::record(*this, write?none:key, write?key:none, event);
+}
+
+void CommandQueue::write(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t size, void const* ptr, Event* event)
+{
+  std::vector<Event> dependencies;
+  bool tracked = track(buffer, true, dependencies);
+  std::unique_ptr<Event> marker((tracked && !blocking && !event)?new Event(backend_):NULL);
+  if(marker)
+    event = marker.get();
   switch(backend_)
   {
     case CUDA:
@@ -122,16 +204,28 @@ void CommandQueue::write(Buffer const & buffer, bool blocking, std::size_t offse
         check(dispatch::cuMemcpyHtoD(buffer.h_.cu() + offset, ptr, size));
       else
         check(dispatch::cuMemcpyHtoDAsync(buffer.h_.cu() + offset, ptr, size, h_.cu()));
+      if(event)
+        check(dispatch::cuEventRecord(event->h_.cu().second, h_.cu()));
       break;
     case OPENCL:
-      check(dispatch::clEnqueueWriteBuffer(h_.cl(), buffer.h_.cl(), blocking?CL_TRUE:CL_FALSE, offset, size, ptr, 0, NULL, NULL));
+    {
+      std::vector<cl_event> wait = events(dependencies);
+      check(dispatch::clEnqueueWriteBuffer(h_.cl(), buffer.h_.cl(), blocking?CL_TRUE:CL_FALSE, offset, size, ptr, wait.size(), wait.empty()?NULL:wait.data(), event?&event->h_.cl():NULL));
       break;
+    }
     default: throw;
   }
+  if(tracked && event)
+    record(buffer, true, *event);
 }
 
-void CommandQueue::read(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t size, void* ptr)
+void CommandQueue::read(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t size, void* ptr, Event* event)
 {
+  std::vector<Event> dependencies;
+  bool tracked = track(buffer, false, dependencies);
+  std::unique_ptr<Event> marker((tracked && !blocking && !event)?new Event(backend_):NULL);
+  if(marker)
+    event = marker.get();
   switch(backend_)
   {
     case CUDA:
@@ -139,9 +233,184 @@ void CommandQueue::read(Buffer const & buffer, bool blocking, std::size_t offset
         check(dispatch::cuMemcpyDtoH(ptr, buffer.h_.cu() + offset, size));
       else
         check(dispatch::cuMemcpyDtoHAsync(ptr, buffer.h_.cu() + offset, size, h_.cu()));
+      if(event)
+        check(dispatch::cuEventRecord(event->h_.cu().second, h_.cu()));
+      break;
+    case OPENCL:
+    {
+      std::vector<cl_event> wait = events(dependencies);
+      check(dispatch::clEnqueueReadBuffer(h_.cl(), buffer.h_.cl(), blocking?CL_TRUE:CL_FALSE, offset, size, ptr, wait.size(), wait.empty()?NULL:wait.data(), event?&event->h_.cl():NULL));
+      break;
+    }
+    default: throw;
+  }
+  if(tracked && event)
+    record(buffer, false, *event);
+}
+
+void CommandQueue::fill(Buffer const & buffer, std::size_t offset, std::size_t size, void const* pattern, std::size_t pattern_size, Event* event)
+{
+  if(backend_==OPENCL && !device_.fill_support())
+  {
+    std::vector<char> data(size);
+    for(std::size_t i = 0 ; i < size ; i += pattern_size)
+      std::memcpy(&data[i], pattern, pattern_size);
+    write(buffer, true, offset, size, data.data(), event);
+    return;
+  }
+  std::vector<Event> dependencies;
+  bool tracked = track(buffer, true, dependencies);
+  std::unique_ptr<Event> marker((tracked && !event)?new Event(backend_):NULL);
+  if(marker)
+    event = marker.get();
+  switch(backend_)
+  {
+    case CUDA:
+    {
+      CUdeviceptr ptr = buffer.h_.cu() + offset;
+      //Asynchronous copies from pageable memory are staged before returning
+      if(size==pattern_size)
+        check(dispatch::cuMemcpyHtoDAsync(ptr, pattern, size, h_.cu()));
+      else if(pattern_size==1)
+        check(dispatch::cuMemsetD8Async(ptr, *(unsigned char const *)pattern, size, h_.cu()));
+      else if(pattern_size==2)
+        check(dispatch::cuMemsetD16Async(ptr, *(unsigned short const *)pattern, size/2, h_.cu()));
+      else if(pattern_size==4)
+        check(dispatch::cuMemsetD32Async(ptr, *(unsigned int const *)pattern, size/4, h_.cu()));
+      else
+        throw exception::cuda::invalid_value();
+      if(event)
+        check(dispatch::cuEventRecord(event->h_.cu().second, h_.cu()));
+      break;
+    }
+    case OPENCL:
+    {
+      std::vector<cl_event> wait = events(dependencies);
+      check(dispatch::clEnqueueFillBuffer(h_.cl(), buffer.h_.cl(), pattern, pattern_size, offset, size, wait.size(), wait.empty()?NULL:wait.data(), event?&event->h_.cl():NULL));
+      break;
+    }
+    default: throw;
+  }
+  if(tracked && event)
+    record(buffer, true, *event);
+}
+
+void CommandQueue::write_rect(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t pitch, std::size_t width, std::size_t height, void const* ptr, std::size_t host_pitch, Event* event)
+{
+  std::vector<Event> dependencies;
+  bool tracked = track(buffer, true, dependencies);
+  std::unique_ptr<Event> marker((tracked && !blocking && !event)?new Event(backend_):NULL);
+  if(marker)
+    event = marker.get();
+  switch(backend_)
+  {
+    case CUDA:
+    {
+      CUDA_MEMCPY2D copy = {};
+      copy.srcMemoryType = CU_MEMORYTYPE_HOST;
+      copy.srcHost = ptr;
+      copy.srcPitch = host_pitch;
+      copy.dstMemoryType = CU_MEMORYTYPE_DEVICE;
+      copy.dstDevice = buffer.h_.cu() + offset;
+      copy.dstPitch = pitch;
+      copy.WidthInBytes = width;
+      copy.Height = height;
+      if(blocking)
+        check(dispatch::cuMemcpy2D(&copy));
+      else
+        check(dispatch::cuMemcpy2DAsync(&copy, h_.cu()));
+      if(event)
+        check(dispatch::cuEventRecord(event->h_.cu().second, h_.cu()));
+      break;
+    }
+    case OPENCL:
+    {
+      std::vector<cl_event> wait = events(dependencies);
+      size_t buffer_origin[] = {offset, 0, 0};
+      size_t host_origin[] = {0, 0, 0};
+      size_t region[] = {width, height, 1};
+      check(dispatch::clEnqueueWriteBufferRect(h_.cl(), buffer.h_.cl(), blocking?CL_TRUE:CL_FALSE, buffer_origin, host_origin, region, pitch, 0, host_pitch, 0, ptr,
+                                               wait.size(), wait.empty()?NULL:wait.data(), event?&event->h_.cl():NULL));
+      break;
+    }
+    default: throw;
+  }
+  if(tracked && event)
+    record(buffer, true, *event);
+}
+
+void CommandQueue::read_rect(Buffer const & buffer, bool blocking, std::size_t offset, std::size_t pitch, std::size_t width, std::size_t height, void* ptr, std::size_t host_pitch, Event* event)
+{
+  std::vector<Event> dependencies;
+  bool tracked = track(buffer, false, dependencies);
+  std::unique_ptr<Event> marker((tracked && !blocking && !event)?new Event(backend_):NULL);
+  if(marker)
+    event = marker.get();
+  switch(backend_)
+  {
+    case CUDA:
+    {
+      CUDA_MEMCPY2D copy = {};
+      copy.srcMemoryType = CU_MEMORYTYPE_DEVICE;
+      copy.srcDevice = buffer.h_.cu() + offset;
+      copy.srcPitch = pitch;
+      copy.dstMemoryType = CU_MEMORYTYPE_HOST;
+      copy.dstHost = ptr;
+      copy.dstPitch = host_pitch;
+      copy.WidthInBytes = width;
+      copy.Height = height;
+      if(blocking)
+        check(dispatch::cuMemcpy2D(&copy));
+      else
+        check(dispatch::cuMemcpy2DAsync(&copy, h_.cu()));
+      if(event)
+        check(dispatch::cuEventRecord(event->h_.cu().second, h_.cu()));
+      break;
+    }
+    case OPENCL:
+    {
+      std::vector<cl_event> wait = events(dependencies);
+      size_t buffer_origin[] = {offset, 0, 0};
+      size_t host_origin[] = {0, 0, 0};
+      size_t region[] = {width, height, 1};
+      check(dispatch::clEnqueueReadBufferRect(h_.cl(), buffer.h_.cl(), blocking?CL_TRUE:CL_FALSE, buffer_origin, host_origin, region, pitch, 0, host_pitch, 0, ptr,
+                                              wait.size(), wait.empty()?NULL:wait.data(), event?&event->h_.cl():NULL));
+      break;
+    }
+    default: throw;
+  }
+  if(tracked && event)
+    record(buffer, false, *event);
+}
+
+void* CommandQueue::map(Buffer const & buffer, std::size_t offset, std::size_t size)
+{
+  switch(backend_)
+  {
+    case CUDA:
+      if(!buffer.host_)
+        throw exception::cuda::invalid_value();
+      synchronize();
+      return (char*)buffer.host_ + offset;
+    case OPENCL:
+    {
+      cl_int err;
+      void* result = dispatch::clEnqueueMapBuffer(h_.cl(), buffer.h_.cl(), CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, offset, size, 0, NULL, NULL, &err);
+      check(err);
+      return result;
+    }
+    default: throw;
+  }
+}
+
+void CommandQueue::unmap(Buffer const & buffer, void* ptr)
+{
+  switch(backend_)
+  {
+    case CUDA:
       break;
     case OPENCL:
-      check(dispatch::clEnqueueReadBuffer(h_.cl(), buffer.h_.cl(), blocking?CL_TRUE:CL_FALSE, offset, size, ptr, 0, NULL, NULL));
+      check(dispatch::clEnqueueUnmapMemObject(h_.cl(), buffer.h_.cl(), ptr, 0, NULL, NULL));
       break;
     default: throw;
   }
@@ -22,7 +22,9 @@
 #include <algorithm>
 #include <sstream>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include "isaac/driver/device.h"
 #include "helpers/ocl/infos.hpp"
@@ -42,79 +44,66 @@ int Device::cuGetInfo() const
   return res;
 }
 
-Device::Device(CUdevice const & device, bool take_ownership): backend_(CUDA), h_(backend_, take_ownership)
-{
-  h_.cu() = device;
-}
-
-Device::Device(cl_device_id const & device, bool take_ownership) : backend_(OPENCL), h_(backend_, take_ownership)
+static Device::Vendor vendor(std::string vname)
 {
-    h_.cl() = device;
-}
-
-
-Device::Vendor Device::vendor() const
-{
-    std::string vname = vendor_str();
     std::transform(vname.begin(), vname.end(), vname.begin(), ::tolower);
     if(vname.find("nvidia")!=std::string::npos)
-        return Vendor::NVIDIA;
+        return Device::Vendor::NVIDIA;
     else if(vname.find("intel")!=std::string::npos)
-        return Vendor::INTEL;
+        return Device::Vendor::INTEL;
     else if(vname.find("amd")!=std::string::npos || vname.find("advanced micro devices")!=std::string::npos)
-        return Vendor::AMD;
+        return Device::Vendor::AMD;
     else
-        return Vendor::UNKNOWN;
+        return Device::Vendor::UNKNOWN;
 }
 
-
-Device::Architecture Device::architecture() const
+static Device::Architecture architecture(Device::properties_type const & properties)
 {
-    switch(vendor())
+    switch(properties.vendor)
     {
-        case Vendor::INTEL:
+        case Device::Vendor::INTEL:
         {
-            return Architecture::BROADWELL;
+            return Device::Architecture::BROADWELL;
         }
-        case Vendor::NVIDIA:
+        case Device::Vendor::NVIDIA:
         {
-            std::pair<unsigned int, unsigned int> sm = nv_compute_capability();
+            std::pair<unsigned int, unsigned int> const & sm = properties.nv_compute_capability;
             switch(sm.first)
             {
                 case 5:
                   switch(sm.second)
                   {
-                    case 0: return Architecture::SM_5_0;
-                    case 2: return Architecture::SM_5_2;
-                    default: return Architecture::UNKNOWN;
+                    case 0: return Device::Architecture::SM_5_0;
+                    case 2: return Device::Architecture::SM_5_2;
+                    default: return Device::Architecture::UNKNOWN;
                   }
 
                 case 3:
                     switch(sm.second)
                     {
-                      case 0: return Architecture::SM_3_0;
-                      case 5: return Architecture::SM_3_5;
-                      case 7: return Architecture::SM_3_7;
-                      default: return Architecture::UNKNOWN;
+                      case 0: return Device::Architecture::SM_3_0;
+                      case 5: return Device::Architecture::SM_3_5;
+                      case 7: return Device::Architecture::SM_3_7;
+                      default: return Device::Architecture::UNKNOWN;
                     }
 
                 case 2:
                     switch(sm.second)
                     {
-                      case 0: return Architecture::SM_2_0;
-                      case 1: return Architecture::SM_2_1;
-                      default: return Architecture::UNKNOWN;
+                      case 0: return Device::Architecture::SM_2_0;
+                      case 1: return Device::Architecture::SM_2_1;
+                      default: return Device::Architecture::UNKNOWN;
                     }
 
-                default: return Architecture::UNKNOWN;
+                default: return Device::Architecture::UNKNOWN;
             }
         }
-        case Vendor::AMD:
+        case Device::Vendor::AMD:
         {
             //No simple way to query TeraScale/GCN version. Enumerate...
-            std::string device_name = name();
+            std::string const & device_name = properties.name;
 
-        #define MAP_DEVICE(device,arch)if (device_name.find(device,0)!=std::string::npos) return Architecture::arch;
+        #define MAP_DEVICE(device,arch)if (device_name.find(device,0)!=std::string::npos) return Device::Architecture::arch;
             //TERASCALE 2
             MAP_DEVICE("Barts",TERASCALE_2);
             MAP_DEVICE("Cedar",TERASCALE_2);
@@ -155,130 +144,210 @@ Device::Architecture Device::architecture() const
         }
         default:
         {
-            return Architecture::UNKNOWN;
+            return Device::Architecture::UNKNOWN;
         }
     }
 }
 
-backend_type Device::backend() const
-{ return backend_; }
-
-unsigned int Device::address_bits() const
+Device::properties_type Device::query() const
 {
   switch(backend_)
   {
-    case CUDA: return sizeof(size_t)*8;
-    case OPENCL: return ocl::info<CL_DEVICE_ADDRESS_BITS>(h_.cl());
-    default: throw;
+    case CUDA:
+    {
+      properties_type result((Platform(CUDA)));
+      char name[128];
+      check(dispatch::cuDeviceGetName(name, 128, h_.cu()));
+      result.name = name;
+      result.vendor_str = "NVidia";
+      result.type = Type::GPU;
+      result.address_bits = sizeof(size_t)*8;
+      //Reported in kHz, and in MHz by OpenCL
+      result.clock_rate = cuGetInfo<CU_DEVICE_ATTRIBUTE_CLOCK_RATE>()/1000;
+      result.compute_units = cuGetInfo<CU_DEVICE_ATTRIBUTE_MULTIPROCESSOR_COUNT>();
+      check(dispatch::cuDeviceTotalMem_v2(&result.global_mem_size, h_.cu()));
+      result.local_mem_size = cuGetInfo<CU_DEVICE_ATTRIBUTE_MAX_SHARED_MEMORY_PER_BLOCK>();
+      result.mem_base_addr_align = 256; //Guaranteed by cuMemAlloc
+      result.max_work_group_size = cuGetInfo<CU_DEVICE_ATTRIBUTE_MAX_THREADS_PER_BLOCK>();
+      result.max_work_item_sizes = {(size_t)cuGetInfo<CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_X>(), (size_t)cuGetInfo<CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_Y>(), (size_t)cuGetInfo<CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_Z>()};
+      result.warp_wavefront_size = cuGetInfo<CU_DEVICE_ATTRIBUTE_WARP_SIZE>();
+      result.nv_compute_capability = std::make_pair(cuGetInfo<CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR>(), cuGetInfo<CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR>());
+      result.fp64_support = true;
+      result.host_unified_memory = cuGetInfo<CU_DEVICE_ATTRIBUTE_INTEGRATED>();
+      result.fill_support = true;
+      result.max_sub_devices = 0;
+      result.numa_partition_support = false;
+      result.vendor = driver::vendor(result.vendor_str);
+      result.architecture = driver::architecture(result);
+      return result;
+    }
+    case OPENCL:
+    {
+      cl_device_id id = h_.cl();
+      properties_type result(Platform(ocl::info<CL_DEVICE_PLATFORM>(id)));
+      result.name = ocl::info<CL_DEVICE_NAME>(id);
+      result.vendor_str = ocl::info<CL_DEVICE_VENDOR>(id);
+      result.extensions = ocl::info<CL_DEVICE_EXTENSIONS>(id);
+      result.type = static_cast<Type>(ocl::info<CL_DEVICE_TYPE>(id));
+      result.address_bits = ocl::info<CL_DEVICE_ADDRESS_BITS>(id);
+      result.clock_rate = ocl::info<CL_DEVICE_MAX_CLOCK_FREQUENCY>(id);
+      result.compute_units = ocl::info<CL_DEVICE_MAX_COMPUTE_UNITS>(id);
+      result.global_mem_size = ocl::info<CL_DEVICE_GLOBAL_MEM_SIZE>(id);
+      result.local_mem_size = ocl::info<CL_DEVICE_LOCAL_MEM_SIZE>(id);
+      result.mem_base_addr_align = ocl::info<CL_DEVICE_MEM_BASE_ADDR_ALIGN>(id)/8;
+      result.max_work_group_size = ocl::info<CL_DEVICE_MAX_WORK_GROUP_SIZE>(id);
+      result.max_work_item_sizes = ocl::info<CL_DEVICE_MAX_WORK_ITEM_SIZES>(id);
+      result.vendor = driver::vendor(result.vendor_str);
+      //Vendor-specific queries fail on other devices
+      result.warp_wavefront_size = 0;
+      if(result.vendor==Vendor::AMD && result.extensions.find("cl_amd_device_attribute_query")!=std::string::npos)
+        result.warp_wavefront_size = ocl::info<CL_DEVICE_WAVEFRONT_WIDTH_AMD>(id);
+      result.nv_compute_capability = std::make_pair(0u, 0u);
+      if(result.extensions.find("cl_nv_device_attribute_query")!=std::string::npos)
+        result.nv_compute_capability = std::make_pair(ocl::info<CL_DEVICE_COMPUTE_CAPABILITY_MAJOR_NV>(id), ocl::info<CL_DEVICE_COMPUTE_CAPABILITY_MINOR_NV>(id));
+      result.fp64_support = result.extensions.find("cl_khr_fp64")!=std::string::npos;
+      result.host_unified_memory = result.type==Type::CPU || ocl::info<CL_DEVICE_HOST_UNIFIED_MEMORY>(id);
+      //"OpenCL <major>.<minor> <vendor-specific>"
+      std::string version = ocl::info<CL_DEVICE_VERSION>(id);
+      bool opencl_1_2 = version.compare(0, 7, "OpenCL ")==0 && version.compare(7, 3, "1.0")!=0 && version.compare(7, 3, "1.1")!=0;
+      result.fill_support = opencl_1_2;
+      result.max_sub_devices = opencl_1_2?ocl::info<CL_DEVICE_PARTITION_MAX_SUB_DEVICES>(id):0;
+      result.numa_partition_support = result.max_sub_devices > 1 && (ocl::info<CL_DEVICE_PARTITION_AFFINITY_DOMAIN>(id) & CL_DEVICE_AFFINITY_DOMAIN_NUMA);
+      result.architecture = driver::architecture(result);
+      return result;
+    }
+    default:
+      throw;
   }
-
-  return backend_;
 }
 
-driver::Platform Device::platform() const
+std::shared_ptr<Device::properties_type const> Device::snapshot() const
 {
-  switch(backend_)
-  {
-    case CUDA: return Platform(CUDA);
-    case OPENCL: return Platform(ocl::info<CL_DEVICE_PLATFORM>(h_.cl()));
-    default: throw;
-  }
+  typedef std::pair<backend_type, uintptr_t> key_type;
+  static std::map<key_type, std::shared_ptr<properties_type const> > cache;
+  static std::mutex mutex;
+  key_type key(backend_, (backend_==CUDA)?(uintptr_t)h_.cu():(uintptr_t)h_.cl());
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = cache.find(key);
+  if(it==cache.end())
+    it = cache.insert(std::make_pair(key, std::make_shared<properties_type const>(query()))).first;
+  return it->second;
 }
 
-std::string Device::name() const
+Device::Device(CUdevice const & device, bool take_ownership): backend_(CUDA), h_(backend_, take_ownership)
 {
-  switch(backend_)
-  {
-    case CUDA:
-      char tmp[128];
-      check(dispatch::cuDeviceGetName(tmp, 128, h_.cu()));
-      return std::string(tmp);
-    case OPENCL:
-      return ocl::info<CL_DEVICE_NAME>(h_.cl());
-    default: throw;
-  }
+  h_.cu() = device;
+  properties_ = snapshot();
 }
 
-std::string Device::vendor_str() const
+Device::Device(cl_device_id const & device, bool take_ownership) : backend_(OPENCL), h_(backend_, take_ownership)
 {
-  switch(backend_)
-  {
-    case CUDA:
-      return "NVidia";
-    case OPENCL:
-      return ocl::info<CL_DEVICE_VENDOR>(h_.cl());
-    default: throw;
-  }
+  h_.cl() = device;
+  properties_ = snapshot();
 }
 
+Device::properties_type const & Device::properties() const
+{ return *properties_; }
+
+Device::Vendor Device::vendor() const
+{ return properties_->vendor; }
+
+Device::Architecture Device::architecture() const
+{ return properties_->architecture; }
+
+backend_type Device::backend() const
+{ return backend_; }
+
+Device::handle_type const & Device::handle() const
+{ return h_; }
+
+unsigned int Device::address_bits() const
+{ return properties_->address_bits; }
+
+driver::Platform Device::platform() const
+{ return properties_->platform; }
+
+std::string Device::name() const
+{ return properties_->name; }
+
+std::string Device::vendor_str() const
+{ return properties_->vendor_str; }
 
 std::vector<size_t> Device::max_work_item_sizes() const
-{
-  switch(backend_)
-  {
-    case CUDA:
-    {
-      std::vector<size_t> result(3);
-      result[0] = cuGetInfo<CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_X>();
-      result[1] = cuGetInfo<CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_Y>();
-      result[2] = cuGetInfo<CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_Z>();
-      return result;
-    }
-    case OPENCL:
-      return ocl::info<CL_DEVICE_MAX_WORK_ITEM_SIZES>(h_.cl());
-    default:
-      throw;
-  }
-}
+{ return properties_->max_work_item_sizes; }
 
 Device::Type Device::type() const
-{
-  switch(backend_)
-  {
-    case CUDA: return Type::GPU;
-    case OPENCL: return static_cast<Type>(ocl::info<CL_DEVICE_TYPE>(h_.cl()));
-    default: throw;
-  }
-}
+{ return properties_->type; }
 
 std::string Device::extensions() const
+{ return properties_->extensions; }
+
+std::pair<unsigned int, unsigned int> Device::nv_compute_capability() const
+{ return properties_->nv_compute_capability; }
+
+bool Device::fp64_support() const
+{ return properties_->fp64_support; }
+
+bool Device::host_unified_memory() const
+{ return properties_->host_unified_memory; }
+
+bool Device::fill_support() const
+{ return properties_->fill_support; }
+
+unsigned int Device::max_sub_devices() const
+{ return properties_->max_sub_devices; }
+
+static void create_sub_devices(cl_device_id device, cl_device_partition_property const * properties, std::vector<Device> & devices)
 {
-  switch(backend_)
-  {
-    case CUDA:
-      return "";
-    case OPENCL:
-      return ocl::info<CL_DEVICE_EXTENSIONS>(h_.cl());
-    default: throw;
-  }
+  cl_uint ndevices;
+  check(dispatch::clCreateSubDevices(device, properties, 0, NULL, &ndevices));
+  std::vector<cl_device_id> device_ids(ndevices);
+  check(dispatch::clCreateSubDevices(device, properties, ndevices, device_ids.data(), NULL));
+  for(cl_device_id d: device_ids)
+    devices.push_back(Device(d));
 }
 
-std::pair<unsigned int, unsigned int> Device::nv_compute_capability() const
+void Device::partition_numa(std::vector<Device> & devices) const
 {
-  switch(backend_)
-  {
-      case OPENCL:
-          return std::pair<unsigned int, unsigned int>(ocl::info<CL_DEVICE_COMPUTE_CAPABILITY_MAJOR_NV>(h_.cl()), ocl::info<CL_DEVICE_COMPUTE_CAPABILITY_MINOR_NV>(h_.cl()));
-      case CUDA:
-          return std::pair<unsigned int, unsigned int>(cuGetInfo<CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR>(), cuGetInfo<CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR>());
-      default:
-          throw;
+  if(!properties_->numa_partition_support){
+    devices.push_back(*this);
+    return;
   }
+  cl_device_partition_property properties[] = {CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN, CL_DEVICE_AFFINITY_DOMAIN_NUMA, 0};
+  create_sub_devices(h_.cl(), properties, devices);
 }
 
-bool Device::fp64_support() const
+void Device::partition_equally(size_t compute_units, std::vector<Device> & devices) const
 {
-  switch(backend_)
-  {
-    case OPENCL:
-      return extensions().find("cl_khr_fp64")!=std::string::npos;
-    case CUDA:
-      return true;
-    default:
-      throw;
+  if(properties_->max_sub_devices < 2 || compute_units >= properties_->compute_units){
+    devices.push_back(*this);
+    return;
   }
+  cl_device_partition_property properties[] = {CL_DEVICE_PARTITION_EQUALLY, (cl_device_partition_property)compute_units, 0};
+  create_sub_devices(h_.cl(), properties, devices);
 }
 
+size_t Device::max_work_group_size() const
+{ return properties_->max_work_group_size; }
+
+size_t Device::local_mem_size() const
+{ return properties_->local_mem_size; }
+
+size_t Device::global_mem_size() const
+{ return properties_->global_mem_size; }
+
+size_t Device::compute_units() const
+{ return properties_->compute_units; }
+
+size_t Device::mem_base_addr_align() const
+{ return properties_->mem_base_addr_align; }
+
+size_t Device::warp_wavefront_size() const
+{ return properties_->warp_wavefront_size; }
+
+size_t Device::clock_rate() const
+{ return properties_->clock_rate; }
+
 std::string Device::infos() const
 {
   std::ostringstream oss;
@@ -294,27 +363,6 @@ std::string Device::infos() const
   return oss.str();
 }
 
-// Properties
-#define WRAP_ATTRIBUTE(ret, fname, CUNAME, CLNAME) \
-  ret Device::fname() const\
-  {\
-    switch(backend_)\
-    {\
-      case CUDA: return cuGetInfo<CUNAME>();\
-      case OPENCL: return static_cast<ret>(ocl::info<CLNAME>(h_.cl()));\
-      default: throw;\
-    }\
-  }\
-
-
-WRAP_ATTRIBUTE(size_t, max_work_group_size, CU_DEVICE_ATTRIBUTE_MAX_THREADS_PER_BLOCK, CL_DEVICE_MAX_WORK_GROUP_SIZE)
-WRAP_ATTRIBUTE(size_t, local_mem_size, CU_DEVICE_ATTRIBUTE_MAX_SHARED_MEMORY_PER_BLOCK, CL_DEVICE_LOCAL_MEM_SIZE)
-WRAP_ATTRIBUTE(size_t, warp_wavefront_size, CU_DEVICE_ATTRIBUTE_WARP_SIZE, CL_DEVICE_WAVEFRONT_WIDTH_AMD)
-WRAP_ATTRIBUTE(size_t, clock_rate, CU_DEVICE_ATTRIBUTE_CLOCK_RATE, CL_DEVICE_MAX_CLOCK_FREQUENCY)
-
-
-
 }
 
 }
-
@@ -20,6 +20,7 @@
  */
 
 #include "isaac/driver/dispatch.h"
+#include "isaac/driver/recording.h"
 
 namespace isaac
 {
@@ -60,6 +61,9 @@ namespace driver
 #define DEFINE11(init, hlib, ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11) ret dispatch::fname(t1 a, t2 b, t3 c, t4 d, t5 e, t6 f, t7 g, t8 h, t9 i, t10 j, t11 k)\
  {return f_impl<dispatch::init>(hlib, fname, fname ## _, #fname, a, b, c, d, e, f, g, h, i, j, k); }
 
+#define DEFINE14(init, hlib, ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14) ret dispatch::fname(t1 a, t2 b, t3 c, t4 d, t5 e, t6 f, t7 g, t8 h, t9 i, t10 j, t11 k, t12 l, t13 m, t14 n)\
+ {return f_impl<dispatch::init>(hlib, fname, fname ## _, #fname, a, b, c, d, e, f, g, h, i, j, k, l, m, n); }
+
 //Specialized helpers for OpenCL
 #define OCL_DEFINE1(ret, fname, t1) DEFINE1(clinit, opencl_, ret, fname, t1)
 #define OCL_DEFINE2(ret, fname, t1, t2) DEFINE2(clinit, opencl_, ret, fname, t1, t2)
@@ -70,6 +74,8 @@ namespace driver
 #define OCL_DEFINE7(ret, fname, t1, t2, t3, t4, t5, t6, t7) DEFINE7(clinit, opencl_, ret, fname, t1, t2, t3, t4, t5, t6, t7)
 #define OCL_DEFINE8(ret, fname, t1, t2, t3, t4, t5, t6, t7, t8) DEFINE8(clinit, opencl_, ret, fname, t1, t2, t3, t4, t5, t6, t7, t8)
 #define OCL_DEFINE9(ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9) DEFINE9(clinit, opencl_, ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9)
+#define OCL_DEFINE10(ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10) DEFINE10(clinit, opencl_, ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10)
+#define OCL_DEFINE14(ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14) DEFINE14(clinit, opencl_, ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14)
 
 //Specialized helpers for CUDA
 #define CUDA_DEFINE1(ret, fname, t1) DEFINE1(cuinit, cuda_, ret, fname, t1)
@@ -97,27 +103,37 @@ namespace driver
 #define NVRTC_DEFINE11(ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11) DEFINE11(nvrtcinit, nvrtc_, ret, fname, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11)
 
 
+//Handle standing for the recording platform in place of libOpenCL
+static char recording_;
+
 bool dispatch::clinit()
 {
     if(opencl_==nullptr)
-        opencl_ = dlopen("libOpenCL.so", RTLD_LAZY);
+        opencl_ = recording::enabled()?&recording_:dlopen("libOpenCL.so", RTLD_LAZY);
     return opencl_ != nullptr;
 }
 
 bool dispatch::cuinit()
 {
-    if(cuda_==nullptr)
+    if(cuda_==nullptr && !recording::enabled())
         cuda_ = dlopen("libcuda.so", RTLD_LAZY);
     return cuda_ != nullptr;
 }
 
 bool dispatch::nvrtcinit()
 {
-    if(nvrtc_==nullptr)
+    if(nvrtc_==nullptr && !recording::enabled())
         nvrtc_ = dlopen("libnvrtc.so", RTLD_LAZY);
     return nvrtc_ != nullptr;
 }
 
+void* dispatch::symbol(void* lib_h, const char * name)
+{
+    if(lib_h==&recording_)
+        return recording::symbol(name);
+    return lib_h?dlsym(lib_h, name):nullptr;
+}
+
 
 //OpenCL
 
@@ -140,6 +156,7 @@ OCL_DEFINE9(cl_int, clEnqueueReadBuffer, cl_command_queue, cl_mem, cl_bool, size
 OCL_DEFINE6(cl_int, clGetProgramBuildInfo, cl_program, cl_device_id, cl_program_build_info, size_t, void *, size_t *)
 OCL_DEFINE1(cl_int, clReleaseDevice, cl_device_id)
 OCL_DEFINE5(cl_int, clGetDeviceIDs, cl_platform_id, cl_device_type, cl_uint, cl_device_id *, cl_uint *)
+OCL_DEFINE5(cl_int, clCreateSubDevices, cl_device_id, const cl_device_partition_property *, cl_uint, cl_device_id *, cl_uint *)
 OCL_DEFINE5(cl_int, clGetContextInfo, cl_context, cl_context_info, size_t, void *, size_t *)
 OCL_DEFINE5(cl_int, clGetDeviceInfo, cl_device_id, cl_device_info, size_t, void *, size_t *)
 OCL_DEFINE1(cl_int, clReleaseCommandQueue, cl_command_queue)
@@ -156,8 +173,16 @@ OCL_DEFINE5(cl_int, clGetKernelInfo, cl_kernel, cl_kernel_info, size_t, void *,
 OCL_DEFINE6(cl_int, clGetKernelWorkGroupInfo, cl_kernel, cl_device_id, cl_kernel_work_group_info, size_t, void *, size_t *)
 OCL_DEFINE3(cl_kernel, clCreateKernel, cl_program, const char *, cl_int *)
 OCL_DEFINE5(cl_mem, clCreateBuffer, cl_context, cl_mem_flags, size_t, void *, cl_int *)
+OCL_DEFINE5(cl_mem, clCreateSubBuffer, cl_mem, cl_mem_flags, cl_buffer_create_type, const void *, cl_int *)
 OCL_DEFINE5(cl_program, clCreateProgramWithSource, cl_context, cl_uint, const char **, const size_t *, cl_int *)
 OCL_DEFINE1(cl_int, clReleaseKernel, cl_kernel)
+OCL_DEFINE10(void*, clEnqueueMapBuffer, cl_command_queue, cl_mem, cl_bool, cl_map_flags, size_t, size_t, cl_uint, const cl_event *, cl_event *, cl_int *)
+OCL_DEFINE6(cl_int, clEnqueueUnmapMemObject, cl_command_queue, cl_mem, void *, cl_uint, const cl_event *, cl_event *)
+OCL_DEFINE4(cl_int, clEnqueueMarkerWithWaitList, cl_command_queue, cl_uint, const cl_event *, cl_event *)
+OCL_DEFINE2(cl_int, clWaitForEvents, cl_uint, const cl_event *)
+OCL_DEFINE14(cl_int, clEnqueueWriteBufferRect, cl_command_queue, cl_mem, cl_bool, const size_t *, const size_t *, const size_t *, size_t, size_t, size_t, size_t, const void *, cl_uint, const cl_event *, cl_event *)
+OCL_DEFINE9(cl_int, clEnqueueFillBuffer, cl_command_queue, cl_mem, const void *, size_t, size_t, size_t, cl_uint, const cl_event *, cl_event *)
+OCL_DEFINE14(cl_int, clEnqueueReadBufferRect, cl_command_queue, cl_mem, cl_bool, const size_t *, const size_t *, const size_t *, size_t, size_t, size_t, size_t, void *, cl_uint, const cl_event *, cl_event *)
 
 //CUDA
 CUDA_DEFINE1(CUresult, cuCtxDestroy_v2, CUcontext)
@@ -170,6 +195,7 @@ CUDA_DEFINE1(CUresult, cuMemFree_v2, CUdeviceptr)
 CUDA_DEFINE4(CUresult, cuMemcpyDtoHAsync_v2, void *, CUdeviceptr, size_t, CUstream)
 CUDA_DEFINE1(CUresult, cuDriverGetVersion, int *)
 CUDA_DEFINE3(CUresult, cuDeviceGetName, char *, int, CUdevice)
+CUDA_DEFINE2(CUresult, cuDeviceTotalMem_v2, size_t *, CUdevice)
 CUDA_DEFINE4(CUresult, cuMemcpyHtoDAsync_v2, CUdeviceptr, const void *, size_t, CUstream)
 CUDA_DEFINE2(CUresult, cuModuleLoad, CUmodule *, const char *)
 CUDA_DEFINE11(CUresult, cuLaunchKernel, CUfunction, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, CUstream, void **, void **)
@@ -188,6 +214,20 @@ CUDA_DEFINE1(CUresult, cuEventDestroy_v2, CUevent)
 CUDA_DEFINE2(CUresult, cuMemAlloc_v2, CUdeviceptr*, size_t)
 CUDA_DEFINE3(CUresult, cuPointerGetAttribute, void*, CUpointer_attribute, CUdeviceptr)
 CUDA_DEFINE1(CUresult, cuCtxGetDevice, CUdevice*)
+CUDA_DEFINE1(CUresult, cuCtxPushCurrent_v2, CUcontext)
+CUDA_DEFINE1(CUresult, cuCtxPopCurrent_v2, CUcontext*)
+CUDA_DEFINE3(CUresult, cuStreamWaitEvent, CUstream, CUevent, unsigned int)
+CUDA_DEFINE3(CUresult, cuMemHostAlloc, void **, size_t, unsigned int)
+CUDA_DEFINE1(CUresult, cuMemFreeHost, void *)
+CUDA_DEFINE3(CUresult, cuMemHostGetDevicePointer_v2, CUdeviceptr *, void *, unsigned int)
+CUDA_DEFINE3(CUresult, cuMemHostRegister_v2, void *, size_t, unsigned int)
+CUDA_DEFINE1(CUresult, cuMemHostUnregister, void *)
+CUDA_DEFINE1(CUresult, cuEventSynchronize, CUevent)
+CUDA_DEFINE1(CUresult, cuMemcpy2D_v2, const CUDA_MEMCPY2D *)
+CUDA_DEFINE2(CUresult, cuMemcpy2DAsync_v2, const CUDA_MEMCPY2D *, CUstream)
+CUDA_DEFINE4(CUresult, cuMemsetD8Async, CUdeviceptr, unsigned char, size_t, CUstream)
+CUDA_DEFINE4(CUresult, cuMemsetD16Async, CUdeviceptr, unsigned short, size_t, CUstream)
+CUDA_DEFINE4(CUresult, cuMemsetD32Async, CUdeviceptr, unsigned int, size_t, CUstream)
 
 NVRTC_DEFINE3(nvrtcResult, nvrtcCompileProgram, nvrtcProgram, int, const char **)
 NVRTC_DEFINE2(nvrtcResult, nvrtcGetProgramLogSize, nvrtcProgram, size_t *)
@@ -199,7 +239,8 @@ NVRTC_DEFINE2(nvrtcResult, nvrtcGetProgramLog, nvrtcProgram, char *)
 void dispatch::release()
 {
     if(opencl_){
-        dlclose(opencl_);
+        if(opencl_!=&recording_)
+            dlclose(opencl_);
         opencl_ = nullptr;
     }
     if(cuda_){
@@ -232,6 +273,7 @@ void* dispatch::clGetProgramBuildInfo_;
 void* dispatch::clReleaseDevice_;
 void* dispatch::clCreateContext_;
 void* dispatch::clGetDeviceIDs_;
+void* dispatch::clCreateSubDevices_;
 void* dispatch::clGetContextInfo_;
 void* dispatch::clGetDeviceInfo_;
 void* dispatch::clReleaseCommandQueue_;
@@ -248,8 +290,16 @@ void* dispatch::clGetKernelInfo_;
 void* dispatch::clGetKernelWorkGroupInfo_;
 void* dispatch::clCreateKernel_;
 void* dispatch::clCreateBuffer_;
+void* dispatch::clCreateSubBuffer_;
 void* dispatch::clCreateProgramWithSource_;
 void* dispatch::clReleaseKernel_;
+void* dispatch::clEnqueueMapBuffer_;
+void* dispatch::clEnqueueUnmapMemObject_;
+void* dispatch::clEnqueueMarkerWithWaitList_;
+void* dispatch::clWaitForEvents_;
+void* dispatch::clEnqueueWriteBufferRect_;
+void* dispatch::clEnqueueReadBufferRect_;
+void* dispatch::clEnqueueFillBuffer_;
 
 //CUDA
 void* dispatch::cuCtxDestroy_v2_;
@@ -262,6 +312,7 @@ void* dispatch::cuMemFree_v2_;
 void* dispatch::cuMemcpyDtoHAsync_v2_;
 void* dispatch::cuDriverGetVersion_;
 void* dispatch::cuDeviceGetName_;
+void* dispatch::cuDeviceTotalMem_v2_;
 void* dispatch::cuMemcpyHtoDAsync_v2_;
 void* dispatch::cuModuleLoad_;
 void* dispatch::cuLaunchKernel_;
@@ -280,6 +331,20 @@ void* dispatch::cuEventDestroy_v2_;
 void* dispatch::cuMemAlloc_v2_;
 void* dispatch::cuPointerGetAttribute_;
 void* dispatch::cuCtxGetDevice_;
+void* dispatch::cuCtxPushCurrent_v2_;
+void* dispatch::cuCtxPopCurrent_v2_;
+void* dispatch::cuStreamWaitEvent_;
+void* dispatch::cuMemHostAlloc_;
+void* dispatch::cuMemFreeHost_;
+void* dispatch::cuMemHostGetDevicePointer_v2_;
+void* dispatch::cuMemHostRegister_v2_;
+void* dispatch::cuMemHostUnregister_;
+void* dispatch::cuEventSynchronize_;
+void* dispatch::cuMemcpy2D_v2_;
+void* dispatch::cuMemcpy2DAsync_v2_;
+void* dispatch::cuMemsetD8Async_;
+void* dispatch::cuMemsetD16Async_;
+void* dispatch::cuMemsetD32Async_;
 
 void* dispatch::nvrtcCompileProgram_;
 void* dispatch::nvrtcGetProgramLogSize_;
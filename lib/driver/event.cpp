@@ -48,6 +48,16 @@ Event::Event(cl_event const & event, bool take_ownership) : backend_(OPENCL), h_
   h_.cl() = event;
 }
 
+void Event::synchronize() const
+{
+  switch(backend_)
+  {
+    case CUDA: check(dispatch::cuEventSynchronize(h_.cu().second)); break;
+    case OPENCL: check(dispatch::clWaitForEvents(1, &h_.cl())); break;
+    default: throw;
+  }
+}
+
 long Event::elapsed_time() const
 {
   switch(backend_)
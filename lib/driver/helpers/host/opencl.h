@@ -0,0 +1,160 @@
+/*
+ * OpenCL C on the host.
+ *
+ * Prepended to the kernels compiled by the system compiler. Address spaces are dropped
+ * (__local declarations are turned into thread_local statics beforehand, since a work-group
+ * runs on a single thread), work-item functions read the state of the running work-item and
+ * barrier() yields to the other work-items of the group.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#define __kernel static
+#define __global
+#define __constant const
+#define __private
+#define CLK_LOCAL_MEM_FENCE 1
+#define CLK_GLOBAL_MEM_FENCE 2
+
+typedef unsigned char uchar;
+typedef unsigned short ushort;
+typedef unsigned int uint;
+typedef unsigned long ulong;
+
+/*----------------------
+ * Work-items
+ *---------------------*/
+
+struct isaac_item_t
+{
+  size_t global_id[3];
+  size_t local_id[3];
+  size_t group_id[3];
+  size_t global_size[3];
+  size_t local_size[3];
+  size_t num_groups[3];
+  void (*barrier)();
+};
+
+static thread_local isaac_item_t const * isaac_item;
+
+static inline size_t get_global_id(uint d) { return isaac_item->global_id[d]; }
+static inline size_t get_local_id(uint d) { return isaac_item->local_id[d]; }
+static inline size_t get_group_id(uint d) { return isaac_item->group_id[d]; }
+static inline size_t get_global_size(uint d) { return isaac_item->global_size[d]; }
+static inline size_t get_local_size(uint d) { return isaac_item->local_size[d]; }
+static inline size_t get_num_groups(uint d) { return isaac_item->num_groups[d]; }
+
+static inline void barrier(int)
+{
+  isaac_item_t const * self = isaac_item;
+  self->barrier();
+  isaac_item = self;
+}
+
+/*----------------------
+ * Built-in functions
+ *---------------------*/
+
+using std::abs; using std::acos; using std::asin; using std::atan; using std::ceil; using std::cos;
+using std::cosh; using std::exp; using std::fabs; using std::floor; using std::fmax; using std::fmin;
+using std::log; using std::pow; using std::sin; using std::sinh; using std::sqrt; using std::tan; using std::tanh;
+
+template<class T, class U>
+static inline typename std::common_type<T, U>::type min(T a, U b) { return (b < a)?b:a; }
+
+template<class T, class U>
+static inline typename std::common_type<T, U>::type max(T a, U b) { return (a < b)?b:a; }
+
+template<class A, class B, class C>
+static inline typename std::common_type<A, B, C>::type mad(A a, B b, C c) { return a*b + c; }
+
+template<class A, class B, class C>
+static inline typename std::common_type<A, B>::type select(A a, B b, C c) { return c ? b : a; }
+
+/*----------------------
+ * Vector types
+ *---------------------*/
+
+template<class T>
+struct isaac_vec2
+{
+  isaac_vec2() {}
+  isaac_vec2(T s) : x(s), y(s) {}
+  isaac_vec2(T _x, T _y) : x(_x), y(_y) {}
+  T & operator[](int i) { return (&x)[i]; }
+  T const & operator[](int i) const { return (&x)[i]; }
+  static const int size = 2;
+  T x, y;
+};
+
+template<class T>
+struct isaac_vec4
+{
+  isaac_vec4() {}
+  isaac_vec4(T s) : x(s), y(s), z(s), w(s) {}
+  isaac_vec4(T _x, T _y, T _z, T _w) : x(_x), y(_y), z(_z), w(_w) {}
+  T & operator[](int i) { return (&x)[i]; }
+  T const & operator[](int i) const { return (&x)[i]; }
+  static const int size = 4;
+  T x, y, z, w;
+};
+
+template<class V> struct isaac_is_vec { static const bool value = false; };
+template<class T> struct isaac_is_vec<isaac_vec2<T> > { static const bool value = true; };
+template<class T> struct isaac_is_vec<isaac_vec4<T> > { static const bool value = true; };
+
+//Component-wise operators, scalars are broadcast
+#define ISAAC_VEC_OPERATOR(OP) \
+template<class V> \
+static inline typename std::enable_if<isaac_is_vec<V>::value, V>::type operator OP(V a, V const & b) \
+{ for(int i = 0 ; i < V::size ; ++i) a[i] = a[i] OP b[i]; return a; } \
+template<class V, class S> \
+static inline typename std::enable_if<isaac_is_vec<V>::value && std::is_arithmetic<S>::value, V>::type operator OP(V a, S b) \
+{ for(int i = 0 ; i < V::size ; ++i) a[i] = a[i] OP b; return a; } \
+template<class V, class S> \
+static inline typename std::enable_if<isaac_is_vec<V>::value && std::is_arithmetic<S>::value, V>::type operator OP(S a, V b) \
+{ for(int i = 0 ; i < V::size ; ++i) b[i] = a OP b[i]; return b; }
+
+ISAAC_VEC_OPERATOR(+)
+ISAAC_VEC_OPERATOR(-)
+ISAAC_VEC_OPERATOR(*)
+ISAAC_VEC_OPERATOR(/)
+
+#undef ISAAC_VEC_OPERATOR
+
+#define ISAAC_VEC_TYPES(T) \
+typedef isaac_vec2<T> T ## 2; \
+typedef isaac_vec4<T> T ## 4;
+
+ISAAC_VEC_TYPES(char)
+ISAAC_VEC_TYPES(uchar)
+ISAAC_VEC_TYPES(short)
+ISAAC_VEC_TYPES(ushort)
+ISAAC_VEC_TYPES(int)
+ISAAC_VEC_TYPES(uint)
+ISAAC_VEC_TYPES(long)
+ISAAC_VEC_TYPES(ulong)
+ISAAC_VEC_TYPES(float)
+ISAAC_VEC_TYPES(double)
+
+#undef ISAAC_VEC_TYPES
+
+template<class T>
+static inline isaac_vec2<typename std::remove_const<T>::type> vload2(size_t offset, T * p)
+{ p += 2*offset; return isaac_vec2<typename std::remove_const<T>::type>(p[0], p[1]); }
+
+template<class T>
+static inline isaac_vec4<typename std::remove_const<T>::type> vload4(size_t offset, T * p)
+{ p += 4*offset; return isaac_vec4<typename std::remove_const<T>::type>(p[0], p[1], p[2], p[3]); }
+
+template<class T>
+static inline void vstore2(isaac_vec2<T> const & v, size_t offset, T * p)
+{ p += 2*offset; p[0] = v.x; p[1] = v.y; }
+
+template<class T>
+static inline void vstore4(isaac_vec4<T> const & v, size_t offset, T * p)
+{ p += 4*offset; p[0] = v.x; p[1] = v.y; p[2] = v.z; p[3] = v.w; }
+
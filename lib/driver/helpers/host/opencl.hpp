@@ -0,0 +1,549 @@
+#pragma once
+
+#include <cstddef>
+
+namespace isaac
+{
+namespace helpers
+{
+namespace host
+{
+
+static const char opencl[] = {
+0x2f,	0x2a,	0xa,	0x20,	0x2a,	0x20,	0x4f,	0x70,	0x65,	0x6e,	
+0x43,	0x4c,	0x20,	0x43,	0x20,	0x6f,	0x6e,	0x20,	0x74,	0x68,	
+0x65,	0x20,	0x68,	0x6f,	0x73,	0x74,	0x2e,	0xa,	0x20,	0x2a,	
+0xa,	0x20,	0x2a,	0x20,	0x50,	0x72,	0x65,	0x70,	0x65,	0x6e,	
+0x64,	0x65,	0x64,	0x20,	0x74,	0x6f,	0x20,	0x74,	0x68,	0x65,	
+0x20,	0x6b,	0x65,	0x72,	0x6e,	0x65,	0x6c,	0x73,	0x20,	0x63,	
+0x6f,	0x6d,	0x70,	0x69,	0x6c,	0x65,	0x64,	0x20,	0x62,	0x79,	
+0x20,	0x74,	0x68,	0x65,	0x20,	0x73,	0x79,	0x73,	0x74,	0x65,	
+0x6d,	0x20,	0x63,	0x6f,	0x6d,	0x70,	0x69,	0x6c,	0x65,	0x72,	
+0x2e,	0x20,	0x41,	0x64,	0x64,	0x72,	0x65,	0x73,	0x73,	0x20,	
+0x73,	0x70,	0x61,	0x63,	0x65,	0x73,	0x20,	0x61,	0x72,	0x65,	
+0x20,	0x64,	0x72,	0x6f,	0x70,	0x70,	0x65,	0x64,	0xa,	0x20,	
+0x2a,	0x20,	0x28,	0x5f,	0x5f,	0x6c,	0x6f,	0x63,	0x61,	0x6c,	
+0x20,	0x64,	0x65,	0x63,	0x6c,	0x61,	0x72,	0x61,	0x74,	0x69,	
+0x6f,	0x6e,	0x73,	0x20,	0x61,	0x72,	0x65,	0x20,	0x74,	0x75,	
+0x72,	0x6e,	0x65,	0x64,	0x20,	0x69,	0x6e,	0x74,	0x6f,	0x20,	
+0x74,	0x68,	0x72,	0x65,	0x61,	0x64,	0x5f,	0x6c,	0x6f,	0x63,	
+0x61,	0x6c,	0x20,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x73,	
+0x20,	0x62,	0x65,	0x66,	0x6f,	0x72,	0x65,	0x68,	0x61,	0x6e,	
+0x64,	0x2c,	0x20,	0x73,	0x69,	0x6e,	0x63,	0x65,	0x20,	0x61,	
+0x20,	0x77,	0x6f,	0x72,	0x6b,	0x2d,	0x67,	0x72,	0x6f,	0x75,	
+0x70,	0xa,	0x20,	0x2a,	0x20,	0x72,	0x75,	0x6e,	0x73,	0x20,	
+0x6f,	0x6e,	0x20,	0x61,	0x20,	0x73,	0x69,	0x6e,	0x67,	0x6c,	
+0x65,	0x20,	0x74,	0x68,	0x72,	0x65,	0x61,	0x64,	0x29,	0x2c,	
+0x20,	0x77,	0x6f,	0x72,	0x6b,	0x2d,	0x69,	0x74,	0x65,	0x6d,	
+0x20,	0x66,	0x75,	0x6e,	0x63,	0x74,	0x69,	0x6f,	0x6e,	0x73,	
+0x20,	0x72,	0x65,	0x61,	0x64,	0x20,	0x74,	0x68,	0x65,	0x20,	
+0x73,	0x74,	0x61,	0x74,	0x65,	0x20,	0x6f,	0x66,	0x20,	0x74,	
+0x68,	0x65,	0x20,	0x72,	0x75,	0x6e,	0x6e,	0x69,	0x6e,	0x67,	
+0x20,	0x77,	0x6f,	0x72,	0x6b,	0x2d,	0x69,	0x74,	0x65,	0x6d,	
+0x20,	0x61,	0x6e,	0x64,	0xa,	0x20,	0x2a,	0x20,	0x62,	0x61,	
+0x72,	0x72,	0x69,	0x65,	0x72,	0x28,	0x29,	0x20,	0x79,	0x69,	
+0x65,	0x6c,	0x64,	0x73,	0x20,	0x74,	0x6f,	0x20,	0x74,	0x68,	
+0x65,	0x20,	0x6f,	0x74,	0x68,	0x65,	0x72,	0x20,	0x77,	0x6f,	
+0x72,	0x6b,	0x2d,	0x69,	0x74,	0x65,	0x6d,	0x73,	0x20,	0x6f,	
+0x66,	0x20,	0x74,	0x68,	0x65,	0x20,	0x67,	0x72,	0x6f,	0x75,	
+0x70,	0x2e,	0xa,	0x20,	0x2a,	0x2f,	0xa,	0xa,	0x23,	0x69,	
+0x6e,	0x63,	0x6c,	0x75,	0x64,	0x65,	0x20,	0x3c,	0x63,	0x6d,	
+0x61,	0x74,	0x68,	0x3e,	0xa,	0x23,	0x69,	0x6e,	0x63,	0x6c,	
+0x75,	0x64,	0x65,	0x20,	0x3c,	0x63,	0x73,	0x74,	0x64,	0x64,	
+0x65,	0x66,	0x3e,	0xa,	0x23,	0x69,	0x6e,	0x63,	0x6c,	0x75,	
+0x64,	0x65,	0x20,	0x3c,	0x74,	0x79,	0x70,	0x65,	0x5f,	0x74,	
+0x72,	0x61,	0x69,	0x74,	0x73,	0x3e,	0xa,	0xa,	0x23,	0x64,	
+0x65,	0x66,	0x69,	0x6e,	0x65,	0x20,	0x5f,	0x5f,	0x6b,	0x65,	
+0x72,	0x6e,	0x65,	0x6c,	0x20,	0x73,	0x74,	0x61,	0x74,	0x69,	
+0x63,	0xa,	0x23,	0x64,	0x65,	0x66,	0x69,	0x6e,	0x65,	0x20,	
+0x5f,	0x5f,	0x67,	0x6c,	0x6f,	0x62,	0x61,	0x6c,	0xa,	0x23,	
+0x64,	0x65,	0x66,	0x69,	0x6e,	0x65,	0x20,	0x5f,	0x5f,	0x63,	
+0x6f,	0x6e,	0x73,	0x74,	0x61,	0x6e,	0x74,	0x20,	0x63,	0x6f,	
+0x6e,	0x73,	0x74,	0xa,	0x23,	0x64,	0x65,	0x66,	0x69,	0x6e,	
+0x65,	0x20,	0x5f,	0x5f,	0x70,	0x72,	0x69,	0x76,	0x61,	0x74,	
+0x65,	0xa,	0x23,	0x64,	0x65,	0x66,	0x69,	0x6e,	0x65,	0x20,	
+0x43,	0x4c,	0x4b,	0x5f,	0x4c,	0x4f,	0x43,	0x41,	0x4c,	0x5f,	
+0x4d,	0x45,	0x4d,	0x5f,	0x46,	0x45,	0x4e,	0x43,	0x45,	0x20,	
+0x31,	0xa,	0x23,	0x64,	0x65,	0x66,	0x69,	0x6e,	0x65,	0x20,	
+0x43,	0x4c,	0x4b,	0x5f,	0x47,	0x4c,	0x4f,	0x42,	0x41,	0x4c,	
+0x5f,	0x4d,	0x45,	0x4d,	0x5f,	0x46,	0x45,	0x4e,	0x43,	0x45,	
+0x20,	0x32,	0xa,	0xa,	0x74,	0x79,	0x70,	0x65,	0x64,	0x65,	
+0x66,	0x20,	0x75,	0x6e,	0x73,	0x69,	0x67,	0x6e,	0x65,	0x64,	
+0x20,	0x63,	0x68,	0x61,	0x72,	0x20,	0x75,	0x63,	0x68,	0x61,	
+0x72,	0x3b,	0xa,	0x74,	0x79,	0x70,	0x65,	0x64,	0x65,	0x66,	
+0x20,	0x75,	0x6e,	0x73,	0x69,	0x67,	0x6e,	0x65,	0x64,	0x20,	
+0x73,	0x68,	0x6f,	0x72,	0x74,	0x20,	0x75,	0x73,	0x68,	0x6f,	
+0x72,	0x74,	0x3b,	0xa,	0x74,	0x79,	0x70,	0x65,	0x64,	0x65,	
+0x66,	0x20,	0x75,	0x6e,	0x73,	0x69,	0x67,	0x6e,	0x65,	0x64,	
+0x20,	0x69,	0x6e,	0x74,	0x20,	0x75,	0x69,	0x6e,	0x74,	0x3b,	
+0xa,	0x74,	0x79,	0x70,	0x65,	0x64,	0x65,	0x66,	0x20,	0x75,	
+0x6e,	0x73,	0x69,	0x67,	0x6e,	0x65,	0x64,	0x20,	0x6c,	0x6f,	
+0x6e,	0x67,	0x20,	0x75,	0x6c,	0x6f,	0x6e,	0x67,	0x3b,	0xa,	
+0xa,	0x2f,	0x2a,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0xa,	0x20,	0x2a,	0x20,	0x57,	
+0x6f,	0x72,	0x6b,	0x2d,	0x69,	0x74,	0x65,	0x6d,	0x73,	0xa,	
+0x20,	0x2a,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2a,	0x2f,	0xa,	0xa,	0x73,	0x74,	0x72,	
+0x75,	0x63,	0x74,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	
+0x69,	0x74,	0x65,	0x6d,	0x5f,	0x74,	0xa,	0x7b,	0xa,	0x20,	
+0x20,	0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	0x20,	0x67,	0x6c,	
+0x6f,	0x62,	0x61,	0x6c,	0x5f,	0x69,	0x64,	0x5b,	0x33,	0x5d,	
+0x3b,	0xa,	0x20,	0x20,	0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	
+0x20,	0x6c,	0x6f,	0x63,	0x61,	0x6c,	0x5f,	0x69,	0x64,	0x5b,	
+0x33,	0x5d,	0x3b,	0xa,	0x20,	0x20,	0x73,	0x69,	0x7a,	0x65,	
+0x5f,	0x74,	0x20,	0x67,	0x72,	0x6f,	0x75,	0x70,	0x5f,	0x69,	
+0x64,	0x5b,	0x33,	0x5d,	0x3b,	0xa,	0x20,	0x20,	0x73,	0x69,	
+0x7a,	0x65,	0x5f,	0x74,	0x20,	0x67,	0x6c,	0x6f,	0x62,	0x61,	
+0x6c,	0x5f,	0x73,	0x69,	0x7a,	0x65,	0x5b,	0x33,	0x5d,	0x3b,	
+0xa,	0x20,	0x20,	0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	0x20,	
+0x6c,	0x6f,	0x63,	0x61,	0x6c,	0x5f,	0x73,	0x69,	0x7a,	0x65,	
+0x5b,	0x33,	0x5d,	0x3b,	0xa,	0x20,	0x20,	0x73,	0x69,	0x7a,	
+0x65,	0x5f,	0x74,	0x20,	0x6e,	0x75,	0x6d,	0x5f,	0x67,	0x72,	
+0x6f,	0x75,	0x70,	0x73,	0x5b,	0x33,	0x5d,	0x3b,	0xa,	0x20,	
+0x20,	0x76,	0x6f,	0x69,	0x64,	0x20,	0x28,	0x2a,	0x62,	0x61,	
+0x72,	0x72,	0x69,	0x65,	0x72,	0x29,	0x28,	0x29,	0x3b,	0xa,	
+0x7d,	0x3b,	0xa,	0xa,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	
+0x20,	0x74,	0x68,	0x72,	0x65,	0x61,	0x64,	0x5f,	0x6c,	0x6f,	
+0x63,	0x61,	0x6c,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	
+0x69,	0x74,	0x65,	0x6d,	0x5f,	0x74,	0x20,	0x63,	0x6f,	0x6e,	
+0x73,	0x74,	0x20,	0x2a,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	
+0x5f,	0x69,	0x74,	0x65,	0x6d,	0x3b,	0xa,	0xa,	0x73,	0x74,	
+0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	
+0x65,	0x20,	0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	0x20,	0x67,	
+0x65,	0x74,	0x5f,	0x67,	0x6c,	0x6f,	0x62,	0x61,	0x6c,	0x5f,	
+0x69,	0x64,	0x28,	0x75,	0x69,	0x6e,	0x74,	0x20,	0x64,	0x29,	
+0x20,	0x7b,	0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	
+0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	0x74,	0x65,	0x6d,	
+0x2d,	0x3e,	0x67,	0x6c,	0x6f,	0x62,	0x61,	0x6c,	0x5f,	0x69,	
+0x64,	0x5b,	0x64,	0x5d,	0x3b,	0x20,	0x7d,	0xa,	0x73,	0x74,	
+0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	
+0x65,	0x20,	0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	0x20,	0x67,	
+0x65,	0x74,	0x5f,	0x6c,	0x6f,	0x63,	0x61,	0x6c,	0x5f,	0x69,	
+0x64,	0x28,	0x75,	0x69,	0x6e,	0x74,	0x20,	0x64,	0x29,	0x20,	
+0x7b,	0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x69,	
+0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	0x74,	0x65,	0x6d,	0x2d,	
+0x3e,	0x6c,	0x6f,	0x63,	0x61,	0x6c,	0x5f,	0x69,	0x64,	0x5b,	
+0x64,	0x5d,	0x3b,	0x20,	0x7d,	0xa,	0x73,	0x74,	0x61,	0x74,	
+0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	0x65,	0x20,	
+0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	0x20,	0x67,	0x65,	0x74,	
+0x5f,	0x67,	0x72,	0x6f,	0x75,	0x70,	0x5f,	0x69,	0x64,	0x28,	
+0x75,	0x69,	0x6e,	0x74,	0x20,	0x64,	0x29,	0x20,	0x7b,	0x20,	
+0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x69,	0x73,	0x61,	
+0x61,	0x63,	0x5f,	0x69,	0x74,	0x65,	0x6d,	0x2d,	0x3e,	0x67,	
+0x72,	0x6f,	0x75,	0x70,	0x5f,	0x69,	0x64,	0x5b,	0x64,	0x5d,	
+0x3b,	0x20,	0x7d,	0xa,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	
+0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	0x65,	0x20,	0x73,	0x69,	
+0x7a,	0x65,	0x5f,	0x74,	0x20,	0x67,	0x65,	0x74,	0x5f,	0x67,	
+0x6c,	0x6f,	0x62,	0x61,	0x6c,	0x5f,	0x73,	0x69,	0x7a,	0x65,	
+0x28,	0x75,	0x69,	0x6e,	0x74,	0x20,	0x64,	0x29,	0x20,	0x7b,	
+0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x69,	0x73,	
+0x61,	0x61,	0x63,	0x5f,	0x69,	0x74,	0x65,	0x6d,	0x2d,	0x3e,	
+0x67,	0x6c,	0x6f,	0x62,	0x61,	0x6c,	0x5f,	0x73,	0x69,	0x7a,	
+0x65,	0x5b,	0x64,	0x5d,	0x3b,	0x20,	0x7d,	0xa,	0x73,	0x74,	
+0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	
+0x65,	0x20,	0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	0x20,	0x67,	
+0x65,	0x74,	0x5f,	0x6c,	0x6f,	0x63,	0x61,	0x6c,	0x5f,	0x73,	
+0x69,	0x7a,	0x65,	0x28,	0x75,	0x69,	0x6e,	0x74,	0x20,	0x64,	
+0x29,	0x20,	0x7b,	0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	
+0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	0x74,	0x65,	
+0x6d,	0x2d,	0x3e,	0x6c,	0x6f,	0x63,	0x61,	0x6c,	0x5f,	0x73,	
+0x69,	0x7a,	0x65,	0x5b,	0x64,	0x5d,	0x3b,	0x20,	0x7d,	0xa,	
+0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	
+0x69,	0x6e,	0x65,	0x20,	0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	
+0x20,	0x67,	0x65,	0x74,	0x5f,	0x6e,	0x75,	0x6d,	0x5f,	0x67,	
+0x72,	0x6f,	0x75,	0x70,	0x73,	0x28,	0x75,	0x69,	0x6e,	0x74,	
+0x20,	0x64,	0x29,	0x20,	0x7b,	0x20,	0x72,	0x65,	0x74,	0x75,	
+0x72,	0x6e,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	
+0x74,	0x65,	0x6d,	0x2d,	0x3e,	0x6e,	0x75,	0x6d,	0x5f,	0x67,	
+0x72,	0x6f,	0x75,	0x70,	0x73,	0x5b,	0x64,	0x5d,	0x3b,	0x20,	
+0x7d,	0xa,	0xa,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	
+0x69,	0x6e,	0x6c,	0x69,	0x6e,	0x65,	0x20,	0x76,	0x6f,	0x69,	
+0x64,	0x20,	0x62,	0x61,	0x72,	0x72,	0x69,	0x65,	0x72,	0x28,	
+0x69,	0x6e,	0x74,	0x29,	0xa,	0x7b,	0xa,	0x20,	0x20,	0x69,	
+0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	0x74,	0x65,	0x6d,	0x5f,	
+0x74,	0x20,	0x63,	0x6f,	0x6e,	0x73,	0x74,	0x20,	0x2a,	0x20,	
+0x73,	0x65,	0x6c,	0x66,	0x20,	0x3d,	0x20,	0x69,	0x73,	0x61,	
+0x61,	0x63,	0x5f,	0x69,	0x74,	0x65,	0x6d,	0x3b,	0xa,	0x20,	
+0x20,	0x73,	0x65,	0x6c,	0x66,	0x2d,	0x3e,	0x62,	0x61,	0x72,	
+0x72,	0x69,	0x65,	0x72,	0x28,	0x29,	0x3b,	0xa,	0x20,	0x20,	
+0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	0x74,	0x65,	0x6d,	
+0x20,	0x3d,	0x20,	0x73,	0x65,	0x6c,	0x66,	0x3b,	0xa,	0x7d,	
+0xa,	0xa,	0x2f,	0x2a,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0xa,	0x20,	0x2a,	0x20,	
+0x42,	0x75,	0x69,	0x6c,	0x74,	0x2d,	0x69,	0x6e,	0x20,	0x66,	
+0x75,	0x6e,	0x63,	0x74,	0x69,	0x6f,	0x6e,	0x73,	0xa,	0x20,	
+0x2a,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2a,	0x2f,	0xa,	0xa,	0x75,	0x73,	0x69,	0x6e,	
+0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x61,	0x62,	0x73,	
+0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	0x74,	
+0x64,	0x3a,	0x3a,	0x61,	0x63,	0x6f,	0x73,	0x3b,	0x20,	0x75,	
+0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	
+0x61,	0x73,	0x69,	0x6e,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	
+0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x61,	0x74,	0x61,	
+0x6e,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	
+0x74,	0x64,	0x3a,	0x3a,	0x63,	0x65,	0x69,	0x6c,	0x3b,	0x20,	
+0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	
+0x3a,	0x63,	0x6f,	0x73,	0x3b,	0xa,	0x75,	0x73,	0x69,	0x6e,	
+0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x63,	0x6f,	0x73,	
+0x68,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	
+0x74,	0x64,	0x3a,	0x3a,	0x65,	0x78,	0x70,	0x3b,	0x20,	0x75,	
+0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	
+0x66,	0x61,	0x62,	0x73,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	
+0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x66,	0x6c,	0x6f,	
+0x6f,	0x72,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	
+0x73,	0x74,	0x64,	0x3a,	0x3a,	0x66,	0x6d,	0x61,	0x78,	0x3b,	
+0x20,	0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	0x74,	0x64,	
+0x3a,	0x3a,	0x66,	0x6d,	0x69,	0x6e,	0x3b,	0xa,	0x75,	0x73,	
+0x69,	0x6e,	0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x6c,	
+0x6f,	0x67,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	
+0x73,	0x74,	0x64,	0x3a,	0x3a,	0x70,	0x6f,	0x77,	0x3b,	0x20,	
+0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	
+0x3a,	0x73,	0x69,	0x6e,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	
+0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x73,	0x69,	0x6e,	
+0x68,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	
+0x74,	0x64,	0x3a,	0x3a,	0x73,	0x71,	0x72,	0x74,	0x3b,	0x20,	
+0x75,	0x73,	0x69,	0x6e,	0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	
+0x3a,	0x74,	0x61,	0x6e,	0x3b,	0x20,	0x75,	0x73,	0x69,	0x6e,	
+0x67,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x74,	0x61,	0x6e,	
+0x68,	0x3b,	0xa,	0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	
+0x74,	0x65,	0x3c,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x54,	
+0x2c,	0x20,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x55,	0x3e,	
+0xa,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	
+0x6c,	0x69,	0x6e,	0x65,	0x20,	0x74,	0x79,	0x70,	0x65,	0x6e,	
+0x61,	0x6d,	0x65,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x63,	
+0x6f,	0x6d,	0x6d,	0x6f,	0x6e,	0x5f,	0x74,	0x79,	0x70,	0x65,	
+0x3c,	0x54,	0x2c,	0x20,	0x55,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	
+0x70,	0x65,	0x20,	0x6d,	0x69,	0x6e,	0x28,	0x54,	0x20,	0x61,	
+0x2c,	0x20,	0x55,	0x20,	0x62,	0x29,	0x20,	0x7b,	0x20,	0x72,	
+0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x28,	0x62,	0x20,	0x3c,	
+0x20,	0x61,	0x29,	0x3f,	0x62,	0x3a,	0x61,	0x3b,	0x20,	0x7d,	
+0xa,	0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	
+0x3c,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x54,	0x2c,	0x20,	
+0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x55,	0x3e,	0xa,	0x73,	
+0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	
+0x6e,	0x65,	0x20,	0x74,	0x79,	0x70,	0x65,	0x6e,	0x61,	0x6d,	
+0x65,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x63,	0x6f,	0x6d,	
+0x6d,	0x6f,	0x6e,	0x5f,	0x74,	0x79,	0x70,	0x65,	0x3c,	0x54,	
+0x2c,	0x20,	0x55,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	0x70,	0x65,	
+0x20,	0x6d,	0x61,	0x78,	0x28,	0x54,	0x20,	0x61,	0x2c,	0x20,	
+0x55,	0x20,	0x62,	0x29,	0x20,	0x7b,	0x20,	0x72,	0x65,	0x74,	
+0x75,	0x72,	0x6e,	0x20,	0x28,	0x61,	0x20,	0x3c,	0x20,	0x62,	
+0x29,	0x3f,	0x62,	0x3a,	0x61,	0x3b,	0x20,	0x7d,	0xa,	0xa,	
+0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	0x3c,	0x63,	
+0x6c,	0x61,	0x73,	0x73,	0x20,	0x41,	0x2c,	0x20,	0x63,	0x6c,	
+0x61,	0x73,	0x73,	0x20,	0x42,	0x2c,	0x20,	0x63,	0x6c,	0x61,	
+0x73,	0x73,	0x20,	0x43,	0x3e,	0xa,	0x73,	0x74,	0x61,	0x74,	
+0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	0x65,	0x20,	
+0x74,	0x79,	0x70,	0x65,	0x6e,	0x61,	0x6d,	0x65,	0x20,	0x73,	
+0x74,	0x64,	0x3a,	0x3a,	0x63,	0x6f,	0x6d,	0x6d,	0x6f,	0x6e,	
+0x5f,	0x74,	0x79,	0x70,	0x65,	0x3c,	0x41,	0x2c,	0x20,	0x42,	
+0x2c,	0x20,	0x43,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	0x70,	0x65,	
+0x20,	0x6d,	0x61,	0x64,	0x28,	0x41,	0x20,	0x61,	0x2c,	0x20,	
+0x42,	0x20,	0x62,	0x2c,	0x20,	0x43,	0x20,	0x63,	0x29,	0x20,	
+0x7b,	0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x61,	
+0x2a,	0x62,	0x20,	0x2b,	0x20,	0x63,	0x3b,	0x20,	0x7d,	0xa,	
+0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	0x3c,	
+0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x41,	0x2c,	0x20,	0x63,	
+0x6c,	0x61,	0x73,	0x73,	0x20,	0x42,	0x2c,	0x20,	0x63,	0x6c,	
+0x61,	0x73,	0x73,	0x20,	0x43,	0x3e,	0xa,	0x73,	0x74,	0x61,	
+0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	0x65,	
+0x20,	0x74,	0x79,	0x70,	0x65,	0x6e,	0x61,	0x6d,	0x65,	0x20,	
+0x73,	0x74,	0x64,	0x3a,	0x3a,	0x63,	0x6f,	0x6d,	0x6d,	0x6f,	
+0x6e,	0x5f,	0x74,	0x79,	0x70,	0x65,	0x3c,	0x41,	0x2c,	0x20,	
+0x42,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	0x70,	0x65,	0x20,	0x73,	
+0x65,	0x6c,	0x65,	0x63,	0x74,	0x28,	0x41,	0x20,	0x61,	0x2c,	
+0x20,	0x42,	0x20,	0x62,	0x2c,	0x20,	0x43,	0x20,	0x63,	0x29,	
+0x20,	0x7b,	0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	
+0x63,	0x20,	0x3f,	0x20,	0x62,	0x20,	0x3a,	0x20,	0x61,	0x3b,	
+0x20,	0x7d,	0xa,	0xa,	0x2f,	0x2a,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0xa,	0x20,	
+0x2a,	0x20,	0x56,	0x65,	0x63,	0x74,	0x6f,	0x72,	0x20,	0x74,	
+0x79,	0x70,	0x65,	0x73,	0xa,	0x20,	0x2a,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	
+0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2d,	0x2a,	0x2f,	
+0xa,	0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	
+0x3c,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x54,	0x3e,	0xa,	
+0x73,	0x74,	0x72,	0x75,	0x63,	0x74,	0x20,	0x69,	0x73,	0x61,	
+0x61,	0x63,	0x5f,	0x76,	0x65,	0x63,	0x32,	0xa,	0x7b,	0xa,	
+0x20,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	0x65,	
+0x63,	0x32,	0x28,	0x29,	0x20,	0x7b,	0x7d,	0xa,	0x20,	0x20,	
+0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	0x65,	0x63,	0x32,	
+0x28,	0x54,	0x20,	0x73,	0x29,	0x20,	0x3a,	0x20,	0x78,	0x28,	
+0x73,	0x29,	0x2c,	0x20,	0x79,	0x28,	0x73,	0x29,	0x20,	0x7b,	
+0x7d,	0xa,	0x20,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	
+0x76,	0x65,	0x63,	0x32,	0x28,	0x54,	0x20,	0x5f,	0x78,	0x2c,	
+0x20,	0x54,	0x20,	0x5f,	0x79,	0x29,	0x20,	0x3a,	0x20,	0x78,	
+0x28,	0x5f,	0x78,	0x29,	0x2c,	0x20,	0x79,	0x28,	0x5f,	0x79,	
+0x29,	0x20,	0x7b,	0x7d,	0xa,	0x20,	0x20,	0x54,	0x20,	0x26,	
+0x20,	0x6f,	0x70,	0x65,	0x72,	0x61,	0x74,	0x6f,	0x72,	0x5b,	
+0x5d,	0x28,	0x69,	0x6e,	0x74,	0x20,	0x69,	0x29,	0x20,	0x7b,	
+0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x28,	0x26,	
+0x78,	0x29,	0x5b,	0x69,	0x5d,	0x3b,	0x20,	0x7d,	0xa,	0x20,	
+0x20,	0x54,	0x20,	0x63,	0x6f,	0x6e,	0x73,	0x74,	0x20,	0x26,	
+0x20,	0x6f,	0x70,	0x65,	0x72,	0x61,	0x74,	0x6f,	0x72,	0x5b,	
+0x5d,	0x28,	0x69,	0x6e,	0x74,	0x20,	0x69,	0x29,	0x20,	0x63,	
+0x6f,	0x6e,	0x73,	0x74,	0x20,	0x7b,	0x20,	0x72,	0x65,	0x74,	
+0x75,	0x72,	0x6e,	0x20,	0x28,	0x26,	0x78,	0x29,	0x5b,	0x69,	
+0x5d,	0x3b,	0x20,	0x7d,	0xa,	0x20,	0x20,	0x73,	0x74,	0x61,	
+0x74,	0x69,	0x63,	0x20,	0x63,	0x6f,	0x6e,	0x73,	0x74,	0x20,	
+0x69,	0x6e,	0x74,	0x20,	0x73,	0x69,	0x7a,	0x65,	0x20,	0x3d,	
+0x20,	0x32,	0x3b,	0xa,	0x20,	0x20,	0x54,	0x20,	0x78,	0x2c,	
+0x20,	0x79,	0x3b,	0xa,	0x7d,	0x3b,	0xa,	0xa,	0x74,	0x65,	
+0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	0x3c,	0x63,	0x6c,	0x61,	
+0x73,	0x73,	0x20,	0x54,	0x3e,	0xa,	0x73,	0x74,	0x72,	0x75,	
+0x63,	0x74,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	
+0x65,	0x63,	0x34,	0xa,	0x7b,	0xa,	0x20,	0x20,	0x69,	0x73,	
+0x61,	0x61,	0x63,	0x5f,	0x76,	0x65,	0x63,	0x34,	0x28,	0x29,	
+0x20,	0x7b,	0x7d,	0xa,	0x20,	0x20,	0x69,	0x73,	0x61,	0x61,	
+0x63,	0x5f,	0x76,	0x65,	0x63,	0x34,	0x28,	0x54,	0x20,	0x73,	
+0x29,	0x20,	0x3a,	0x20,	0x78,	0x28,	0x73,	0x29,	0x2c,	0x20,	
+0x79,	0x28,	0x73,	0x29,	0x2c,	0x20,	0x7a,	0x28,	0x73,	0x29,	
+0x2c,	0x20,	0x77,	0x28,	0x73,	0x29,	0x20,	0x7b,	0x7d,	0xa,	
+0x20,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	0x65,	
+0x63,	0x34,	0x28,	0x54,	0x20,	0x5f,	0x78,	0x2c,	0x20,	0x54,	
+0x20,	0x5f,	0x79,	0x2c,	0x20,	0x54,	0x20,	0x5f,	0x7a,	0x2c,	
+0x20,	0x54,	0x20,	0x5f,	0x77,	0x29,	0x20,	0x3a,	0x20,	0x78,	
+0x28,	0x5f,	0x78,	0x29,	0x2c,	0x20,	0x79,	0x28,	0x5f,	0x79,	
+0x29,	0x2c,	0x20,	0x7a,	0x28,	0x5f,	0x7a,	0x29,	0x2c,	0x20,	
+0x77,	0x28,	0x5f,	0x77,	0x29,	0x20,	0x7b,	0x7d,	0xa,	0x20,	
+0x20,	0x54,	0x20,	0x26,	0x20,	0x6f,	0x70,	0x65,	0x72,	0x61,	
+0x74,	0x6f,	0x72,	0x5b,	0x5d,	0x28,	0x69,	0x6e,	0x74,	0x20,	
+0x69,	0x29,	0x20,	0x7b,	0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	
+0x6e,	0x20,	0x28,	0x26,	0x78,	0x29,	0x5b,	0x69,	0x5d,	0x3b,	
+0x20,	0x7d,	0xa,	0x20,	0x20,	0x54,	0x20,	0x63,	0x6f,	0x6e,	
+0x73,	0x74,	0x20,	0x26,	0x20,	0x6f,	0x70,	0x65,	0x72,	0x61,	
+0x74,	0x6f,	0x72,	0x5b,	0x5d,	0x28,	0x69,	0x6e,	0x74,	0x20,	
+0x69,	0x29,	0x20,	0x63,	0x6f,	0x6e,	0x73,	0x74,	0x20,	0x7b,	
+0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x28,	0x26,	
+0x78,	0x29,	0x5b,	0x69,	0x5d,	0x3b,	0x20,	0x7d,	0xa,	0x20,	
+0x20,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x63,	0x6f,	
+0x6e,	0x73,	0x74,	0x20,	0x69,	0x6e,	0x74,	0x20,	0x73,	0x69,	
+0x7a,	0x65,	0x20,	0x3d,	0x20,	0x34,	0x3b,	0xa,	0x20,	0x20,	
+0x54,	0x20,	0x78,	0x2c,	0x20,	0x79,	0x2c,	0x20,	0x7a,	0x2c,	
+0x20,	0x77,	0x3b,	0xa,	0x7d,	0x3b,	0xa,	0xa,	0x74,	0x65,	
+0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	0x3c,	0x63,	0x6c,	0x61,	
+0x73,	0x73,	0x20,	0x56,	0x3e,	0x20,	0x73,	0x74,	0x72,	0x75,	
+0x63,	0x74,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	
+0x73,	0x5f,	0x76,	0x65,	0x63,	0x20,	0x7b,	0x20,	0x73,	0x74,	
+0x61,	0x74,	0x69,	0x63,	0x20,	0x63,	0x6f,	0x6e,	0x73,	0x74,	
+0x20,	0x62,	0x6f,	0x6f,	0x6c,	0x20,	0x76,	0x61,	0x6c,	0x75,	
+0x65,	0x20,	0x3d,	0x20,	0x66,	0x61,	0x6c,	0x73,	0x65,	0x3b,	
+0x20,	0x7d,	0x3b,	0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	
+0x74,	0x65,	0x3c,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x54,	
+0x3e,	0x20,	0x73,	0x74,	0x72,	0x75,	0x63,	0x74,	0x20,	0x69,	
+0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	0x73,	0x5f,	0x76,	0x65,	
+0x63,	0x3c,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	0x65,	
+0x63,	0x32,	0x3c,	0x54,	0x3e,	0x20,	0x3e,	0x20,	0x7b,	0x20,	
+0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x63,	0x6f,	0x6e,	
+0x73,	0x74,	0x20,	0x62,	0x6f,	0x6f,	0x6c,	0x20,	0x76,	0x61,	
+0x6c,	0x75,	0x65,	0x20,	0x3d,	0x20,	0x74,	0x72,	0x75,	0x65,	
+0x3b,	0x20,	0x7d,	0x3b,	0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	
+0x61,	0x74,	0x65,	0x3c,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	
+0x54,	0x3e,	0x20,	0x73,	0x74,	0x72,	0x75,	0x63,	0x74,	0x20,	
+0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	0x73,	0x5f,	0x76,	
+0x65,	0x63,	0x3c,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	
+0x65,	0x63,	0x34,	0x3c,	0x54,	0x3e,	0x20,	0x3e,	0x20,	0x7b,	
+0x20,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x63,	0x6f,	
+0x6e,	0x73,	0x74,	0x20,	0x62,	0x6f,	0x6f,	0x6c,	0x20,	0x76,	
+0x61,	0x6c,	0x75,	0x65,	0x20,	0x3d,	0x20,	0x74,	0x72,	0x75,	
+0x65,	0x3b,	0x20,	0x7d,	0x3b,	0xa,	0xa,	0x2f,	0x2f,	0x43,	
+0x6f,	0x6d,	0x70,	0x6f,	0x6e,	0x65,	0x6e,	0x74,	0x2d,	0x77,	
+0x69,	0x73,	0x65,	0x20,	0x6f,	0x70,	0x65,	0x72,	0x61,	0x74,	
+0x6f,	0x72,	0x73,	0x2c,	0x20,	0x73,	0x63,	0x61,	0x6c,	0x61,	
+0x72,	0x73,	0x20,	0x61,	0x72,	0x65,	0x20,	0x62,	0x72,	0x6f,	
+0x61,	0x64,	0x63,	0x61,	0x73,	0x74,	0xa,	0x23,	0x64,	0x65,	
+0x66,	0x69,	0x6e,	0x65,	0x20,	0x49,	0x53,	0x41,	0x41,	0x43,	
+0x5f,	0x56,	0x45,	0x43,	0x5f,	0x4f,	0x50,	0x45,	0x52,	0x41,	
+0x54,	0x4f,	0x52,	0x28,	0x4f,	0x50,	0x29,	0x20,	0x5c,	0xa,	
+0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	0x3c,	0x63,	
+0x6c,	0x61,	0x73,	0x73,	0x20,	0x56,	0x3e,	0x20,	0x5c,	0xa,	
+0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	
+0x69,	0x6e,	0x65,	0x20,	0x74,	0x79,	0x70,	0x65,	0x6e,	0x61,	
+0x6d,	0x65,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x65,	0x6e,	
+0x61,	0x62,	0x6c,	0x65,	0x5f,	0x69,	0x66,	0x3c,	0x69,	0x73,	
+0x61,	0x61,	0x63,	0x5f,	0x69,	0x73,	0x5f,	0x76,	0x65,	0x63,	
+0x3c,	0x56,	0x3e,	0x3a,	0x3a,	0x76,	0x61,	0x6c,	0x75,	0x65,	
+0x2c,	0x20,	0x56,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	0x70,	0x65,	
+0x20,	0x6f,	0x70,	0x65,	0x72,	0x61,	0x74,	0x6f,	0x72,	0x20,	
+0x4f,	0x50,	0x28,	0x56,	0x20,	0x61,	0x2c,	0x20,	0x56,	0x20,	
+0x63,	0x6f,	0x6e,	0x73,	0x74,	0x20,	0x26,	0x20,	0x62,	0x29,	
+0x20,	0x5c,	0xa,	0x7b,	0x20,	0x66,	0x6f,	0x72,	0x28,	0x69,	
+0x6e,	0x74,	0x20,	0x69,	0x20,	0x3d,	0x20,	0x30,	0x20,	0x3b,	
+0x20,	0x69,	0x20,	0x3c,	0x20,	0x56,	0x3a,	0x3a,	0x73,	0x69,	
+0x7a,	0x65,	0x20,	0x3b,	0x20,	0x2b,	0x2b,	0x69,	0x29,	0x20,	
+0x61,	0x5b,	0x69,	0x5d,	0x20,	0x3d,	0x20,	0x61,	0x5b,	0x69,	
+0x5d,	0x20,	0x4f,	0x50,	0x20,	0x62,	0x5b,	0x69,	0x5d,	0x3b,	
+0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x61,	0x3b,	
+0x20,	0x7d,	0x20,	0x5c,	0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	
+0x61,	0x74,	0x65,	0x3c,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	
+0x56,	0x2c,	0x20,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x53,	
+0x3e,	0x20,	0x5c,	0xa,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	
+0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	0x65,	0x20,	0x74,	0x79,	
+0x70,	0x65,	0x6e,	0x61,	0x6d,	0x65,	0x20,	0x73,	0x74,	0x64,	
+0x3a,	0x3a,	0x65,	0x6e,	0x61,	0x62,	0x6c,	0x65,	0x5f,	0x69,	
+0x66,	0x3c,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x69,	0x73,	
+0x5f,	0x76,	0x65,	0x63,	0x3c,	0x56,	0x3e,	0x3a,	0x3a,	0x76,	
+0x61,	0x6c,	0x75,	0x65,	0x20,	0x26,	0x26,	0x20,	0x73,	0x74,	
+0x64,	0x3a,	0x3a,	0x69,	0x73,	0x5f,	0x61,	0x72,	0x69,	0x74,	
+0x68,	0x6d,	0x65,	0x74,	0x69,	0x63,	0x3c,	0x53,	0x3e,	0x3a,	
+0x3a,	0x76,	0x61,	0x6c,	0x75,	0x65,	0x2c,	0x20,	0x56,	0x3e,	
+0x3a,	0x3a,	0x74,	0x79,	0x70,	0x65,	0x20,	0x6f,	0x70,	0x65,	
+0x72,	0x61,	0x74,	0x6f,	0x72,	0x20,	0x4f,	0x50,	0x28,	0x56,	
+0x20,	0x61,	0x2c,	0x20,	0x53,	0x20,	0x62,	0x29,	0x20,	0x5c,	
+0xa,	0x7b,	0x20,	0x66,	0x6f,	0x72,	0x28,	0x69,	0x6e,	0x74,	
+0x20,	0x69,	0x20,	0x3d,	0x20,	0x30,	0x20,	0x3b,	0x20,	0x69,	
+0x20,	0x3c,	0x20,	0x56,	0x3a,	0x3a,	0x73,	0x69,	0x7a,	0x65,	
+0x20,	0x3b,	0x20,	0x2b,	0x2b,	0x69,	0x29,	0x20,	0x61,	0x5b,	
+0x69,	0x5d,	0x20,	0x3d,	0x20,	0x61,	0x5b,	0x69,	0x5d,	0x20,	
+0x4f,	0x50,	0x20,	0x62,	0x3b,	0x20,	0x72,	0x65,	0x74,	0x75,	
+0x72,	0x6e,	0x20,	0x61,	0x3b,	0x20,	0x7d,	0x20,	0x5c,	0xa,	
+0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	0x3c,	0x63,	
+0x6c,	0x61,	0x73,	0x73,	0x20,	0x56,	0x2c,	0x20,	0x63,	0x6c,	
+0x61,	0x73,	0x73,	0x20,	0x53,	0x3e,	0x20,	0x5c,	0xa,	0x73,	
+0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	
+0x6e,	0x65,	0x20,	0x74,	0x79,	0x70,	0x65,	0x6e,	0x61,	0x6d,	
+0x65,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x65,	0x6e,	0x61,	
+0x62,	0x6c,	0x65,	0x5f,	0x69,	0x66,	0x3c,	0x69,	0x73,	0x61,	
+0x61,	0x63,	0x5f,	0x69,	0x73,	0x5f,	0x76,	0x65,	0x63,	0x3c,	
+0x56,	0x3e,	0x3a,	0x3a,	0x76,	0x61,	0x6c,	0x75,	0x65,	0x20,	
+0x26,	0x26,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x69,	0x73,	
+0x5f,	0x61,	0x72,	0x69,	0x74,	0x68,	0x6d,	0x65,	0x74,	0x69,	
+0x63,	0x3c,	0x53,	0x3e,	0x3a,	0x3a,	0x76,	0x61,	0x6c,	0x75,	
+0x65,	0x2c,	0x20,	0x56,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	0x70,	
+0x65,	0x20,	0x6f,	0x70,	0x65,	0x72,	0x61,	0x74,	0x6f,	0x72,	
+0x20,	0x4f,	0x50,	0x28,	0x53,	0x20,	0x61,	0x2c,	0x20,	0x56,	
+0x20,	0x62,	0x29,	0x20,	0x5c,	0xa,	0x7b,	0x20,	0x66,	0x6f,	
+0x72,	0x28,	0x69,	0x6e,	0x74,	0x20,	0x69,	0x20,	0x3d,	0x20,	
+0x30,	0x20,	0x3b,	0x20,	0x69,	0x20,	0x3c,	0x20,	0x56,	0x3a,	
+0x3a,	0x73,	0x69,	0x7a,	0x65,	0x20,	0x3b,	0x20,	0x2b,	0x2b,	
+0x69,	0x29,	0x20,	0x62,	0x5b,	0x69,	0x5d,	0x20,	0x3d,	0x20,	
+0x61,	0x20,	0x4f,	0x50,	0x20,	0x62,	0x5b,	0x69,	0x5d,	0x3b,	
+0x20,	0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x62,	0x3b,	
+0x20,	0x7d,	0xa,	0xa,	0x49,	0x53,	0x41,	0x41,	0x43,	0x5f,	
+0x56,	0x45,	0x43,	0x5f,	0x4f,	0x50,	0x45,	0x52,	0x41,	0x54,	
+0x4f,	0x52,	0x28,	0x2b,	0x29,	0xa,	0x49,	0x53,	0x41,	0x41,	
+0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	0x4f,	0x50,	0x45,	0x52,	
+0x41,	0x54,	0x4f,	0x52,	0x28,	0x2d,	0x29,	0xa,	0x49,	0x53,	
+0x41,	0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	0x4f,	0x50,	
+0x45,	0x52,	0x41,	0x54,	0x4f,	0x52,	0x28,	0x2a,	0x29,	0xa,	
+0x49,	0x53,	0x41,	0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	
+0x4f,	0x50,	0x45,	0x52,	0x41,	0x54,	0x4f,	0x52,	0x28,	0x2f,	
+0x29,	0xa,	0xa,	0x23,	0x75,	0x6e,	0x64,	0x65,	0x66,	0x20,	
+0x49,	0x53,	0x41,	0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	
+0x4f,	0x50,	0x45,	0x52,	0x41,	0x54,	0x4f,	0x52,	0xa,	0xa,	
+0x23,	0x64,	0x65,	0x66,	0x69,	0x6e,	0x65,	0x20,	0x49,	0x53,	
+0x41,	0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	0x54,	0x59,	
+0x50,	0x45,	0x53,	0x28,	0x54,	0x29,	0x20,	0x5c,	0xa,	0x74,	
+0x79,	0x70,	0x65,	0x64,	0x65,	0x66,	0x20,	0x69,	0x73,	0x61,	
+0x61,	0x63,	0x5f,	0x76,	0x65,	0x63,	0x32,	0x3c,	0x54,	0x3e,	
+0x20,	0x54,	0x20,	0x23,	0x23,	0x20,	0x32,	0x3b,	0x20,	0x5c,	
+0xa,	0x74,	0x79,	0x70,	0x65,	0x64,	0x65,	0x66,	0x20,	0x69,	
+0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	0x65,	0x63,	0x34,	0x3c,	
+0x54,	0x3e,	0x20,	0x54,	0x20,	0x23,	0x23,	0x20,	0x34,	0x3b,	
+0xa,	0xa,	0x49,	0x53,	0x41,	0x41,	0x43,	0x5f,	0x56,	0x45,	
+0x43,	0x5f,	0x54,	0x59,	0x50,	0x45,	0x53,	0x28,	0x63,	0x68,	
+0x61,	0x72,	0x29,	0xa,	0x49,	0x53,	0x41,	0x41,	0x43,	0x5f,	
+0x56,	0x45,	0x43,	0x5f,	0x54,	0x59,	0x50,	0x45,	0x53,	0x28,	
+0x75,	0x63,	0x68,	0x61,	0x72,	0x29,	0xa,	0x49,	0x53,	0x41,	
+0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	0x54,	0x59,	0x50,	
+0x45,	0x53,	0x28,	0x73,	0x68,	0x6f,	0x72,	0x74,	0x29,	0xa,	
+0x49,	0x53,	0x41,	0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	
+0x54,	0x59,	0x50,	0x45,	0x53,	0x28,	0x75,	0x73,	0x68,	0x6f,	
+0x72,	0x74,	0x29,	0xa,	0x49,	0x53,	0x41,	0x41,	0x43,	0x5f,	
+0x56,	0x45,	0x43,	0x5f,	0x54,	0x59,	0x50,	0x45,	0x53,	0x28,	
+0x69,	0x6e,	0x74,	0x29,	0xa,	0x49,	0x53,	0x41,	0x41,	0x43,	
+0x5f,	0x56,	0x45,	0x43,	0x5f,	0x54,	0x59,	0x50,	0x45,	0x53,	
+0x28,	0x75,	0x69,	0x6e,	0x74,	0x29,	0xa,	0x49,	0x53,	0x41,	
+0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	0x54,	0x59,	0x50,	
+0x45,	0x53,	0x28,	0x6c,	0x6f,	0x6e,	0x67,	0x29,	0xa,	0x49,	
+0x53,	0x41,	0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	0x54,	
+0x59,	0x50,	0x45,	0x53,	0x28,	0x75,	0x6c,	0x6f,	0x6e,	0x67,	
+0x29,	0xa,	0x49,	0x53,	0x41,	0x41,	0x43,	0x5f,	0x56,	0x45,	
+0x43,	0x5f,	0x54,	0x59,	0x50,	0x45,	0x53,	0x28,	0x66,	0x6c,	
+0x6f,	0x61,	0x74,	0x29,	0xa,	0x49,	0x53,	0x41,	0x41,	0x43,	
+0x5f,	0x56,	0x45,	0x43,	0x5f,	0x54,	0x59,	0x50,	0x45,	0x53,	
+0x28,	0x64,	0x6f,	0x75,	0x62,	0x6c,	0x65,	0x29,	0xa,	0xa,	
+0x23,	0x75,	0x6e,	0x64,	0x65,	0x66,	0x20,	0x49,	0x53,	0x41,	
+0x41,	0x43,	0x5f,	0x56,	0x45,	0x43,	0x5f,	0x54,	0x59,	0x50,	
+0x45,	0x53,	0xa,	0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	
+0x74,	0x65,	0x3c,	0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x54,	
+0x3e,	0xa,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	
+0x6e,	0x6c,	0x69,	0x6e,	0x65,	0x20,	0x69,	0x73,	0x61,	0x61,	
+0x63,	0x5f,	0x76,	0x65,	0x63,	0x32,	0x3c,	0x74,	0x79,	0x70,	
+0x65,	0x6e,	0x61,	0x6d,	0x65,	0x20,	0x73,	0x74,	0x64,	0x3a,	
+0x3a,	0x72,	0x65,	0x6d,	0x6f,	0x76,	0x65,	0x5f,	0x63,	0x6f,	
+0x6e,	0x73,	0x74,	0x3c,	0x54,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	
+0x70,	0x65,	0x3e,	0x20,	0x76,	0x6c,	0x6f,	0x61,	0x64,	0x32,	
+0x28,	0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	0x20,	0x6f,	0x66,	
+0x66,	0x73,	0x65,	0x74,	0x2c,	0x20,	0x54,	0x20,	0x2a,	0x20,	
+0x70,	0x29,	0xa,	0x7b,	0x20,	0x70,	0x20,	0x2b,	0x3d,	0x20,	
+0x32,	0x2a,	0x6f,	0x66,	0x66,	0x73,	0x65,	0x74,	0x3b,	0x20,	
+0x72,	0x65,	0x74,	0x75,	0x72,	0x6e,	0x20,	0x69,	0x73,	0x61,	
+0x61,	0x63,	0x5f,	0x76,	0x65,	0x63,	0x32,	0x3c,	0x74,	0x79,	
+0x70,	0x65,	0x6e,	0x61,	0x6d,	0x65,	0x20,	0x73,	0x74,	0x64,	
+0x3a,	0x3a,	0x72,	0x65,	0x6d,	0x6f,	0x76,	0x65,	0x5f,	0x63,	
+0x6f,	0x6e,	0x73,	0x74,	0x3c,	0x54,	0x3e,	0x3a,	0x3a,	0x74,	
+0x79,	0x70,	0x65,	0x3e,	0x28,	0x70,	0x5b,	0x30,	0x5d,	0x2c,	
+0x20,	0x70,	0x5b,	0x31,	0x5d,	0x29,	0x3b,	0x20,	0x7d,	0xa,	
+0xa,	0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	0x3c,	
+0x63,	0x6c,	0x61,	0x73,	0x73,	0x20,	0x54,	0x3e,	0xa,	0x73,	
+0x74,	0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	
+0x6e,	0x65,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	
+0x65,	0x63,	0x34,	0x3c,	0x74,	0x79,	0x70,	0x65,	0x6e,	0x61,	
+0x6d,	0x65,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x72,	0x65,	
+0x6d,	0x6f,	0x76,	0x65,	0x5f,	0x63,	0x6f,	0x6e,	0x73,	0x74,	
+0x3c,	0x54,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	0x70,	0x65,	0x3e,	
+0x20,	0x76,	0x6c,	0x6f,	0x61,	0x64,	0x34,	0x28,	0x73,	0x69,	
+0x7a,	0x65,	0x5f,	0x74,	0x20,	0x6f,	0x66,	0x66,	0x73,	0x65,	
+0x74,	0x2c,	0x20,	0x54,	0x20,	0x2a,	0x20,	0x70,	0x29,	0xa,	
+0x7b,	0x20,	0x70,	0x20,	0x2b,	0x3d,	0x20,	0x34,	0x2a,	0x6f,	
+0x66,	0x66,	0x73,	0x65,	0x74,	0x3b,	0x20,	0x72,	0x65,	0x74,	
+0x75,	0x72,	0x6e,	0x20,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	
+0x76,	0x65,	0x63,	0x34,	0x3c,	0x74,	0x79,	0x70,	0x65,	0x6e,	
+0x61,	0x6d,	0x65,	0x20,	0x73,	0x74,	0x64,	0x3a,	0x3a,	0x72,	
+0x65,	0x6d,	0x6f,	0x76,	0x65,	0x5f,	0x63,	0x6f,	0x6e,	0x73,	
+0x74,	0x3c,	0x54,	0x3e,	0x3a,	0x3a,	0x74,	0x79,	0x70,	0x65,	
+0x3e,	0x28,	0x70,	0x5b,	0x30,	0x5d,	0x2c,	0x20,	0x70,	0x5b,	
+0x31,	0x5d,	0x2c,	0x20,	0x70,	0x5b,	0x32,	0x5d,	0x2c,	0x20,	
+0x70,	0x5b,	0x33,	0x5d,	0x29,	0x3b,	0x20,	0x7d,	0xa,	0xa,	
+0x74,	0x65,	0x6d,	0x70,	0x6c,	0x61,	0x74,	0x65,	0x3c,	0x63,	
+0x6c,	0x61,	0x73,	0x73,	0x20,	0x54,	0x3e,	0xa,	0x73,	0x74,	
+0x61,	0x74,	0x69,	0x63,	0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	
+0x65,	0x20,	0x76,	0x6f,	0x69,	0x64,	0x20,	0x76,	0x73,	0x74,	
+0x6f,	0x72,	0x65,	0x32,	0x28,	0x69,	0x73,	0x61,	0x61,	0x63,	
+0x5f,	0x76,	0x65,	0x63,	0x32,	0x3c,	0x54,	0x3e,	0x20,	0x63,	
+0x6f,	0x6e,	0x73,	0x74,	0x20,	0x26,	0x20,	0x76,	0x2c,	0x20,	
+0x73,	0x69,	0x7a,	0x65,	0x5f,	0x74,	0x20,	0x6f,	0x66,	0x66,	
+0x73,	0x65,	0x74,	0x2c,	0x20,	0x54,	0x20,	0x2a,	0x20,	0x70,	
+0x29,	0xa,	0x7b,	0x20,	0x70,	0x20,	0x2b,	0x3d,	0x20,	0x32,	
+0x2a,	0x6f,	0x66,	0x66,	0x73,	0x65,	0x74,	0x3b,	0x20,	0x70,	
+0x5b,	0x30,	0x5d,	0x20,	0x3d,	0x20,	0x76,	0x2e,	0x78,	0x3b,	
+0x20,	0x70,	0x5b,	0x31,	0x5d,	0x20,	0x3d,	0x20,	0x76,	0x2e,	
+0x79,	0x3b,	0x20,	0x7d,	0xa,	0xa,	0x74,	0x65,	0x6d,	0x70,	
+0x6c,	0x61,	0x74,	0x65,	0x3c,	0x63,	0x6c,	0x61,	0x73,	0x73,	
+0x20,	0x54,	0x3e,	0xa,	0x73,	0x74,	0x61,	0x74,	0x69,	0x63,	
+0x20,	0x69,	0x6e,	0x6c,	0x69,	0x6e,	0x65,	0x20,	0x76,	0x6f,	
+0x69,	0x64,	0x20,	0x76,	0x73,	0x74,	0x6f,	0x72,	0x65,	0x34,	
+0x28,	0x69,	0x73,	0x61,	0x61,	0x63,	0x5f,	0x76,	0x65,	0x63,	
+0x34,	0x3c,	0x54,	0x3e,	0x20,	0x63,	0x6f,	0x6e,	0x73,	0x74,	
+0x20,	0x26,	0x20,	0x76,	0x2c,	0x20,	0x73,	0x69,	0x7a,	0x65,	
+0x5f,	0x74,	0x20,	0x6f,	0x66,	0x66,	0x73,	0x65,	0x74,	0x2c,	
+0x20,	0x54,	0x20,	0x2a,	0x20,	0x70,	0x29,	0xa,	0x7b,	0x20,	
+0x70,	0x20,	0x2b,	0x3d,	0x20,	0x34,	0x2a,	0x6f,	0x66,	0x66,	
+0x73,	0x65,	0x74,	0x3b,	0x20,	0x70,	0x5b,	0x30,	0x5d,	0x20,	
+0x3d,	0x20,	0x76,	0x2e,	0x78,	0x3b,	0x20,	0x70,	0x5b,	0x31,	
+0x5d,	0x20,	0x3d,	0x20,	0x76,	0x2e,	0x79,	0x3b,	0x20,	0x70,	
+0x5b,	0x32,	0x5d,	0x20,	0x3d,	0x20,	0x76,	0x2e,	0x7a,	0x3b,	
+0x20,	0x70,	0x5b,	0x33,	0x5d,	0x20,	0x3d,	0x20,	0x76,	0x2e,	
+0x77,	0x3b,	0x20,	0x7d,	0xa,	0xa,	};
+
+static const std::size_t opencl_len = 5306;
+
+}
+}
+}
@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <dlfcn.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "isaac/driver/host.h"
+#include "isaac/driver/recording.h"
+#include "isaac/tools/cpp/hash.hpp"
+#include "isaac/tools/cpp/string.hpp"
+#include "isaac/tools/sys/getenv.hpp"
+#include "isaac/tools/sys/thread_pool.hpp"
+
+#include "helpers/host/opencl.hpp"
+
+namespace isaac
+{
+namespace driver
+{
+
+namespace
+{
+
+//Must match isaac_item_t in helpers/host/opencl.h
+struct item_type
+{
+  size_t global_id[3];
+  size_t local_id[3];
+  size_t group_id[3];
+  size_t global_size[3];
+  size_t local_size[3];
+  size_t num_groups[3];
+  void (*barrier)();
+};
+
+typedef void (*entry_type)(void**, item_type const *);
+
+/*----------------------
+ * Translation
+ *---------------------*/
+
+bool is_identifier(char c)
+{ return std::isalnum((unsigned char)c) || c=='_'; }
+
+size_t skip_spaces(std::string const & str, size_t pos)
+{
+  while(pos < str.size() && std::isspace((unsigned char)str[pos]))
+    pos++;
+  return pos;
+}
+
+//__local pointers lose their qualifier, __local declarations become per-thread storage
+std::string rewrite_local(std::string const & source)
+{
+  static const std::string keyword = "__local";
+  std::string result;
+  size_t last = 0;
+  for(size_t pos = source.find(keyword) ; pos != std::string::npos ; pos = source.find(keyword, pos + keyword.size()))
+  {
+    if((pos > 0 && is_identifier(source[pos-1])) || is_identifier(source[pos + keyword.size()]))
+      continue;
+    size_t end = pos + keyword.size();
+    while(true)
+    {
+      size_t next = skip_spaces(source, end);
+      if(next==source.size() || !is_identifier(source[next]))
+        break;
+      while(next < source.size() && is_identifier(source[next]))
+        next++;
+      end = next;
+    }
+    bool pointer = skip_spaces(source, end) < source.size() && source[skip_spaces(source, end)]=='*';
+    result.append(source, last, pos - last);
+    result += pointer?"":"static thread_local";
+    last = pos + keyword.size();
+  }
+  result.append(source, last, std::string::npos);
+  return result;
+}
+
+//(float4)(x, y, z, w) -> float4(x, y, z, w)
+std::string rewrite_vector_literals(std::string const & source)
+{
+  static const char * types[] = {"char", "uchar", "short", "ushort", "int", "uint", "long", "ulong", "float", "double"};
+  std::string result;
+  size_t last = 0;
+  for(size_t pos = source.find('(') ; pos != std::string::npos ; pos = source.find('(', pos + 1))
+  {
+    size_t end = pos + 1;
+    while(end < source.size() && is_identifier(source[end]))
+      end++;
+    if(end==source.size() || source[end]!=')' || end - pos < 3)
+      continue;
+    std::string type = source.substr(pos + 1, end - pos - 2);
+    char width = source[end - 1];
+    if((width!='2' && width!='4') || std::find(std::begin(types), std::end(types), type)==std::end(types))
+      continue;
+    size_t next = skip_spaces(source, end + 1);
+    if(next==source.size() || source[next]!='(')
+      continue;
+    result.append(source, last, pos - last);
+    result += type + width;
+    last = next;
+  }
+  result.append(source, last, std::string::npos);
+  return result;
+}
+
+//Entry point of each kernel, with the arguments given as an array of pointers
+std::string entry_points(std::string const & source)
+{
+  static const std::string keyword = "__kernel";
+  std::ostringstream result;
+  for(size_t pos = source.find(keyword) ; pos != std::string::npos ; pos = source.find(keyword, pos + keyword.size()))
+  {
+    size_t begin = source.find('(', pos);
+    size_t end = source.find(')', begin);
+    if(begin==std::string::npos || end==std::string::npos)
+      throw std::runtime_error("Invalid kernel declaration");
+    size_t name_end = begin;
+    while(name_end > pos && !is_identifier(source[name_end - 1]))
+      name_end--;
+    size_t name_begin = name_end;
+    while(name_begin > pos && is_identifier(source[name_begin - 1]))
+      name_begin--;
+    std::string name = source.substr(name_begin, name_end - name_begin);
+    std::vector<std::string> parameters = tools::split(source.substr(begin + 1, end - begin - 1), ',');
+    result << "extern \"C\" void isaac_launch_" << name << "(void ** args, isaac_item_t const * item)" << std::endl;
+    result << "{" << std::endl;
+    result << "  isaac_item = item;" << std::endl;
+    result << "  " << name << "(";
+    size_t current = 0;
+    for(std::string const & parameter: parameters)
+    {
+      size_t last = parameter.find_last_not_of(" \t\n");
+      if(last==std::string::npos)
+        continue;
+      size_t first = last;
+      while(first > 0 && is_identifier(parameter[first - 1]))
+        first--;
+      std::string type = parameter.substr(0, first);
+      if(type.find_first_not_of(" \t\n")==std::string::npos)
+        continue;
+      result << (current>0?", ":"") << "*(" << type << "*)args[" << current << "]";
+      current++;
+    }
+    result << ");" << std::endl;
+    result << "}" << std::endl;
+  }
+  return result.str();
+}
+
+std::string translate(std::string const & source)
+{
+  std::string kernels = rewrite_vector_literals(rewrite_local(source));
+  std::string result(helpers::host::opencl, helpers::host::opencl_len);
+  result += "#line 1 \"kernels.cl\"\n";
+  result += kernels;
+  result += "\n";
+  result += entry_points(kernels);
+  result += "extern \"C\" const int isaac_barriers = " + tools::to_string((int)(source.find("barrier(")!=std::string::npos)) + ";\n";
+  return result;
+}
+
+//OpenCL build options to flags of the system compiler
+std::string flags(std::string const & options)
+{
+  std::string result = "-std=c++11 -O3 -fPIC -shared -w";
+  //Tuning for the host is only safe when the binary cache can tell hosts apart
+  if(host::target()!="generic")
+    result += " -march=native";
+  for(std::string const & option: tools::split(options, ' '))
+  {
+    if(option=="-cl-fast-relaxed-math") result += " -ffast-math";
+    if(option=="-cl-mad-enable") result += " -ffp-contract=fast";
+  }
+  return result;
+}
+
+/*----------------------
+ * Files
+ *---------------------*/
+
+//Scratch directory, removed with its content
+class scratch
+{
+public:
+  scratch()
+  {
+    std::string root = tools::getenv("TMPDIR");
+    std::string pattern = (root.empty()?std::string("/tmp"):root) + "/isaac-XXXXXX";
+    std::vector<char> buffer(pattern.begin(), pattern.end());
+    buffer.push_back('\0');
+    if(mkdtemp(buffer.data())==NULL)
+      throw std::runtime_error("ISAAC: unable to create a temporary directory");
+    path_ = buffer.data();
+  }
+
+  ~scratch()
+  {
+    for(std::string const & file: files_)
+      std::remove(file.c_str());
+    rmdir(path_.c_str());
+  }
+
+  std::string file(std::string const & name)
+  {
+    files_.push_back(path_ + "/" + name);
+    return files_.back();
+  }
+
+private:
+  std::string path_;
+  std::vector<std::string> files_;
+};
+
+std::vector<char> read(std::string const & path)
+{
+  std::ifstream file(path.c_str(), std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void write(std::string const & path, const char * data, size_t size)
+{
+  std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+  file.write(data, std::streamsize(size));
+}
+
+/*----------------------
+ * Execution
+ *---------------------*/
+
+tools::thread_pool & pool()
+{
+  static tools::thread_pool result(host::threads());
+  return result;
+}
+
+//Work-items of a group run as fibers on the worker's thread, switching at barriers
+struct worker_type
+{
+  static const size_t stack_size = 128*1024;
+  //Stacks kept between launches; larger work-groups allocate the rest for their launch only
+  static const size_t kept_stacks = 64;
+
+  ucontext_t scheduler;
+  std::vector<ucontext_t> contexts;
+  std::vector< std::unique_ptr<char[]> > stacks;
+  std::vector<item_type> items;
+  std::vector<char> done;
+  size_t current;
+  entry_type entry;
+  void ** arguments;
+};
+
+worker_type & worker()
+{
+  static thread_local worker_type result;
+  return result;
+}
+
+//Gives back the stacks of the fibers beyond kept_stacks
+void trim()
+{
+  worker_type & w = worker();
+  if(w.stacks.size() > worker_type::kept_stacks)
+    w.stacks.resize(worker_type::kept_stacks);
+}
+
+void yield()
+{
+  worker_type & w = worker();
+  swapcontext(&w.contexts[w.current], &w.scheduler);
+}
+
+void start()
+{
+  worker_type & w = worker();
+  w.entry(w.arguments, &w.items[w.current]);
+  w.done[w.current] = true;
+}
+
+struct launch_type
+{
+  entry_type entry;
+  void ** arguments;
+  bool barriers;
+  size_t global_size[3];
+  size_t local_size[3];
+  size_t num_groups[3];
+};
+
+void run_group(launch_type const & launch, size_t group)
+{
+  item_type item;
+  std::copy(launch.global_size, launch.global_size + 3, item.global_size);
+  std::copy(launch.local_size, launch.local_size + 3, item.local_size);
+  std::copy(launch.num_groups, launch.num_groups + 3, item.num_groups);
+  item.group_id[0] = group % launch.num_groups[0];
+  item.group_id[1] = (group / launch.num_groups[0]) % launch.num_groups[1];
+  item.group_id[2] = group / (launch.num_groups[0]*launch.num_groups[1]);
+  item.barrier = &yield;
+  size_t size = launch.local_size[0]*launch.local_size[1]*launch.local_size[2];
+  worker_type & w = worker();
+  if(launch.barriers)
+  {
+    w.items.resize(size);
+    w.contexts.resize(size);
+    w.done.assign(size, false);
+    while(w.stacks.size() < size)
+      w.stacks.emplace_back(new char[worker_type::stack_size]);
+    w.entry = launch.entry;
+    w.arguments = launch.arguments;
+  }
+  for(size_t i = 0 ; i < size ; ++i)
+  {
+    item.local_id[0] = i % launch.local_size[0];
+    item.local_id[1] = (i / launch.local_size[0]) % launch.local_size[1];
+    item.local_id[2] = i / (launch.local_size[0]*launch.local_size[1]);
+    for(unsigned int d = 0 ; d < 3 ; ++d)
+      item.global_id[d] = item.group_id[d]*launch.local_size[d] + item.local_id[d];
+    if(launch.barriers)
+    {
+      w.items[i] = item;
+      getcontext(&w.contexts[i]);
+      w.contexts[i].uc_stack.ss_sp = w.stacks[i].get();
+      w.contexts[i].uc_stack.ss_size = worker_type::stack_size;
+      w.contexts[i].uc_link = &w.scheduler;
+      makecontext(&w.contexts[i], &start, 0);
+    }
+    else
+      launch.entry(launch.arguments, &item);
+  }
+  //Round-robin from one barrier to the next
+  for(size_t remaining = launch.barriers?size:0 ; remaining > 0 ; )
+    for(w.current = 0 ; w.current < size ; ++w.current)
+      if(!w.done[w.current])
+      {
+        swapcontext(&w.scheduler, &w.contexts[w.current]);
+        remaining -= w.done[w.current];
+      }
+}
+
+bool & enabled_flag()
+{
+  static bool result = tools::getenv("ISAAC_BACKEND")=="host";
+  return result;
+}
+
+}
+
+host::module::module(std::string const & source, std::string const & options) : handle_(NULL), barriers_(false)
+{
+  scratch directory;
+  std::string src = directory.file("kernels.cpp");
+  std::string obj = directory.file("kernels.so");
+  std::string log = directory.file("build.log");
+  std::string code = translate(source);
+  write(src, code.data(), code.size());
+  std::string compiler = tools::getenv("ISAAC_HOST_COMPILER");
+  if(compiler.empty())
+    compiler = "c++";
+  std::string command = compiler + " " + flags(options) + " -o " + obj + " " + src + " > " + log + " 2>&1";
+  if(std::system(command.c_str())!=0)
+  {
+    std::vector<char> message = read(log);
+    throw std::runtime_error(command + "\n" + std::string(message.begin(), message.end()));
+  }
+  binary_ = read(obj);
+  load();
+}
+
+host::module::module(std::vector<char> const & binary) : binary_(binary), handle_(NULL), barriers_(false)
+{ load(); }
+
+host::module::~module()
+{
+  if(handle_)
+    dlclose(handle_);
+}
+
+void host::module::load()
+{
+  scratch directory;
+  std::string obj = directory.file("kernels.so");
+  write(obj, binary_.data(), binary_.size());
+  handle_ = dlopen(obj.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if(handle_==NULL)
+    throw std::runtime_error(std::string("ISAAC: unable to load kernels: ") + dlerror());
+  int const * barriers = (int const *)dlsym(handle_, "isaac_barriers");
+  barriers_ = barriers && *barriers;
+}
+
+std::vector<char> const & host::module::binary() const
+{ return binary_; }
+
+bool host::module::has(std::string const & name) const
+{ return dlsym(handle_, ("isaac_launch_" + name).c_str())!=NULL; }
+
+void host::module::launch(std::string const & name, std::vector<void*> const & arguments, unsigned int work_dim, const size_t * global, const size_t * local) const
+{
+  launch_type launch;
+  *reinterpret_cast<void**>(&launch.entry) = dlsym(handle_, ("isaac_launch_" + name).c_str());
+  if(launch.entry==NULL)
+    throw std::runtime_error("ISAAC: no kernel " + name);
+  launch.arguments = const_cast<void**>(arguments.data());
+  launch.barriers = barriers_;
+  size_t groups = 1;
+  for(unsigned int d = 0 ; d < 3 ; ++d)
+  {
+    launch.global_size[d] = (d < work_dim)?global[d]:1;
+    launch.local_size[d] = (d < work_dim && local)?local[d]:1;
+    launch.num_groups[d] = (launch.global_size[d] + launch.local_size[d] - 1)/launch.local_size[d];
+    groups *= launch.num_groups[d];
+  }
+  //Contiguous ranges of work-groups per thread
+  size_t nthreads = std::min<size_t>(threads(), groups);
+  std::vector< std::future<void> > futures;
+  for(size_t t = 0 ; t < nthreads ; ++t)
+  {
+    size_t begin = groups*t/nthreads, end = groups*(t + 1)/nthreads;
+    futures.push_back(pool().enqueue([launch, begin, end]{
+      for(size_t g = begin ; g < end ; ++g)
+        run_group(launch, g);
+      if(launch.barriers)
+        trim();
+    }));
+  }
+  for(std::future<void> & future: futures)
+    future.get();
+}
+
+void host::enable()
+{
+  enabled_flag() = true;
+  recording::enable();
+}
+
+bool host::enabled()
+{ return enabled_flag(); }
+
+unsigned int host::threads()
+{ return std::max(1u, std::thread::hardware_concurrency()); }
+
+std::string const & host::target()
+{
+  static const std::string result = []{
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while(std::getline(cpuinfo, line))
+      if(line.compare(0, 5, "flags")==0 || line.compare(0, 8, "Features")==0)
+        return "native-" + tools::to_string(tools::hash(line.substr(line.find(':') + 1)));
+    return std::string("generic");
+  }();
+  return result;
+}
+
+}
+}
@@ -21,7 +21,9 @@
 
 #include "isaac/driver/kernel.h"
 #include "isaac/driver/buffer.h"
+#include "isaac/exception/driver.h"
 #include "isaac/value_scalar.h"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 
@@ -31,13 +33,11 @@ namespace isaac
 namespace driver
 {
 
-Kernel::Kernel(Program const & program, const char * name) : backend_(program.backend_), address_bits_(program.context().device().address_bits()), h_(backend_, true)
+Kernel::Kernel(Program const & program, const char * name) : backend_(program.backend_), address_bits_(program.context().device().address_bits()), cu_nparams_(0), h_(backend_, true)
 {
   switch(backend_)
   {
     case CUDA:
-      cu_params_store_.reserve(64);
-      cu_params_.reserve(64);
       check(dispatch::cuModuleGetFunction(&h_.cu(), program.h_.cu(), name));\
       break;
     case OPENCL:
@@ -70,20 +70,32 @@ void Kernel::setArg(unsigned int index, value_scalar const & scal)
   }
 }
 
+//Arguments move to the heap once, when the inline buffer is outgrown
+char* Kernel::cu_data()
+{ return cu_heap_.empty()?cu_inline_:cu_heap_.data(); }
+
+char const * Kernel::cu_data() const
+{ return cu_heap_.empty()?cu_inline_:cu_heap_.data(); }
+
 void Kernel::setArg(unsigned int index, std::size_t size, void* ptr)
 {
   switch(backend_)
   {
     case CUDA:
-      if(index + 1> cu_params_store_.size())
+    {
+      if(size > cu_param_size)
+        throw exception::cuda::invalid_value();
+      std::size_t end = (index + 1)*cu_param_size;
+      if(end > cu_inline_size && end > cu_heap_.size())
       {
-        cu_params_store_.resize(index+1);
-        cu_params_.resize(index+1);
+        if(cu_heap_.empty())
+          cu_heap_.assign(cu_inline_, cu_inline_ + cu_inline_size);
+        cu_heap_.resize(std::max(end, 2*cu_heap_.size()));
       }
-      cu_params_store_[index].reset(malloc(size), free);
-      memcpy(cu_params_store_[index].get(), ptr, size);
-      cu_params_[index] = cu_params_store_[index].get();
+      memcpy(cu_data() + index*cu_param_size, ptr, size);
+      cu_nparams_ = std::max(cu_nparams_, index + 1);
       break;
+    }
     case OPENCL:
       check(dispatch::clSetKernelArg(h_.cl(), index, size, ptr));
       break;
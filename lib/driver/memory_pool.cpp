@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "isaac/driver/memory_pool.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/command_queue.h"
+#include "isaac/driver/event.h"
+
+namespace isaac
+{
+
+namespace driver
+{
+
+struct MemoryPool::slab_type
+{
+  slab_type(backend_type backend): h(backend, true), size(0), carved(0), used(0){}
+  Buffer::handle_type h;
+  size_t size;
+  //Blocks are carved out of the slab on demand
+  size_t carved;
+  size_t used;
+};
+
+struct MemoryPool::block_type
+{
+  block_type(backend_type backend): h(backend, backend==OPENCL), offset(0), size(0){}
+  std::shared_ptr<slab_type> slab;
+  Buffer::handle_type h;
+  size_t offset;
+  size_t size;
+  //Queues and commands that may still use the block (see backend::accesses::retire)
+  std::vector<CommandQueue> queues;
+  std::vector<std::pair<CommandQueue, Event> > events;
+};
+
+struct MemoryPool::state_type
+{
+  //Sub-buffers must start on the device's base address alignment
+  state_type(Context const & _context): context(_context), alignment(std::max<size_t>(256, context.device().mem_base_addr_align()))
+  { }
+
+  Context context;
+  size_t alignment;
+  std::mutex mutex;
+  std::map<size_t, std::list<std::shared_ptr<block_type> > > bins;
+  //Slabs of each size class that are not fully carved yet
+  std::map<size_t, std::list<std::shared_ptr<slab_type> > > open;
+  statistics_type statistics;
+};
+
+//Puts a block back into its bin, unless the pool is already gone
+struct MemoryPool::releaser
+{
+  releaser(std::shared_ptr<block_type> const & _block, std::weak_ptr<state_type> const & _state): block(_block), state(_state){}
+
+  void operator()(void*)
+  {
+    std::vector<CommandQueue> queues;
+    std::vector<std::pair<CommandQueue, Event> > events;
+    backend::accesses::retire(block->h.backend()==CUDA?(uintptr_t)block->h.cu():(uintptr_t)block->h.cl(), queues, events);
+    std::shared_ptr<state_type> pool = state.lock();
+    if(!pool)
+      return;
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    //Without recorded accesses, the block was only used by the queue it was handed to
+    if(queues.size() || events.size())
+    {
+      block->queues = queues;
+      block->events = events;
+    }
+    block->slab->used--;
+    pool->statistics.in_use -= block->size;
+    pool->bins[block->size].push_back(block);
+  }
+
+  std::shared_ptr<block_type> block;
+  std::weak_ptr<state_type> state;
+};
+
+MemoryPool::MemoryPool(Context const & context) : state_(new state_type(context))
+{ }
+
+size_t MemoryPool::size_class(size_t size) const
+{
+  //Four classes per power of two, aligned for sub-buffers
+  size_t power = 1;
+  while(power <= size/2)
+    power *= 2;
+  size_t step = std::max(power/4, state_->alignment);
+  return std::max((size + step - 1)/step*step, step);
+}
+
+void MemoryPool::trim(state_type & state)
+{
+  std::set<slab_type*> freed;
+  for(auto & bin: state.bins)
+    for(auto it = bin.second.begin() ; it != bin.second.end() ;)
+    {
+      if((*it)->slab->used==0)
+      {
+        freed.insert((*it)->slab.get());
+        it = bin.second.erase(it);
+      }
+      else
+        ++it;
+    }
+  for(auto & open: state.open)
+    for(auto it = open.second.begin() ; it != open.second.end() ;)
+    {
+      if((*it)->used==0)
+      {
+        freed.insert(it->get());
+        it = open.second.erase(it);
+      }
+      else
+        ++it;
+    }
+  for(slab_type * slab: freed)
+  {
+    state.statistics.reserved -= slab->size;
+    state.statistics.slabs--;
+  }
+}
+
+Buffer::handle_type MemoryPool::allocate(size_t size, CommandQueue & queue, std::shared_ptr<void> & owner)
+{
+  state_type & state = *state_;
+  size_t bytes = size_class(size);
+  std::unique_lock<std::mutex> lock(state.mutex);
+  std::list<std::shared_ptr<block_type> > & bin = state.bins[bytes];
+
+  //Prefers blocks that no other queue may still use
+  auto idle = [&](std::shared_ptr<block_type> const & x){
+    for(CommandQueue const & q: x->queues)
+      if(q!=queue) return false;
+    for(auto const & e: x->events)
+      if(e.first!=queue) return false;
+    return true;
+  };
+  auto it = std::find_if(bin.begin(), bin.end(), idle);
+  if(it==bin.end() && !bin.empty())
+    it = bin.begin();
+
+  std::shared_ptr<block_type> block;
+  if(it!=bin.end())
+  {
+    block = *it;
+    bin.erase(it);
+    state.statistics.hits++;
+    //Waits for the other queues without holding the pool
+    if(!idle(block))
+    {
+      lock.unlock();
+      for(CommandQueue & q: block->queues)
+        if(q!=queue)
+          q.synchronize();
+      for(auto const & e: block->events)
+        if(e.first!=queue)
+          e.second.synchronize();
+      lock.lock();
+    }
+  }
+  else
+  {
+    std::list<std::shared_ptr<slab_type> > & open = state.open[bytes];
+    if(open.empty())
+    {
+      std::shared_ptr<slab_type> slab(new slab_type(state.context.backend()));
+      slab->size = (bytes <= SMALL_SIZE)?SLAB_SIZE/bytes*bytes:bytes;
+      switch(state.context.backend())
+      {
+        case CUDA:
+        {
+          CUresult err = dispatch::cuMemAlloc(&slab->h.cu(), slab->size);
+          if(err==CUDA_ERROR_OUT_OF_MEMORY)
+          {
+            trim(state);
+            err = dispatch::cuMemAlloc(&slab->h.cu(), slab->size);
+          }
+          check(err);
+          break;
+        }
+        case OPENCL:
+        {
+          cl_int err;
+          slab->h.cl() = dispatch::clCreateBuffer(state.context.handle().cl(), CL_MEM_READ_WRITE, slab->size, NULL, &err);
+          if(err==CL_MEM_OBJECT_ALLOCATION_FAILURE || err==CL_OUT_OF_RESOURCES)
+          {
+            trim(state);
+            slab->h.cl() = dispatch::clCreateBuffer(state.context.handle().cl(), CL_MEM_READ_WRITE, slab->size, NULL, &err);
+          }
+          check(err);
+          break;
+        }
+        default:
+          throw;
+      }
+      state.statistics.reserved += slab->size;
+      state.statistics.slabs++;
+      open.push_back(slab);
+    }
+    state.statistics.misses++;
+
+    std::shared_ptr<slab_type> slab = open.front();
+    block.reset(new block_type(slab->h.backend()));
+    block->slab = slab;
+    block->offset = slab->carved;
+    block->size = bytes;
+    slab->carved += bytes;
+    if(slab->carved + bytes > slab->size)
+      open.pop_front();
+  }
+  block->queues.assign(1, queue);
+  block->events.clear();
+
+  //Device handles are materialized on first use
+  switch(state.context.backend())
+  {
+    case CUDA:
+      block->h.cu() = block->slab->h.cu() + block->offset;
+      break;
+    case OPENCL:
+      if(block->h.cl())
+        break;
+      if(block->size==block->slab->size)
+        block->h = block->slab->h;
+      else
+      {
+        cl_int err;
+        cl_buffer_region region = {block->offset, block->size};
+        block->h.cl() = dispatch::clCreateSubBuffer(block->slab->h.cl(), CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &region, &err);
+        check(err);
+      }
+      break;
+    default:
+      throw;
+  }
+
+  block->slab->used++;
+  state.statistics.in_use += block->size;
+  state.statistics.peak = std::max(state.statistics.peak, state.statistics.in_use);
+  owner = std::shared_ptr<void>((void*)block.get(), releaser(block, state_));
+  return block->h;
+}
+
+void MemoryPool::trim()
+{
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  trim(*state_);
+}
+
+MemoryPool::statistics_type MemoryPool::statistics() const
+{
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->statistics;
+}
+
+}
+
+}
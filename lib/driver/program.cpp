@@ -21,9 +21,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
 
 #include "isaac/driver/program.h"
+#include "isaac/driver/binary_cache.h"
 #include "isaac/driver/context.h"
+#include "isaac/common/instrumentation.h"
 
 #include "isaac/exception/driver.h"
 
@@ -33,6 +36,9 @@
 #include "tinysha1/sha1.hpp"
 
 #include "isaac/tools/cpp/string.hpp"
+#include "isaac/tools/cpp/hash.hpp"
+#include "isaac/tools/sys/flock.hpp"
+#include "isaac/tools/sys/getenv.hpp"
 
 namespace isaac
 {
@@ -40,24 +46,123 @@ namespace isaac
 namespace driver
 {
 
-Program::Program(Context const & context, std::string const & source) : backend_(context.backend_), context_(context), source_(source), h_(backend_, true)
+//Makes a CUDA context current for its scope, and restores the context the calling thread had bound
+class context_guard
 {
+public:
+  context_guard(CUcontext context)
+  { check(dispatch::cuCtxPushCurrent(context)); }
+
+  ~context_guard()
+  {
+    CUcontext context;
+    dispatch::cuCtxPopCurrent(&context);
+  }
+};
+
+//Appends the source, as compiled, and the build flags to the trace given by ISAAC_TRACE, for ahead-of-time compilation
+static void record(std::string const & source, std::string const & flags)
+{
+  static const std::string path = tools::getenv("ISAAC_TRACE");
+  if(path.empty())
+    return;
+  tools::file_lock guard(path + ".lock", true);
+  std::ofstream file(path.c_str(), std::ios::binary | std::ios::app);
+  for(std::string const & str: {source, flags})
+  {
+    uint64_t size = str.size();
+    file.write((char*)&size, sizeof(size));
+    file.write(str.data(), std::streamsize(size));
+  }
+}
+
+CompilerOptions::CompilerOptions() : fast_math(false), denormals_are_zero(false), mad_enable(false), unroll(0), max_registers(0)
+{}
+
+std::vector<std::string> CompilerOptions::flags(Device const & device) const
+{
+  std::vector<std::string> result;
+  switch(device.backend())
+  {
+    case CUDA:
+      if(fast_math) result.push_back("--use_fast_math");
+      if(denormals_are_zero) result.push_back("--ftz=true");
+      if(mad_enable) result.push_back("--fmad=true");
+      if(max_registers) result.push_back("--maxrregcount=" + tools::to_string(max_registers));
+      break;
+    case OPENCL:
+      if(fast_math) result.push_back("-cl-fast-relaxed-math");
+      if(denormals_are_zero) result.push_back("-cl-denorms-are-zero");
+      if(mad_enable) result.push_back("-cl-mad-enable");
+      if(max_registers && device.vendor()==Device::Vendor::NVIDIA)
+        result.push_back("-cl-nv-maxrregcount=" + tools::to_string(max_registers));
+      break;
+    default:
+      throw std::invalid_argument("ISAAC: compiler options for an unknown backend");
+  }
+  std::vector<std::string> tokens = tools::split(extra, ' ');
+  for(std::string const & token: tokens)
+    if(token.size())
+      result.push_back(token);
+  return result;
+}
+
+std::string CompilerOptions::apply(std::string const & source) const
+{
+  if(unroll==0)
+    return source;
+  std::string result = source;
+  tools::find_and_replace(result, "#pragma unroll\n", "#pragma unroll " + tools::to_string(unroll) + "\n");
+  return result;
+}
+
+std::string CompilerOptions::fingerprint() const
+{
+  std::string result;
+  tools::append(result, fast_math);
+  tools::append(result, denormals_are_zero);
+  tools::append(result, mad_enable);
+  tools::append(result, unroll);
+  tools::append(result, max_registers);
+  tools::append(result, extra.size());
+  return result + extra;
+}
+
+uint64_t CompilerOptions::hash() const
+{
+  return tools::hash(fingerprint());
+}
+
+Program::Program(Context const & context, std::string const & _source, CompilerOptions const & options) : backend_(context.backend_), context_(context), source_(_source), h_(backend_, true)
+{
+  std::string source = options.apply(_source);
+  std::vector<std::string> flags = options.flags(context_.device());
+  std::string build_opt = tools::join(flags, " ");
+  record(source, build_opt);
 //  std::cout << source << std::endl;
   std::string cache_path = context.cache_path_;
   switch(backend_)
   {
     case CUDA:
     {
+      //The module is loaded in the program's context, whichever thread compiles it
+      context_guard guard(context_.h_.cu());
       std::string prefix = context_.device_.name() + "cuda";
-      std::string sha1 = tools::sha1(prefix + source);
-      std::string fname(cache_path + sha1);
+      std::string sha1 = tools::sha1(prefix + build_opt + source);
+      int version;
+      check(dispatch::cuDriverGetVersion(&version));
+      BinaryCache cache(cache_path, prefix + tools::to_string(version));
 
       //Load cached program
-      if(cache_path.size() && std::ifstream(fname, std::ios::binary))
+      std::vector<char> binary;
+      if(cache.load(sha1, binary))
       {
-        check(dispatch::cuModuleLoad(&h_.cu(), fname.c_str()));
+        instrumentation::record(instrumentation::BINARY_CACHE_HIT);
+        check(dispatch::cuModuleLoadDataEx(&h_.cu(), binary.data(), 0, NULL, NULL));
         break;
       }
+      instrumentation::record(instrumentation::BINARY_CACHE_MISS);
+      instrumentation::timer timer(instrumentation::CUDA_COMPILATION);
 
       nvrtcProgram prog;
 
@@ -69,8 +174,10 @@ Program::Program(Context const & context, std::string const & source) : backend_
         std::pair<unsigned int, unsigned int> capability = context_.device().nv_compute_capability();
         std::string capability_opt = "--gpu-architecture=compute_";
         capability_opt += tools::to_string(capability.first) + tools::to_string(capability.second);
-        const char * options[] = {capability_opt.c_str(), "--restrict"};
-        check(dispatch::nvrtcCompileProgram(prog, 2, options));
+        std::vector<const char *> options = {capability_opt.c_str(), "--restrict"};
+        for(std::string const & flag: flags)
+          options.push_back(flag.c_str());
+        check(dispatch::nvrtcCompileProgram(prog, (int)options.size(), options.data()));
       }catch(exception::nvrtc::compilation const &)
       {
         size_t logsize;
@@ -88,11 +195,7 @@ Program::Program(Context const & context, std::string const & source) : backend_
       check(dispatch::cuModuleLoadDataEx(&h_.cu(), ptx.data(), 0, NULL, NULL));
 
       //Save cached program
-      if (cache_path.size())
-      {
-        std::ofstream cached(fname.c_str(),std::ios::binary);
-        cached.write((char*)ptx.data(), std::streamsize(ptx_size));
-      }
+      cache.store(sha1, ptx);
 
 //    std::ofstream oss(sha1 + ".cu", std::ofstream::out | std::ofstream::trunc);
 //    oss << source << std::endl;
@@ -121,44 +224,40 @@ Program::Program(Context const & context, std::string const & source) : backend_
       cl_int err;
       std::vector<cl_device_id> devices = ocl::info<CL_CONTEXT_DEVICES>(context_.h_.cl());
 
-      std::string prefix;
+      std::string prefix, version;
       for(cl_device_id dev: devices)
+      {
         prefix += ocl::info<CL_DEVICE_NAME>(dev) + ocl::info<CL_DEVICE_VENDOR>(dev) + ocl::info<CL_DEVICE_VERSION>(dev);
-      std::string sha1 = tools::sha1(prefix + source);
-      std::string fname(cache_path + sha1);
+        version += ocl::info<CL_DRIVER_VERSION>(dev);
+      }
+      std::string sha1 = tools::sha1(prefix + build_opt + source);
+      BinaryCache cache(cache_path, prefix + version);
       //Load cached program
-      std::string build_opt;
-      if(cache_path.size())
+      std::vector<char> binary;
+      if(cache.load(sha1, binary))
       {
-        std::ifstream cached(fname, std::ios::binary);
-        if (cached)
-        {
-          std::size_t len;
-          std::vector<char> buffer;
-          cached.read((char*)&len, sizeof(std::size_t));
-          buffer.resize(len);
-          cached.read((char*)buffer.data(), std::streamsize(len));
-          char* cbuffer = buffer.data();
-          h_.cl() = dispatch::clCreateProgramWithBinary(context_.h_.cl(), static_cast<cl_uint>(devices.size()), devices.data(), &len, (const unsigned char **)&cbuffer, NULL, &err);
-          check(err);
-          check(dispatch::clBuildProgram(h_.cl(), static_cast<cl_uint>(devices.size()), devices.data(), build_opt.c_str(), NULL, NULL));
-          return;
-        }
+        instrumentation::record(instrumentation::BINARY_CACHE_HIT);
+        std::size_t len = binary.size();
+        char* cbuffer = binary.data();
+        h_.cl() = dispatch::clCreateProgramWithBinary(context_.h_.cl(), static_cast<cl_uint>(devices.size()), devices.data(), &len, (const unsigned char **)&cbuffer, NULL, &err);
+        check(err);
+        check(dispatch::clBuildProgram(h_.cl(), static_cast<cl_uint>(devices.size()), devices.data(), build_opt.c_str(), NULL, NULL));
+        return;
       }
+      instrumentation::record(instrumentation::BINARY_CACHE_MISS);
+      instrumentation::timer timer(instrumentation::OPENCL_COMPILATION);
 
       std::size_t srclen = source.size();
       const char * csrc = source.c_str();
       h_.cl() = dispatch::clCreateProgramWithSource(context_.h_.cl(), 1, &csrc, &srclen, &err);
       try{
         check(dispatch::clBuildProgram(h_.cl(), static_cast<cl_uint>(devices.size()), devices.data(), build_opt.c_str(), NULL, NULL));
-        //Save cached program
-        if (cache_path.size())
+        //Save cached program, which also feeds captures when there is no cache path
+        if(cache.enabled())
         {
-          std::ofstream cached(fname.c_str(),std::ios::binary);
           std::vector<std::size_t> sizes = ocl::info<CL_PROGRAM_BINARY_SIZES>(h_.cl());
-          cached.write((char*)&sizes[0], sizeof(std::size_t));
           std::vector<unsigned char*> binaries = ocl::info<CL_PROGRAM_BINARIES>(h_.cl());
-          cached.write((char*)binaries[0], std::streamsize(sizes[0]));
+          cache.store(sha1, std::vector<char>(binaries[0], binaries[0] + sizes[0]));
           for(unsigned char * ptr: binaries)
               delete[] ptr;
         }
@@ -185,6 +284,9 @@ Program::handle_type const & Program::handle() const
 Context const & Program::context() const
 { return context_; }
 
+std::string const & Program::source() const
+{ return source_; }
+
 
 }
 
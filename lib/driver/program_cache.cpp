@@ -19,6 +19,8 @@
  * MA 02110-1301  USA
  */
 
+#include <iterator>
+
 #include "isaac/driver/program_cache.h"
 
 namespace isaac
@@ -27,33 +29,115 @@ namespace isaac
 namespace driver
 {
 
-Program & ProgramCache::add(Context const & context, std::string const & name, std::string const & src)
+ProgramCache::ProgramCache(size_t max_entries, size_t max_bytes) : max_entries_(max_entries), max_bytes_(max_bytes)
+{}
+
+//Called with the mutex held
+void ProgramCache::erase(lru_type::iterator it)
+{
+    statistics_.bytes -= it->bytes;
+    index_.erase(it->key);
+    lru_.erase(it);
+    statistics_.size = lru_.size();
+}
+
+//Called with the mutex held
+void ProgramCache::evict()
 {
-    std::map<std::string, Program>::iterator it = cache_.find(name);
-    if(it==cache_.end())
+    //The most recent entry is never evicted
+    while(lru_.size() > 1 && ((max_entries_ && lru_.size() > max_entries_) || (max_bytes_ && statistics_.bytes > max_bytes_)))
     {
-        std::string extensions;
-        std::string ext = "cl_khr_fp64";
-        if(context.device().extensions().find(ext)!=std::string::npos)
-          extensions = "#pragma OPENCL EXTENSION " + ext + " : enable\n";
-        return cache_.insert(std::make_pair(name, driver::Program(context, extensions + src))).first->second;
+        statistics_.evictions++;
+        erase(std::prev(lru_.end()));
     }
-    return it->second;
+    statistics_.size = lru_.size();
 }
 
-Program const * ProgramCache::find(const std::string &name)
+std::string ProgramCache::prepare(Context const & context, std::string const & src)
 {
-    std::map<std::string, Program>::const_iterator it = cache_.find(name);
-    if(it==cache_.end())
-        return NULL;
-    return &(it->second);
+    std::string ext = "cl_khr_fp64";
+    if(context.device().extensions().find(ext)!=std::string::npos)
+      return "#pragma OPENCL EXTENSION " + ext + " : enable\n" + src;
+    return src;
 }
 
-void ProgramCache::clear()
+Program ProgramCache::add(Context const & context, uint64_t key, std::string const & fingerprint, std::string const & src, uint64_t scope, CompilerOptions const & options)
 {
-    cache_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unordered_map<uint64_t, lru_type::iterator>::iterator it = index_.find(key);
+        if(it!=index_.end() && it->second->fingerprint==fingerprint)
+        {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->program;
+        }
+    }
+    return add(key, fingerprint, driver::Program(context, prepare(context, src), options), scope);
 }
 
+Program ProgramCache::add(uint64_t key, std::string const & fingerprint, Program const & program, uint64_t scope)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<uint64_t, lru_type::iterator>::iterator it = index_.find(key);
+    if(it!=index_.end())
+    {
+        if(it->second->fingerprint==fingerprint)
+        {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->program;
+        }
+        //Colliding key: the entry of the other fingerprint is replaced
+        statistics_.collisions++;
+        erase(it->second);
+    }
+    entry_type entry = {key, fingerprint, scope, program.source().size(), program};
+    lru_.push_front(entry);
+    index_.insert(std::make_pair(key, lru_.begin()));
+    statistics_.bytes += entry.bytes;
+    evict();
+    return lru_.front().program;
+}
+
+std::unique_ptr<Program> ProgramCache::find(uint64_t key, std::string const & fingerprint)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<uint64_t, lru_type::iterator>::iterator it = index_.find(key);
+    if(it==index_.end() || it->second->fingerprint!=fingerprint)
+    {
+        statistics_.misses++;
+        return std::unique_ptr<Program>();
+    }
+    statistics_.hits++;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return std::unique_ptr<Program>(new Program(it->second->program));
+}
+
+void ProgramCache::invalidate(uint64_t scope)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(lru_type::iterator it = lru_.begin() ; it != lru_.end() ;)
+    {
+        if(it->scope==scope)
+            erase(it++);
+        else
+            ++it;
+    }
+}
+
+ProgramCache::statistics_type ProgramCache::statistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+void ProgramCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    statistics_.bytes = 0;
+    statistics_.size = 0;
+}
 }
 
 }
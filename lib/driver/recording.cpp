@@ -0,0 +1,774 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "isaac/driver/dispatch.h"
+#include "isaac/driver/host.h"
+#include "isaac/driver/recording.h"
+#include "isaac/tools/sys/getenv.hpp"
+
+namespace isaac
+{
+namespace driver
+{
+
+namespace
+{
+
+//Objects of the platform. OpenCL handles point to them
+struct object
+{
+  object(): references(1){}
+  virtual ~object(){}
+  std::atomic<int> references;
+};
+
+struct device_t: object
+{
+  device_t(unsigned int _compute_units, bool _root): compute_units(_compute_units), root(_root){}
+  unsigned int compute_units;
+  bool root;
+};
+
+struct context_t: object
+{
+  std::vector<cl_device_id> devices;
+};
+
+struct queue_t: object
+{
+  cl_context context;
+  cl_device_id device;
+  unsigned int id;
+};
+
+struct mem_t: object
+{
+  cl_context context;
+  //Owned memory, shared with the sub-buffers. Empty for buffers using host memory
+  std::shared_ptr<std::vector<char> > storage;
+  char* data;
+  size_t size;
+  void* host;
+  long id;
+};
+
+struct program_t: object
+{
+  cl_context context;
+  std::string source;
+  bool binary;
+  //Host mode only
+  std::shared_ptr<host::module> module;
+  std::string log;
+};
+
+struct kernel_t: object
+{
+  cl_program program;
+  std::string name;
+  std::vector<recording::argument_type> arguments;
+};
+
+struct event_t: object
+{
+  cl_ulong time;
+};
+
+struct state_type
+{
+  state_type(): root(host::enabled()?host::threads():4, true), queues(0), buffers(0){}
+  std::mutex mutex;
+  device_t root;
+  std::set<cl_mem> live;
+  std::vector<recording::command_type> commands;
+  std::vector<recording::build_type> builds;
+  unsigned int queues;
+  long buffers;
+};
+
+state_type & state()
+{
+  static state_type result;
+  return result;
+}
+
+static char platform_;
+
+template<class T, class H>
+T * get(H handle)
+{ return reinterpret_cast<T*>(handle); }
+
+template<class H>
+cl_int retain(H handle)
+{
+  if(!handle) return CL_INVALID_VALUE;
+  reinterpret_cast<object*>(handle)->references++;
+  return CL_SUCCESS;
+}
+
+template<class T, class H>
+cl_int release(H handle)
+{
+  if(!handle) return CL_INVALID_VALUE;
+  if(--reinterpret_cast<object*>(handle)->references==0)
+    delete get<T>(handle);
+  return CL_SUCCESS;
+}
+
+void set_error(cl_int * errcode, cl_int value)
+{
+  if(errcode)
+    *errcode = value;
+}
+
+//Answers an info query
+cl_int answer(void const * value, size_t size, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  if(param_value_size_ret)
+    *param_value_size_ret = size;
+  if(param_value){
+    if(param_value_size < size)
+      return CL_INVALID_VALUE;
+    std::memcpy(param_value, value, size);
+  }
+  return CL_SUCCESS;
+}
+
+template<class T>
+cl_int answer(T const & value, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{ return answer(&value, sizeof(T), param_value_size, param_value, param_value_size_ret); }
+
+cl_int answer(std::string const & value, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{ return answer(value.c_str(), value.size() + 1, param_value_size, param_value, param_value_size_ret); }
+
+template<class T>
+cl_int answer(std::vector<T> const & value, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{ return answer(value.data(), value.size()*sizeof(T), param_value_size, param_value, param_value_size_ret); }
+
+//Records a command and creates its event
+cl_int enqueue(cl_command_queue queue, recording::command_type command, cl_uint num_events, cl_event * event)
+{
+  command.queue = get<queue_t>(queue)->id;
+  command.dependencies = num_events;
+  {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().commands.push_back(command);
+  }
+  if(event){
+    event_t * result = new event_t();
+    result->time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    *event = reinterpret_cast<cl_event>(result);
+  }
+  return CL_SUCCESS;
+}
+
+recording::command_type transfer(recording::command_type::kind_type kind, cl_mem buffer, size_t bytes)
+{
+  recording::command_type result = {};
+  result.kind = kind;
+  result.buffer = get<mem_t>(buffer)->id;
+  result.bytes = bytes;
+  return result;
+}
+
+//Copies a 3D region between a buffer and the host
+void copy_rect(char * buffer, char * host, bool to_buffer, const size_t * buffer_origin, const size_t * host_origin, const size_t * region,
+               size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch)
+{
+  if(buffer_row_pitch==0) buffer_row_pitch = region[0];
+  if(buffer_slice_pitch==0) buffer_slice_pitch = region[1]*buffer_row_pitch;
+  if(host_row_pitch==0) host_row_pitch = region[0];
+  if(host_slice_pitch==0) host_slice_pitch = region[1]*host_row_pitch;
+  for(size_t z = 0 ; z < region[2] ; ++z)
+    for(size_t y = 0 ; y < region[1] ; ++y)
+    {
+      char * b = buffer + buffer_origin[0] + (buffer_origin[1] + y)*buffer_row_pitch + (buffer_origin[2] + z)*buffer_slice_pitch;
+      char * h = host + host_origin[0] + (host_origin[1] + y)*host_row_pitch + (host_origin[2] + z)*host_slice_pitch;
+      if(to_buffer) std::memcpy(b, h, region[0]);
+      else std::memcpy(h, b, region[0]);
+    }
+}
+
+//Kernels run on the host device in host mode, and nowhere otherwise
+cl_device_type device_type()
+{ return host::enabled()?CL_DEVICE_TYPE_CPU:CL_DEVICE_TYPE_GPU; }
+
+//Entry points
+namespace stubs
+{
+
+cl_int clGetPlatformIDs(cl_uint num_entries, cl_platform_id * platforms, cl_uint * num_platforms)
+{
+  if(num_platforms) *num_platforms = 1;
+  if(platforms && num_entries > 0) platforms[0] = reinterpret_cast<cl_platform_id>(&platform_);
+  return CL_SUCCESS;
+}
+
+cl_int clGetPlatformInfo(cl_platform_id, cl_platform_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  switch(param_name)
+  {
+    case CL_PLATFORM_NAME: return answer(std::string("ISAAC recording"), param_value_size, param_value, param_value_size_ret);
+    case CL_PLATFORM_VENDOR: return answer(std::string("ISAAC"), param_value_size, param_value, param_value_size_ret);
+    case CL_PLATFORM_VERSION: return answer(std::string("OpenCL 1.2 ISAAC"), param_value_size, param_value, param_value_size_ret);
+    case CL_PLATFORM_PROFILE: return answer(std::string("FULL_PROFILE"), param_value_size, param_value, param_value_size_ret);
+    case CL_PLATFORM_EXTENSIONS: return answer(std::string(""), param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clGetDeviceIDs(cl_platform_id platform, cl_device_type type, cl_uint num_entries, cl_device_id * devices, cl_uint * num_devices)
+{
+  if(platform!=reinterpret_cast<cl_platform_id>(&platform_))
+    return CL_INVALID_PLATFORM;
+  if(!(type & (device_type() | CL_DEVICE_TYPE_DEFAULT)))
+    return CL_DEVICE_NOT_FOUND;
+  if(num_devices) *num_devices = 1;
+  if(devices && num_entries > 0) devices[0] = reinterpret_cast<cl_device_id>(&state().root);
+  return CL_SUCCESS;
+}
+
+cl_int clGetDeviceInfo(cl_device_id device, cl_device_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  device_t * d = get<device_t>(device);
+  switch(param_name)
+  {
+    case CL_DEVICE_NAME: return answer(std::string(host::enabled()?"Host device":"Recording device"), param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_VENDOR: return answer(std::string("ISAAC"), param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_VERSION: return answer(std::string("OpenCL 1.2 ISAAC"), param_value_size, param_value, param_value_size_ret);
+    case CL_DRIVER_VERSION: return answer(std::string(host::enabled()?"1.0 " + host::target():"1.0"), param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_EXTENSIONS: return answer(std::string(host::enabled()?"cl_khr_fp64":""), param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_PLATFORM: return answer(reinterpret_cast<cl_platform_id>(&platform_), param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_TYPE: return answer(device_type(), param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_ADDRESS_BITS: return answer((cl_uint)(8*sizeof(size_t)), param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_CLOCK_FREQUENCY: return answer((cl_uint)1000, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_COMPUTE_UNITS: return answer((cl_uint)d->compute_units, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_GLOBAL_MEM_SIZE: return answer((cl_ulong)1 << 32, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_LOCAL_MEM_SIZE: return answer((cl_ulong)48 << 10, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MEM_BASE_ADDR_ALIGN: return answer((cl_uint)1024, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_WORK_GROUP_SIZE: return answer((size_t)1024, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_MAX_WORK_ITEM_SIZES: return answer(std::vector<size_t>{1024, 1024, 64}, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_HOST_UNIFIED_MEMORY: return answer((cl_bool)host::enabled(), param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_PARTITION_MAX_SUB_DEVICES: return answer((cl_uint)d->compute_units, param_value_size, param_value, param_value_size_ret);
+    case CL_DEVICE_PARTITION_AFFINITY_DOMAIN: return answer((cl_device_affinity_domain)0, param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clCreateSubDevices(cl_device_id device, const cl_device_partition_property * properties, cl_uint num_devices, cl_device_id * devices, cl_uint * num_devices_ret)
+{
+  device_t * d = get<device_t>(device);
+  if(!properties || properties[0]!=CL_DEVICE_PARTITION_EQUALLY || properties[1] <= 0)
+    return CL_INVALID_VALUE;
+  cl_uint compute_units = properties[1];
+  cl_uint n = d->compute_units/compute_units;
+  if(n==0)
+    return CL_DEVICE_PARTITION_FAILED;
+  if(num_devices_ret) *num_devices_ret = n;
+  if(devices){
+    if(num_devices < n)
+      return CL_INVALID_VALUE;
+    for(cl_uint i = 0 ; i < n ; ++i)
+      devices[i] = reinterpret_cast<cl_device_id>(new device_t(compute_units, false));
+  }
+  return CL_SUCCESS;
+}
+
+cl_int clReleaseDevice(cl_device_id device)
+{
+  if(get<device_t>(device)->root)
+    return CL_SUCCESS;
+  return release<device_t>(device);
+}
+
+cl_context clCreateContext(const cl_context_properties *, cl_uint num_devices, const cl_device_id * devices, void (*)(const char *, const void *, size_t, void *), void *, cl_int * errcode_ret)
+{
+  context_t * result = new context_t();
+  for(cl_uint i = 0 ; i < num_devices ; ++i){
+    result->devices.push_back(devices[i]);
+    retain(devices[i]);
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return reinterpret_cast<cl_context>(result);
+}
+
+cl_int clGetContextInfo(cl_context context, cl_context_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  context_t * c = get<context_t>(context);
+  switch(param_name)
+  {
+    case CL_CONTEXT_DEVICES: return answer(c->devices, param_value_size, param_value, param_value_size_ret);
+    case CL_CONTEXT_NUM_DEVICES: return answer((cl_uint)c->devices.size(), param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clReleaseContext(cl_context context)
+{
+  std::vector<cl_device_id> devices = get<context_t>(context)->devices;
+  cl_int result = release<context_t>(context);
+  for(cl_device_id device: devices)
+    stubs::clReleaseDevice(device);
+  return result;
+}
+
+cl_command_queue clCreateCommandQueue(cl_context context, cl_device_id device, cl_command_queue_properties, cl_int * errcode_ret)
+{
+  queue_t * result = new queue_t();
+  result->context = context;
+  result->device = device;
+  {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    result->id = state().queues++;
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return reinterpret_cast<cl_command_queue>(result);
+}
+
+cl_int clGetCommandQueueInfo(cl_command_queue queue, cl_command_queue_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  queue_t * q = get<queue_t>(queue);
+  switch(param_name)
+  {
+    case CL_QUEUE_CONTEXT: return answer(q->context, param_value_size, param_value, param_value_size_ret);
+    case CL_QUEUE_DEVICE: return answer(q->device, param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clReleaseCommandQueue(cl_command_queue queue)
+{ return release<queue_t>(queue); }
+
+cl_int clFlush(cl_command_queue)
+{ return CL_SUCCESS; }
+
+cl_int clFinish(cl_command_queue)
+{ return CL_SUCCESS; }
+
+cl_mem clCreateBuffer(cl_context context, cl_mem_flags flags, size_t size, void * host_ptr, cl_int * errcode_ret)
+{
+  mem_t * result = new mem_t();
+  result->context = context;
+  result->size = size;
+  result->host = (flags & CL_MEM_USE_HOST_PTR)?host_ptr:NULL;
+  if(result->host)
+    result->data = (char*)host_ptr;
+  else{
+    result->storage.reset(new std::vector<char>(size));
+    result->data = result->storage->data();
+    if(flags & CL_MEM_COPY_HOST_PTR)
+      std::memcpy(result->data, host_ptr, size);
+  }
+  {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    result->id = state().buffers++;
+    state().live.insert(reinterpret_cast<cl_mem>(result));
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return reinterpret_cast<cl_mem>(result);
+}
+
+cl_mem clCreateSubBuffer(cl_mem buffer, cl_mem_flags, cl_buffer_create_type, const void * info, cl_int * errcode_ret)
+{
+  mem_t * parent = get<mem_t>(buffer);
+  cl_buffer_region const * region = (cl_buffer_region const *)info;
+  if(region->origin + region->size > parent->size){
+    set_error(errcode_ret, CL_INVALID_VALUE);
+    return NULL;
+  }
+  mem_t * result = new mem_t();
+  result->context = parent->context;
+  result->storage = parent->storage;
+  result->data = parent->data + region->origin;
+  result->size = region->size;
+  result->host = parent->host?(char*)parent->host + region->origin:NULL;
+  {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    result->id = state().buffers++;
+    state().live.insert(reinterpret_cast<cl_mem>(result));
+  }
+  set_error(errcode_ret, CL_SUCCESS);
+  return reinterpret_cast<cl_mem>(result);
+}
+
+cl_int clGetMemObjectInfo(cl_mem buffer, cl_mem_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  mem_t * m = get<mem_t>(buffer);
+  switch(param_name)
+  {
+    case CL_MEM_CONTEXT: return answer(m->context, param_value_size, param_value, param_value_size_ret);
+    case CL_MEM_SIZE: return answer(m->size, param_value_size, param_value, param_value_size_ret);
+    case CL_MEM_HOST_PTR: return answer(m->host, param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clReleaseMemObject(cl_mem buffer)
+{
+  if(get<mem_t>(buffer)->references==1){
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().live.erase(buffer);
+  }
+  return release<mem_t>(buffer);
+}
+
+cl_program clCreateProgramWithSource(cl_context context, cl_uint count, const char ** strings, const size_t * lengths, cl_int * errcode_ret)
+{
+  program_t * result = new program_t();
+  result->context = context;
+  result->binary = false;
+  for(cl_uint i = 0 ; i < count ; ++i)
+    result->source += (lengths && lengths[i])?std::string(strings[i], lengths[i]):std::string(strings[i]);
+  set_error(errcode_ret, CL_SUCCESS);
+  return reinterpret_cast<cl_program>(result);
+}
+
+//Binaries are the sources themselves
+cl_program clCreateProgramWithBinary(cl_context context, cl_uint, const cl_device_id *, const size_t * lengths, const unsigned char ** binaries, cl_int * binary_status, cl_int * errcode_ret)
+{
+  program_t * result = new program_t();
+  result->context = context;
+  result->binary = true;
+  result->source = std::string((const char*)binaries[0], lengths[0]);
+  if(binary_status) *binary_status = CL_SUCCESS;
+  set_error(errcode_ret, CL_SUCCESS);
+  return reinterpret_cast<cl_program>(result);
+}
+
+cl_int clBuildProgram(cl_program program, cl_uint, const cl_device_id *, const char * options, void (*)(cl_program, void *), void *)
+{
+  program_t * p = get<program_t>(program);
+  recording::build_type build;
+  build.source = p->source;
+  build.options = options?options:"";
+  build.binary = p->binary;
+  {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().builds.push_back(build);
+  }
+  if(host::enabled())
+  {
+    try{
+      if(p->binary)
+        p->module.reset(new host::module(std::vector<char>(p->source.begin(), p->source.end())));
+      else
+        p->module.reset(new host::module(p->source, build.options));
+    }catch(std::exception const & e){
+      p->log = e.what();
+      return CL_BUILD_PROGRAM_FAILURE;
+    }
+  }
+  return CL_SUCCESS;
+}
+
+cl_int clGetProgramInfo(cl_program program, cl_program_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  program_t * p = get<program_t>(program);
+  //Shared object in host mode, sources otherwise
+  std::vector<char> binary = p->module?p->module->binary():std::vector<char>(p->source.begin(), p->source.end());
+  switch(param_name)
+  {
+    case CL_PROGRAM_CONTEXT: return answer(p->context, param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_NUM_DEVICES: return answer((cl_uint)get<context_t>(p->context)->devices.size(), param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_DEVICES: return answer(get<context_t>(p->context)->devices, param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_SOURCE: return answer(p->source, param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_BINARY_SIZES: return answer(std::vector<size_t>(get<context_t>(p->context)->devices.size(), binary.size()), param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_BINARIES:
+    {
+      size_t ndevices = get<context_t>(p->context)->devices.size();
+      if(param_value_size_ret) *param_value_size_ret = ndevices*sizeof(unsigned char*);
+      if(param_value){
+        if(param_value_size < ndevices*sizeof(unsigned char*))
+          return CL_INVALID_VALUE;
+        for(size_t i = 0 ; i < ndevices ; ++i)
+          if(((unsigned char**)param_value)[i])
+            std::memcpy(((unsigned char**)param_value)[i], binary.data(), binary.size());
+      }
+      return CL_SUCCESS;
+    }
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clGetProgramBuildInfo(cl_program program, cl_device_id, cl_program_build_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  program_t * p = get<program_t>(program);
+  switch(param_name)
+  {
+    case CL_PROGRAM_BUILD_STATUS: return answer((cl_build_status)(p->log.empty()?CL_BUILD_SUCCESS:CL_BUILD_ERROR), param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_BUILD_LOG: return answer(p->log, param_value_size, param_value, param_value_size_ret);
+    case CL_PROGRAM_BUILD_OPTIONS: return answer(std::string(""), param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clReleaseProgram(cl_program program)
+{ return release<program_t>(program); }
+
+cl_kernel clCreateKernel(cl_program program, const char * name, cl_int * errcode_ret)
+{
+  program_t * p = get<program_t>(program);
+  //The kernel must be defined by the program
+  std::string signature = std::string(" ") + name + "(";
+  if(p->module?!p->module->has(name):p->source.find(signature)==std::string::npos){
+    set_error(errcode_ret, CL_INVALID_KERNEL_NAME);
+    return NULL;
+  }
+  kernel_t * result = new kernel_t();
+  result->program = program;
+  result->name = name;
+  retain(program);
+  set_error(errcode_ret, CL_SUCCESS);
+  return reinterpret_cast<cl_kernel>(result);
+}
+
+cl_int clSetKernelArg(cl_kernel kernel, cl_uint index, size_t size, const void * value)
+{
+  kernel_t * k = get<kernel_t>(kernel);
+  if(k->arguments.size() <= index)
+    k->arguments.resize(index + 1);
+  recording::argument_type & argument = k->arguments[index];
+  argument.value = value?std::vector<char>((const char*)value, (const char*)value + size):std::vector<char>();
+  argument.buffer = -1;
+  if(value && size==sizeof(cl_mem)){
+    cl_mem buffer = *(const cl_mem*)value;
+    std::lock_guard<std::mutex> lock(state().mutex);
+    if(state().live.count(buffer))
+      argument.buffer = get<mem_t>(buffer)->id;
+  }
+  return CL_SUCCESS;
+}
+
+cl_int clGetKernelInfo(cl_kernel kernel, cl_kernel_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  kernel_t * k = get<kernel_t>(kernel);
+  switch(param_name)
+  {
+    case CL_KERNEL_FUNCTION_NAME: return answer(k->name, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_PROGRAM: return answer(k->program, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_CONTEXT: return answer(get<program_t>(k->program)->context, param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clGetKernelWorkGroupInfo(cl_kernel, cl_device_id, cl_kernel_work_group_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  switch(param_name)
+  {
+    case CL_KERNEL_WORK_GROUP_SIZE: return answer((size_t)1024, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE: return answer((size_t)32, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_LOCAL_MEM_SIZE: return answer((cl_ulong)0, param_value_size, param_value, param_value_size_ret);
+    case CL_KERNEL_PRIVATE_MEM_SIZE: return answer((cl_ulong)0, param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clReleaseKernel(cl_kernel kernel)
+{
+  kernel_t * k = get<kernel_t>(kernel);
+  cl_program program = k->program;
+  cl_int result = release<kernel_t>(kernel);
+  stubs::clReleaseProgram(program);
+  return result;
+}
+
+cl_int clEnqueueNDRangeKernel(cl_command_queue queue, cl_kernel kernel, cl_uint work_dim, const size_t * offset, const size_t * global, const size_t * local, cl_uint num_events, const cl_event *, cl_event * event)
+{
+  (void)offset;
+  kernel_t * k = get<kernel_t>(kernel);
+  recording::command_type command = {};
+  command.kind = recording::command_type::KERNEL;
+  command.name = k->name;
+  command.arguments = k->arguments;
+  command.global.assign(global, global + work_dim);
+  if(local)
+    command.local.assign(local, local + work_dim);
+  command.buffer = -1;
+  command.bytes = 0;
+  //Host mode: buffers are passed by host pointer
+  program_t * p = get<program_t>(k->program);
+  if(p->module)
+  {
+    std::vector<char*> pointers(k->arguments.size());
+    std::vector<void*> arguments(k->arguments.size());
+    for(size_t i = 0 ; i < k->arguments.size() ; ++i)
+    {
+      recording::argument_type const & argument = k->arguments[i];
+      if(argument.value.empty())
+        return CL_INVALID_KERNEL_ARGS;
+      if(argument.buffer >= 0){
+        pointers[i] = get<mem_t>(*(const cl_mem*)argument.value.data())->data;
+        arguments[i] = &pointers[i];
+      }
+      else
+        arguments[i] = (void*)argument.value.data();
+    }
+    try{
+      p->module->launch(k->name, arguments, work_dim, global, local);
+    }catch(std::exception const &){
+      return CL_OUT_OF_RESOURCES;
+    }
+  }
+  return enqueue(queue, command, num_events, event);
+}
+
+cl_int clEnqueueWriteBuffer(cl_command_queue queue, cl_mem buffer, cl_bool, size_t offset, size_t size, const void * ptr, cl_uint num_events, const cl_event *, cl_event * event)
+{
+  std::memcpy(get<mem_t>(buffer)->data + offset, ptr, size);
+  return enqueue(queue, transfer(recording::command_type::WRITE, buffer, size), num_events, event);
+}
+
+cl_int clEnqueueReadBuffer(cl_command_queue queue, cl_mem buffer, cl_bool, size_t offset, size_t size, void * ptr, cl_uint num_events, const cl_event *, cl_event * event)
+{
+  std::memcpy(ptr, get<mem_t>(buffer)->data + offset, size);
+  return enqueue(queue, transfer(recording::command_type::READ, buffer, size), num_events, event);
+}
+
+cl_int clEnqueueWriteBufferRect(cl_command_queue queue, cl_mem buffer, cl_bool, const size_t * buffer_origin, const size_t * host_origin, const size_t * region,
+                                size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch, const void * ptr, cl_uint num_events, const cl_event *, cl_event * event)
+{
+  copy_rect(get<mem_t>(buffer)->data, (char*)ptr, true, buffer_origin, host_origin, region, buffer_row_pitch, buffer_slice_pitch, host_row_pitch, host_slice_pitch);
+  return enqueue(queue, transfer(recording::command_type::WRITE, buffer, region[0]*region[1]*region[2]), num_events, event);
+}
+
+cl_int clEnqueueReadBufferRect(cl_command_queue queue, cl_mem buffer, cl_bool, const size_t * buffer_origin, const size_t * host_origin, const size_t * region,
+                               size_t buffer_row_pitch, size_t buffer_slice_pitch, size_t host_row_pitch, size_t host_slice_pitch, void * ptr, cl_uint num_events, const cl_event *, cl_event * event)
+{
+  copy_rect(get<mem_t>(buffer)->data, (char*)ptr, false, buffer_origin, host_origin, region, buffer_row_pitch, buffer_slice_pitch, host_row_pitch, host_slice_pitch);
+  return enqueue(queue, transfer(recording::command_type::READ, buffer, region[0]*region[1]*region[2]), num_events, event);
+}
+
+cl_int clEnqueueFillBuffer(cl_command_queue queue, cl_mem buffer, const void * pattern, size_t pattern_size, size_t offset, size_t size, cl_uint num_events, const cl_event *, cl_event * event)
+{
+  char * data = get<mem_t>(buffer)->data + offset;
+  for(size_t i = 0 ; i < size ; i += pattern_size)
+    std::memcpy(data + i, pattern, std::min(pattern_size, size - i));
+  return enqueue(queue, transfer(recording::command_type::FILL, buffer, size), num_events, event);
+}
+
+void* clEnqueueMapBuffer(cl_command_queue queue, cl_mem buffer, cl_bool, cl_map_flags, size_t offset, size_t size, cl_uint num_events, const cl_event *, cl_event * event, cl_int * errcode_ret)
+{
+  set_error(errcode_ret, enqueue(queue, transfer(recording::command_type::MAP, buffer, size), num_events, event));
+  return get<mem_t>(buffer)->data + offset;
+}
+
+cl_int clEnqueueUnmapMemObject(cl_command_queue queue, cl_mem buffer, void *, cl_uint num_events, const cl_event *, cl_event * event)
+{ return enqueue(queue, transfer(recording::command_type::UNMAP, buffer, 0), num_events, event); }
+
+cl_int clEnqueueMarkerWithWaitList(cl_command_queue queue, cl_uint num_events, const cl_event *, cl_event * event)
+{
+  recording::command_type command = {};
+  command.kind = recording::command_type::MARKER;
+  command.buffer = -1;
+  command.bytes = 0;
+  return enqueue(queue, command, num_events, event);
+}
+
+cl_int clWaitForEvents(cl_uint, const cl_event *)
+{ return CL_SUCCESS; }
+
+cl_int clGetEventProfilingInfo(cl_event event, cl_profiling_info param_name, size_t param_value_size, void * param_value, size_t * param_value_size_ret)
+{
+  switch(param_name)
+  {
+    case CL_PROFILING_COMMAND_QUEUED:
+    case CL_PROFILING_COMMAND_SUBMIT:
+    case CL_PROFILING_COMMAND_START:
+    case CL_PROFILING_COMMAND_END:
+      return answer(get<event_t>(event)->time, param_value_size, param_value, param_value_size_ret);
+    default: return CL_INVALID_VALUE;
+  }
+}
+
+cl_int clRetainEvent(cl_event event)
+{ return retain(event); }
+
+cl_int clReleaseEvent(cl_event event)
+{ return release<event_t>(event); }
+
+}
+
+bool & enabled_flag()
+{
+  static bool result = tools::getenv("ISAAC_BACKEND")=="recording" || host::enabled();
+  return result;
+}
+
+}
+
+void recording::enable()
+{ enabled_flag() = true; }
+
+bool recording::enabled()
+{ return enabled_flag(); }
+
+std::vector<recording::command_type> recording::commands()
+{
+  std::lock_guard<std::mutex> lock(state().mutex);
+  return state().commands;
+}
+
+std::vector<recording::build_type> recording::builds()
+{
+  std::lock_guard<std::mutex> lock(state().mutex);
+  return state().builds;
+}
+
+void recording::clear()
+{
+  std::lock_guard<std::mutex> lock(state().mutex);
+  state().commands.clear();
+  state().builds.clear();
+}
+
+void* recording::symbol(const char * name)
+{
+  #define ISAAC_RECORDING_ENTRY(NAME) {#NAME, reinterpret_cast<void*>(&stubs::NAME)}
+  static const std::map<std::string, void*> entries = {
+    ISAAC_RECORDING_ENTRY(clGetPlatformIDs), ISAAC_RECORDING_ENTRY(clGetPlatformInfo),
+    ISAAC_RECORDING_ENTRY(clGetDeviceIDs), ISAAC_RECORDING_ENTRY(clGetDeviceInfo), ISAAC_RECORDING_ENTRY(clCreateSubDevices), ISAAC_RECORDING_ENTRY(clReleaseDevice),
+    ISAAC_RECORDING_ENTRY(clCreateContext), ISAAC_RECORDING_ENTRY(clGetContextInfo), ISAAC_RECORDING_ENTRY(clReleaseContext),
+    ISAAC_RECORDING_ENTRY(clCreateCommandQueue), ISAAC_RECORDING_ENTRY(clGetCommandQueueInfo), ISAAC_RECORDING_ENTRY(clReleaseCommandQueue), ISAAC_RECORDING_ENTRY(clFlush), ISAAC_RECORDING_ENTRY(clFinish),
+    ISAAC_RECORDING_ENTRY(clCreateBuffer), ISAAC_RECORDING_ENTRY(clCreateSubBuffer), ISAAC_RECORDING_ENTRY(clGetMemObjectInfo), ISAAC_RECORDING_ENTRY(clReleaseMemObject),
+    ISAAC_RECORDING_ENTRY(clCreateProgramWithSource), ISAAC_RECORDING_ENTRY(clCreateProgramWithBinary), ISAAC_RECORDING_ENTRY(clBuildProgram),
+    ISAAC_RECORDING_ENTRY(clGetProgramInfo), ISAAC_RECORDING_ENTRY(clGetProgramBuildInfo), ISAAC_RECORDING_ENTRY(clReleaseProgram),
+    ISAAC_RECORDING_ENTRY(clCreateKernel), ISAAC_RECORDING_ENTRY(clSetKernelArg), ISAAC_RECORDING_ENTRY(clGetKernelInfo), ISAAC_RECORDING_ENTRY(clGetKernelWorkGroupInfo), ISAAC_RECORDING_ENTRY(clReleaseKernel),
+    ISAAC_RECORDING_ENTRY(clEnqueueNDRangeKernel), ISAAC_RECORDING_ENTRY(clEnqueueWriteBuffer), ISAAC_RECORDING_ENTRY(clEnqueueReadBuffer),
+    ISAAC_RECORDING_ENTRY(clEnqueueWriteBufferRect), ISAAC_RECORDING_ENTRY(clEnqueueReadBufferRect), ISAAC_RECORDING_ENTRY(clEnqueueFillBuffer),
+    ISAAC_RECORDING_ENTRY(clEnqueueMapBuffer), ISAAC_RECORDING_ENTRY(clEnqueueUnmapMemObject), ISAAC_RECORDING_ENTRY(clEnqueueMarkerWithWaitList), ISAAC_RECORDING_ENTRY(clWaitForEvents),
+    ISAAC_RECORDING_ENTRY(clGetEventProfilingInfo), ISAAC_RECORDING_ENTRY(clRetainEvent), ISAAC_RECORDING_ENTRY(clReleaseEvent)
+  };
+  #undef ISAAC_RECORDING_ENTRY
+  std::map<std::string, void*>::const_iterator it = entries.find(name);
+  return (it==entries.end())?NULL:it->second;
+}
+
+}
+}
@@ -34,6 +34,7 @@
 #include "isaac/exception/api.h"
 #include "isaac/jit/syntax/engine/process.h"
 #include "isaac/tools/cpp/string.hpp"
+#include "isaac/common/instrumentation.h"
 
 namespace isaac
 {
@@ -61,6 +62,7 @@ base::~base()
 
 std::string base::generate(std::string const & suffix, expression_tree const  & expression, driver::Device const & device)
 {
+  instrumentation::timer timer(instrumentation::CODEGEN);
   int err = is_invalid(expression, device);
   if(err != 0)
     throw operation_not_supported_exception("The supplied parameters for this template are invalid : err " + tools::to_string(err));
@@ -70,6 +72,20 @@ std::string base::generate(std::string const & suffix, expression_tree const  &
   return generate_impl(suffix, expression, device, mapping);
 }
 
+std::string base::specialize_impl(std::string const &, expression_tree const &, driver::Device const &, symbolic::symbols_table const &) const
+{ return ""; }
+
+std::string base::specialize(std::string const & suffix, expression_tree const  & expression, driver::Device const & device)
+{
+  instrumentation::timer timer(instrumentation::CODEGEN);
+  int err = is_invalid(expression, device);
+  if(err != 0)
+    throw operation_not_supported_exception("The supplied parameters for this template are invalid : err " + tools::to_string(err));
+
+  symbolic::symbols_table mapping = symbolic::symbolize(fusion_policy_, expression);
+  return specialize_impl(suffix, expression, device, mapping);
+}
+
 template<class TType, class PType>
 int base_impl<TType, PType>::is_invalid_impl(driver::Device const &, expression_tree const  &) const
 { return TEMPLATE_VALID; }
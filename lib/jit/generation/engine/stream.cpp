@@ -19,8 +19,10 @@
  * MA 02110-1301  USA
  */
 
+#include <algorithm>
+#include <vector>
+
 #include "isaac/jit/generation/engine/stream.h"
-#include "isaac/tools/cpp/string.hpp"
 
 namespace isaac
 {
@@ -43,11 +45,25 @@ int kernel_generation_stream::kgenstream::sync()
 kernel_generation_stream::kgenstream:: ~kgenstream()
 {  pubsync(); }
 
-void kernel_generation_stream::process(std::string& str)
+namespace
 {
 
-#define ADD_KEYWORD(NAME, OPENCL_NAME, CUDA_NAME) tools::find_and_replace(str, "$" + std::string(NAME), (backend_==driver::CUDA)?CUDA_NAME:OPENCL_NAME);
+struct keyword_type
+{
+  std::string name;
+  std::string opencl;
+  std::string cuda;
+};
 
+bool operator<(keyword_type const & x, keyword_type const & y)
+{ return x.name < y.name; }
+
+//Keywords sorted by name, so that candidates for a given token are contiguous
+std::vector<keyword_type> make_keywords()
+{
+  std::vector<keyword_type> result;
+
+#define ADD_KEYWORD(NAME, OPENCL_NAME, CUDA_NAME) result.push_back(keyword_type{NAME, OPENCL_NAME, CUDA_NAME});
 
 ADD_KEYWORD("GLOBAL_IDX_0", "get_global_id(0)", "(blockIdx.x*blockDim.x + threadIdx.x)")
 ADD_KEYWORD("GLOBAL_IDX_1", "get_global_id(1)", "(blockIdx.y*blockDim.y + threadIdx.y)")
@@ -85,6 +101,44 @@ ADD_KEYWORD("KERNEL", "__kernel", "extern \"C\" __global__")
 ADD_KEYWORD("MAD", "mad", "fma")
 
 #undef ADD_KEYWORD
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+}
+
+void kernel_generation_stream::process(std::string& str)
+{
+  static const std::vector<keyword_type> keywords = make_keywords();
+  std::string result;
+  result.reserve(str.size() + str.size()/4);
+  size_t last = 0;
+  for(size_t pos = str.find('$') ; pos != std::string::npos ; pos = str.find('$', last))
+  {
+    result.append(str, last, pos - last);
+    //Longest keyword starting at pos+1 (e.g., $LOCAL_IDX_0 over $LOCAL)
+    keyword_type const * match = NULL;
+    if(pos + 1 < str.size())
+    {
+      keyword_type first = {std::string(1, str[pos+1]), "", ""};
+      for(std::vector<keyword_type>::const_iterator it = std::lower_bound(keywords.begin(), keywords.end(), first) ; it != keywords.end() && it->name[0]==str[pos+1] ; ++it)
+        if((!match || it->name.size() > match->name.size()) && str.compare(pos + 1, it->name.size(), it->name)==0)
+          match = &*it;
+    }
+    if(match)
+    {
+      result += (backend_==driver::CUDA)?match->cuda:match->opencl;
+      last = pos + 1 + match->name.size();
+    }
+    else
+    {
+      result += '$';
+      last = pos + 1;
+    }
+  }
+  result.append(str, last, std::string::npos);
+  str.swap(result);
 }
 
 kernel_generation_stream::kernel_generation_stream(driver::backend_type backend) : std::ostream(new kgenstream(oss,tab_count_)), tab_count_(0), backend_(backend)
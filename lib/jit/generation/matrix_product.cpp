@@ -119,7 +119,13 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
     return TEMPLATE_VALID;
   }
 
-  std::string matrix_product::generate_impl(std::string const & suffix, expression_tree const & tree, driver::Device const & device, symbolic::symbols_table const &) const
+  std::string matrix_product::generate_impl(std::string const & suffix, expression_tree const & tree, driver::Device const & device, symbolic::symbols_table const & symbols) const
+  { return generate_kernel(suffix, tree, device, symbols, false); }
+
+  std::string matrix_product::specialize_impl(std::string const & suffix, expression_tree const & tree, driver::Device const & device, symbolic::symbols_table const & symbols) const
+  { return generate_kernel(suffix, tree, device, symbols, true); }
+
+  std::string matrix_product::generate_kernel(std::string const & suffix, expression_tree const & tree, driver::Device const & device, symbolic::symbols_table const & symbols, bool specialized) const
   {
     using std::string;
     using tools::to_string;
@@ -131,11 +137,21 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
 #define VSTORE(value, offset, ptr) vstore(p_.vwidth, sdtype, value, offset, ptr, "1", backend)
 
     symbolic::preset::matrix_product::args args;
-    infos(tree, args);
+    std::vector<int_t> MNK = infos(tree, args);
+    //Bounds checks are useless when the tiles divide the (constant) sizes
+    bool exact = specialized && !has_depth && MNK[0] % p_.mL == 0 && MNK[1] % p_.nL == 0 && MNK[2] % p_.kL == 0;
     std::string ASTRIDE1 = (args.A->ld[0] > 1)?"*Astride1":"";
     std::string BSTRIDE1 = (args.B->ld[0] > 1)?"*Bstride1":"";
     std::string CSTRIDE1 = (args.C->ld[0] > 1)?"*Cstride1":"";
 
+    //Fused epilogue, applied to the product before it is written to C
+    std::string epilogue_arguments;
+    if(args.fused)
+      for(std::string const & x: kernel_arguments(symbolic::extract<symbolic::object>(tree, symbols, args.epilogue, [&](size_t idx){ return idx!=args.product; })))
+        epilogue_arguments += ", " + x;
+    auto epilogue = [&](std::string const & value, std::string const & i, std::string const & j)
+    { return symbols.at(args.epilogue)->evaluate({{"matrix_product", value}, {"leaf", "at(" + i + ", " + j + ")"}}); };
+
     //////////////////
     /// INIT
     /// //////////////
@@ -167,11 +183,24 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
                                << sdtype << " alpha,"
                                << "$GLOBAL " << sdtype << "* A, $SIZE_T lda, $SIZE_T offa, $SIZE_T Astride1,"
                                << "$GLOBAL " << sdtype << "* B, $SIZE_T ldb, $SIZE_T offb, $SIZE_T Bstride1,"
-                               << sdtype << " beta)"
+                               << sdtype << " beta" << epilogue_arguments << ")"
                                << std::endl;
     stream << "{" << std::endl;
     stream.inc_tab();
 
+    if(specialized)
+    {
+      stream << "//sizes and strides" << std::endl;
+      stream << "M = " << MNK[0] << "; N = " << MNK[1] << "; K = " << MNK[2] << ";" << std::endl;
+      stream << "lda = " << args.A->ld[1] << "; Astride1 = " << args.A->ld[0] << ";" << std::endl;
+      stream << "ldb = " << args.B->ld[1] << "; Bstride1 = " << args.B->ld[0] << ";" << std::endl;
+      if(has_depth)
+        stream << "ldc = M; Cstride1 = 1;" << std::endl;
+      else
+        stream << "ldc = " << args.C->ld[1] << "; Cstride1 = " << args.C->ld[0] << ";" << std::endl;
+      stream << std::endl;
+    }
+
     ///Declare
     stream << "//blocks" << std::endl;
     stream << sdtype << " rC[" << p_.mS << "][" << p_.nS << "] = {{0}};" << std::endl;
@@ -284,17 +313,18 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
     stream << "}" << std::endl;
     stream << std::endl;
 
+    auto bounded = [&](std::string const & cond, std::string const & value){ return exact?value:Select(backend, cond, value, "0").get(); };
     for(unsigned int i = 0 ; i < npA ; i++ )
         if (A_trans_=='N')
-          stream << "Ai[" << i << "] += " << Select(backend, to_string(i*p_.lf0*p_.vwidth) + " < M", "(int)((idT.x + " + to_string(i*p_.lf0*p_.vwidth) + ")" + ASTRIDE1 + ")", "0") << ";" << std::endl;
+          stream << "Ai[" << i << "] += " << bounded(to_string(i*p_.lf0*p_.vwidth) + " < M", "(int)((idT.x + " + to_string(i*p_.lf0*p_.vwidth) + ")" + ASTRIDE1 + ")") << ";" << std::endl;
         else
-          stream << "Ai[" << i << "] += " << Select(backend, to_string(i*p_.lf1) + " < M", "(int)((idT.y + " + to_string(i*p_.lf1) + ")*lda)", "0") << ";" << std::endl;
+          stream << "Ai[" << i << "] += " << bounded(to_string(i*p_.lf1) + " < M", "(int)((idT.y + " + to_string(i*p_.lf1) + ")*lda)") << ";" << std::endl;
 
     for(unsigned int i = 0 ; i < npB ; i++ )
         if (B_trans_=='T')
-            stream << "Bi[" << i << "] += " << Select(backend, to_string(i*p_.lf0*p_.vwidth) + " < N", "(int)((idT.x + " + to_string(i*p_.lf0*p_.vwidth) + ")" + BSTRIDE1 + ")", "0") << ";" << std::endl;
+            stream << "Bi[" << i << "] += " << bounded(to_string(i*p_.lf0*p_.vwidth) + " < N", "(int)((idT.x + " + to_string(i*p_.lf0*p_.vwidth) + ")" + BSTRIDE1 + ")") << ";" << std::endl;
         else
-            stream << "Bi[" << i << "] += " << Select(backend, to_string(i*p_.lf1) + " < N", "(int)((idT.y + " + to_string(i*p_.lf1) + ")*ldb)", "0") << ";" << std::endl;
+            stream << "Bi[" << i << "] += " << bounded(to_string(i*p_.lf1) + " < N", "(int)((idT.y + " + to_string(i*p_.lf1) + ")*ldb)") << ";" << std::endl;
 
     stream << std::endl;
     stream << "//Outer loop" << std::endl;
@@ -470,21 +500,25 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
     stream << "}" << std::endl;
 
 
-    if(A_trans_=='N' || B_trans_=='T')
-    {
-        stream << "int Ky = K - idT.y;" << std::endl;
-        for(unsigned int k = 0; k < p_.kL; k += p_.lf1)
-            stream << "int condy" << k << " = " << k << " < Ky;" << std::endl;
-    }
-
-    if(A_trans_=='T' || B_trans_=='N')
+    //Remainder of K (empty when the tile divides K)
+    if(!exact)
     {
-        stream << "int Kx = K - idT.x;" << std::endl;
-        for(unsigned int k = 0 ; k < p_.kL ; k += p_.lf0*p_.vwidth)
-            for(unsigned int s = 0 ; s < p_.vwidth ; ++s)
-                stream << "int condx" << k + s << " = " << k + s << " < Kx;" << std::endl;
+      if(A_trans_=='N' || B_trans_=='T')
+      {
+          stream << "int Ky = K - idT.y;" << std::endl;
+          for(unsigned int k = 0; k < p_.kL; k += p_.lf1)
+              stream << "int condy" << k << " = " << k << " < Ky;" << std::endl;
+      }
+
+      if(A_trans_=='T' || B_trans_=='N')
+      {
+          stream << "int Kx = K - idT.x;" << std::endl;
+          for(unsigned int k = 0 ; k < p_.kL ; k += p_.lf0*p_.vwidth)
+              for(unsigned int s = 0 ; s < p_.vwidth ; ++s)
+                  stream << "int condx" << k + s << " = " << k + s << " < Kx;" << std::endl;
+      }
+      fetch_to_lds(true);
     }
-    fetch_to_lds(true);
 
     stream << "//Write back C" << std::endl;
     stream << "M += ids.x;" << std::endl;
@@ -506,6 +540,12 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
     if(has_depth)
         stream << "C += gidz*ldc*N;" << std::endl;
 
+    if(args.fused && !has_depth)
+    {
+        stream << "int i0 = ids.x + ids.z*" << p_.vwidth << ";" << std::endl;
+        stream << "int j0 = ids.y + ids.w*" << p_.vwidth << ";" << std::endl;
+    }
+
     stream << "M -= ids.x;" << std::endl;
     stream << "M -= ids.z*" << p_.vwidth << ";" << std::endl;
 
@@ -515,15 +555,20 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
     for(unsigned int n=0; n < p_.nS; ++n)
     {
         string Cj = to_string((n/p_.vwidth)*(p_.ls1*p_.vwidth) + n%p_.vwidth);
-        stream << "if(" << Cj << " >= N) return;" << std::endl;
-        for(unsigned int m=0; m < p_.mS; ++m)
-            stream << "rC[" << m << "][" << n << "] *= alpha;" << std::endl;
+        if(!exact)
+          stream << "if(" << Cj << " >= N) return;" << std::endl;
+        if(!args.fused)
+          for(unsigned int m=0; m < p_.mS; ++m)
+              stream << "rC[" << m << "][" << n << "] *= alpha;" << std::endl;
         for(unsigned int m=0; m < p_.mS; ++m)
         {
             string Ci = to_string((m/p_.vwidth)*(p_.ls0*p_.vwidth) + m%p_.vwidth);
-            stream << "if(" << Ci << "< M) ";
+            if(!exact)
+              stream << "if(" << Ci << "< M) ";
             if(has_depth)
                 stream << "C[" << Ci << CSTRIDE1 << "] = rC[" << m << "][" << n << "];" << std::endl;
+            else if(args.fused)
+                stream << "C[" << Ci << CSTRIDE1 << "] = " << epilogue("rC[" + to_string(m) + "][" + to_string(n) + "]", "i0 + " + Ci, "j0 + " + Cj) << ";" << std::endl;
             else
                 stream << "C[" << Ci << CSTRIDE1 << "] = rC[" << m << "][" << n << "] + ((beta != (" << sdtype << ")0)?(beta*" << "C[" << Ci << CSTRIDE1 << "]):0);" << std::endl;
         }
@@ -544,7 +589,7 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
       stream << "$KERNEL void reduce" << suffix << "($SIZE_T M, $SIZE_T N, $SIZE_T D, "
                                  << "$GLOBAL " << sdtype << "* Z, $SIZE_T Zld,"
                                  << "$GLOBAL " << sdtype << "* C, $SIZE_T ldc, $SIZE_T Cstart, $SIZE_T Cstride,"
-                                 << sdtype << " beta)"
+                                 << sdtype << " beta" << epilogue_arguments << ")"
                                  << std::endl;
       stream << "{" << std::endl;
       stream.inc_tab();
@@ -561,7 +606,10 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
       stream.inc_tab();
       stream << "acc += Z[i + j*Zld + k*Zld*N];" << std::endl;
       stream.dec_tab();
-      stream << "C[i*Cstride + j*ldc] = acc + ((beta != (" << sdtype << ")0)?(beta*C[i*Cstride + j*ldc]):0);" << std::endl;
+      if(args.fused)
+        stream << "C[i*Cstride + j*ldc] = " << epilogue("acc", "i", "j") << ";" << std::endl;
+      else
+        stream << "C[i*Cstride + j*ldc] = acc + ((beta != (" << sdtype << ")0)?(beta*C[i*Cstride + j*ldc]):0);" << std::endl;
       stream.dec_tab();
       stream << "}" << std::endl;
       stream.dec_tab();
@@ -577,12 +625,16 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
 #undef VST0RE
   }
 
-  void matrix_product::enqueue_block(driver::CommandQueue & queue, int_t M, int_t N, int_t K,
-                     expression_tree::node const & A, expression_tree::node const & B, expression_tree::node const & C,
-                     value_scalar const & alpha, value_scalar const & beta,
+  void matrix_product::enqueue_block(driver::CommandQueue & queue, int_t M, int_t N, int_t K, expression_tree const & tree, symbolic::preset::matrix_product::args const & args,
                      driver::Program const & program, std::string const & suffix, runtime::execution_options_type const & options)
   {
     using tools::align;
+    expression_tree::node const & A = *args.A, & B = *args.B, & C = *args.C;
+    auto set_epilogue_arguments = [&](driver::Kernel & kernel, unsigned int & current_arg)
+    {
+      if(args.fused)
+        symbolic::set_arguments(tree, args.epilogue, [&](size_t idx){ return idx!=args.product; }, kernel, current_arg, fusion_policy_);
+    };
 
     if(M==0 || N==0 || K==0)
       return;
@@ -601,7 +653,8 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
 
     unsigned int current_arg = 0;
 
-    driver::Buffer& workspace = driver::backend::workspaces::get(options.queue(queue.context()));
+    size_t workspace_size = (p_.depth > 1)?(size_t)M*N*p_.depth*size_of(C.dtype):0;
+    driver::Buffer& workspace = driver::backend::workspaces::get(options.queue(queue.context()), workspace_size);
     matrix_product.setSizeArg(current_arg++, M);
     matrix_product.setSizeArg(current_arg++, N);
     matrix_product.setSizeArg(current_arg++, K);
@@ -624,7 +677,7 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
     }
 
 
-    matrix_product.setArg(current_arg++, alpha);
+    matrix_product.setArg(current_arg++, args.alpha);
     if(backend==driver::OPENCL)
       matrix_product.setArg(current_arg++, A.array.handle.cl);
     else
@@ -641,7 +694,8 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
     matrix_product.setSizeArg(current_arg++, B.array.start);
     matrix_product.setSizeArg(current_arg++, B.ld[0]);
 
-    matrix_product.setArg(current_arg++, beta);
+    matrix_product.setArg(current_arg++, args.beta);
+    set_epilogue_arguments(matrix_product, current_arg);
     options.enqueue(program.context(), matrix_product, global, local);
 
     if(p_.depth > 1)
@@ -662,7 +716,8 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
       reduce.setSizeArg(current_arg++, C.ld[1]);
       reduce.setSizeArg(current_arg++, C.array.start);
       reduce.setSizeArg(current_arg++, C.ld[0]);
-      reduce.setArg(current_arg++, beta);
+      reduce.setArg(current_arg++, args.beta);
+      set_epilogue_arguments(reduce, current_arg);
       options.enqueue(program.context(), reduce, global, local);
     }
 
@@ -707,7 +762,7 @@ matrix_product_parameters::matrix_product_parameters(unsigned int vwidth
       return;
     //Enqueue
     runtime::execution_options_type const & options = control.execution_options();
-    enqueue_block(queue,  M, N, K, *args.A, *args.B, *args.C, args.alpha, args.beta, program, suffix, options);
+    enqueue_block(queue,  M, N, K, expressions, args, program, suffix, options);
   }
 
   //
@@ -287,11 +287,12 @@ void reduce_1d::enqueue(driver::CommandQueue & queue, driver::Program const & pr
   driver::NDRange global[2] = { driver::NDRange(p_.ls0*p_.num_groups), driver::NDRange(p_.ls0) };
   driver::NDRange local[2] = { driver::NDRange(p_.ls0), driver::NDRange(p_.ls0) };
   //Arguments
+  driver::Buffer & workspace = driver::backend::workspaces::get(queue, temporary_workspace(x)*size_of(x.dtype()));
   for (auto & kernel : kernels)
   {
     unsigned int n_arg = 0;
     kernel.setSizeArg(n_arg++, size);
-    kernel.setArg(n_arg++, driver::backend::workspaces::get(queue));
+    kernel.setArg(n_arg++, workspace);
     symbolic::set_arguments(x, kernel, n_arg, fusion_policy_);
   }
 
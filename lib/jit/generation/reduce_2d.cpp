@@ -313,6 +313,7 @@ void reduce_2d::enqueue(driver::CommandQueue & queue, driver::Program const & pr
   for(unsigned int k = 0 ; k < nk ; ++k)
     kernels.push_back(driver::Kernel(program, name[k].c_str()));
 
+  driver::Buffer & workspace = driver::backend::workspaces::get(queue, temporary_workspace(tree)*size_of(tree.dtype()));
   for(unsigned int k = 0 ; k < nk ; ++k)
   {
     driver::Kernel & kernel = kernels[k];
@@ -321,7 +322,7 @@ void reduce_2d::enqueue(driver::CommandQueue & queue, driver::Program const & pr
     int_t N = MN[1];
     kernel.setSizeArg(n_arg++, M);
     kernel.setSizeArg(n_arg++, N);
-    kernel.setArg(n_arg++, driver::backend::workspaces::get(queue)); //Temporary buffers
+    kernel.setArg(n_arg++, workspace); //Temporary buffers
     symbolic::set_arguments(tree, kernel, n_arg, fusion_policy_);
   }
 
@@ -34,10 +34,10 @@ namespace templates
 {
 
 //Generate
-inline std::vector<std::string> kernel_arguments(driver::Device const &, symbolic::symbols_table const & symbols, expression_tree const & expressions)
+inline std::vector<std::string> kernel_arguments(std::vector<symbolic::object*> const & objects)
 {
     std::vector<std::string> result;
-    for(symbolic::object* obj: symbolic::extract<symbolic::object>(expressions, symbols))
+    for(symbolic::object* obj: objects)
     {
       if(symbolic::host_scalar* sym = dynamic_cast<symbolic::host_scalar*>(obj))
         result.push_back(sym->process("#scalartype #name_value"));
@@ -57,6 +57,9 @@ inline std::vector<std::string> kernel_arguments(driver::Device const &, symboli
     return result;
 }
 
+inline std::vector<std::string> kernel_arguments(driver::Device const &, symbolic::symbols_table const & symbols, expression_tree const & expressions)
+{ return kernel_arguments(symbolic::extract<symbolic::object>(expressions, symbols)); }
+
 
 }
 }
@@ -20,7 +20,9 @@
  */
 
 #include <algorithm>
+#include <mutex>
 #include <tuple>
+#include <unordered_map>
 #include "isaac/jit/syntax/engine/macro.h"
 #include "isaac/tools/cpp/string.hpp"
 
@@ -30,55 +32,63 @@ namespace isaac
 namespace symbolic
 {
 
-macro::macro(std::string const & code): code_(code)
+std::shared_ptr<macro::pattern_type const> macro::compile(std::string const & code)
 {
-  size_t pos_po = code_.find('(');
-  size_t pos_pe = code_.find(')');
-  name_ = code.substr(0, pos_po);
-  args_ = tools::split(code.substr(pos_po + 1, pos_pe - pos_po - 1), ',');
-  tokens_ = tools::tokenize(code_.substr(code_.find(":") + 1), "()[],*+/-=>< ");
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<pattern_type const> > cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<pattern_type const> & result = cache[code];
+  if(result)
+    return result;
+
+  std::shared_ptr<pattern_type> pattern(new pattern_type());
+  size_t pos_po = code.find('(');
+  size_t pos_pe = code.find(')');
+  pattern->name = code.substr(0, pos_po);
+  std::vector<std::string> args = tools::split(code.substr(pos_po + 1, pos_pe - pos_po - 1), ',');
+  pattern->nargs = args.size();
+  std::vector<std::string> tokens = tools::tokenize(code.substr(code.find(":") + 1), "()[],*+/-=>< ");
+  for(std::string const & token: tokens)
+  {
+    int arg = (int)(std::find(args.begin(), args.end(), token) - args.begin());
+    if(arg < (int)args.size())
+      pattern->fragments.push_back(pattern_type::fragment{arg, ""});
+    else if(pattern->fragments.empty() || pattern->fragments.back().arg >= 0)
+      pattern->fragments.push_back(pattern_type::fragment{-1, token});
+    else
+      pattern->fragments.back().text += token;
+  }
+  result = pattern;
+  return result;
 }
 
-macro::macro(const char *code) : macro(std::string(code))
+macro::macro(std::string const & code): pattern_(compile(code))
 {
-
 }
 
-int macro::expand(std::string & str) const
+macro::macro(const char *code) : macro(std::string(code))
 {
-  size_t pos = 0;
-  size_t num_touched = 0;
-  while((pos=str.find(name_ + "(", pos==0?0:pos + 1))!=std::string::npos){
-    size_t pos_po = str.find('(', pos);
-    size_t pos_pe = str.find(')', pos_po);
-    size_t next = str.find('(', pos_po + 1);
-    while(next < pos_pe){
-      pos_pe = str.find(')', pos_pe + 1);
-      if(next < pos_pe)
-        next = str.find('(', next + 1);
-    }
 
-    std::vector<std::string> args = tools::split(str.substr(pos_po + 1, pos_pe - pos_po - 1), ',');
-    if(args_.size() != args.size()){
-      pos = pos_pe;
-      continue;
-    }
+}
 
-    //Process
-    std::vector<std::string> tokens = tokens_;
-    for(size_t i = 0 ; i < args_.size() ; ++i)
-      std::replace(tokens.begin(), tokens.end(), args_[i], args[i]);
+std::string const & macro::name() const
+{ return pattern_->name; }
 
-    //Replace
-    str.replace(pos, pos_pe + 1 - pos, tools::join(tokens.begin(), tokens.end(), ""));
-    num_touched++;
-  }
-  return num_touched;
+size_t macro::nargs() const
+{ return pattern_->nargs; }
+
+void macro::render(range_type const * args, std::string & out) const
+{
+  for(pattern_type::fragment const & f: pattern_->fragments)
+    if(f.arg < 0)
+      out += f.text;
+    else
+      out.append(args[f.arg].first, args[f.arg].second);
 }
 
 bool macro::operator<(macro const & o) const
 {
-  return std::make_tuple(name_, args_.size()) < std::make_tuple(o.name_, o.args_.size());
+  return std::make_tuple(pattern_->name, pattern_->nargs) < std::make_tuple(o.pattern_->name, o.pattern_->nargs);
 }
 
 }
@@ -19,6 +19,8 @@
  * MA 02110-1301  USA
  */
 
+#include <algorithm>
+#include <cctype>
 #include <string>
 
 #include "isaac/array.h"
@@ -74,20 +76,95 @@ object::object(driver::Context const & context, std::string const & scalartype,
 object::~object()
 {}
 
+static bool is_identifier(char c)
+{ return std::isalnum(c) || c=='_'; }
+
+//Macros and attributes are expanded in a single left-to-right pass. The body of
+//a macro call is rendered, then processed in turn before it is appended
+void object::process(char const * begin, char const * end, std::string & out) const
+{
+  static const size_t max_args = 8;
+  macro::range_type args[max_args];
+  char const * it = begin;
+  while(it < end)
+  {
+    //Attributes: the longest attribute name following '#'
+    if(*it=='#')
+    {
+      char const * last = it + 1;
+      while(last < end && is_identifier(*last))
+        ++last;
+      std::map<std::string, std::string>::const_iterator found = attributes_.end();
+      for(auto attr = attributes_.begin() ; attr != attributes_.end() ; ++attr)
+        if(attr->first.size() <= (size_t)(last - it - 1) && std::equal(attr->first.begin(), attr->first.end(), it + 1)
+           && (found==attributes_.end() || attr->first.size() > found->first.size()))
+          found = attr;
+      if(found != attributes_.end())
+      {
+        out += found->second;
+        it += 1 + found->first.size();
+      }
+      else
+        out += *it++;
+      continue;
+    }
+    if(!is_identifier(*it))
+    {
+      out += *it++;
+      continue;
+    }
+    //Identifiers: a macro call when followed by a balanced list of arguments of the macro's arity
+    char const * last = it;
+    while(last < end && is_identifier(*last))
+      ++last;
+    macro const * call = NULL;
+    char const * close = NULL;
+    if(!std::isdigit(*it) && last < end && *last=='(')
+    {
+      size_t nargs = 0;
+      int depth = 0;
+      char const * arg = last + 1;
+      for(close = last ; close < end ; ++close)
+      {
+        if(*close=='(' && depth++ > 0) continue;
+        if(*close==')' && --depth > 0) continue;
+        if((*close==',' && depth==1) || depth==0)
+        {
+          if(nargs < max_args)
+            args[nargs] = macro::range_type(arg, close);
+          if(depth > 0 || close > last + 1)
+            nargs++;
+          arg = close + 1;
+        }
+        if(depth==0)
+          break;
+      }
+      if(close < end && nargs <= max_args)
+        for(macro const & m: macros_)
+          if(m.nargs()==nargs && m.name().size()==(size_t)(last - it) && std::equal(m.name().begin(), m.name().end(), it))
+            call = &m;
+    }
+    if(call)
+    {
+      std::string body;
+      call->render(args, body);
+      process(body.data(), body.data() + body.size(), out);
+      it = close + 1;
+    }
+    else
+    {
+      out.append(it, last);
+      it = last;
+    }
+  }
+}
+
 std::string object::process(std::string const & in) const
 {
-  std::string res = in;
-  //Macros
-  bool modified;
-  do{
-    modified = false;
-    for (auto const & key : macros_)
-      modified = modified || key.expand(res);
-  }while(modified);
-  //Attributes
-  for (auto const & key : attributes_)
-    tools::find_and_replace(res, "#" + key.first, key.second);
-  return res;
+  std::string result;
+  result.reserve(in.size());
+  process(in.data(), in.data() + in.size(), result);
+  return result;
 }
 
 bool object::hasattr(std::string const & name) const
@@ -178,6 +255,11 @@ reduce_1d::reduce_1d(unsigned int id, size_t root, op_element op, expression_tre
 reduce_2d::reduce_2d(unsigned int id, size_t root, op_element op, expression_tree const & tree, symbols_table const & table) : reduction(id, root, op, tree, table)
 { add_base("reduce_2d"); }
 
+//
+matrix_product::matrix_product(unsigned int id, size_t root, op_element op, expression_tree const & tree, symbols_table const & table) :
+  object(tree.context(), to_string(tree[root].dtype), id), node(root, op, tree, table)
+{ add_base("matrix_product"); }
+
 //
 placeholder::placeholder(driver::Context const & context, unsigned int level) : leaf(context, "int", "sforidx" + tools::to_string(level))
 {
@@ -65,38 +65,50 @@ std::vector<size_t> rhs_of(expression_tree const & tree, std::vector<size_t> con
 
 
 // Hash
-std::string hash(expression_tree const & tree)
+std::string fingerprint(expression_tree const & tree)
 {
   driver::backend_type backend = tree.context().backend();
 
-  char program_name[256];
-  char* ptr = program_name;
+  std::string result;
   bind_independent binder(backend);
 
-  auto hash_impl = [&](size_t idx)
+  auto fingerprint_impl = [&](size_t idx)
   {
     expression_tree::node const & node = tree.data()[idx];
+    tools::append(result, node.type);
     if(node.type==DENSE_ARRAY_TYPE)
     {
+      uint64_t shape = node.shape.size();
       for(size_t i = 0 ; i < node.shape.size() ; ++i)
-        *ptr++= node.shape[i]>1?'n':'1';
-      if(node.ld[0]>1) *ptr++= 's';
-      *ptr++=(char)node.dtype;
-      tools::fast_append(ptr, binder.get(node.array.handle, false));
+        shape = (shape << 1) | (node.shape[i]>1);
+      tools::append(result, shape);
+      tools::append(result, node.ld[0]>1);
+      tools::append(result, node.dtype);
+      tools::append(result, binder.get(node.array.handle, false));
     }
+    else if(node.type==VALUE_SCALAR_TYPE)
+      tools::append(result, node.dtype);
     else if(node.type==COMPOSITE_OPERATOR_TYPE)
-      tools::fast_append(ptr,node.binary_operator.op.type);
+      tools::append(result, node.binary_operator.op.type);
   };
 
-  traverse(tree, hash_impl);
+  traverse(tree, fingerprint_impl);
 
-  *ptr='\0';
+  return result;
+}
 
-  return std::string(program_name);
+uint64_t hash(expression_tree const & tree)
+{
+  return tools::hash(fingerprint(tree));
 }
 
 //Set arguments
 void set_arguments(expression_tree const & tree, driver::Kernel & kernel, unsigned int & current_arg, fusion_policy_t fusion_policy)
+{
+  set_arguments(tree, tree.root(), [](size_t){ return true; }, kernel, current_arg, fusion_policy);
+}
+
+void set_arguments(expression_tree const & tree, size_t root, std::function<bool(size_t)> const & recurse, driver::Kernel & kernel, unsigned int & current_arg, fusion_policy_t fusion_policy)
 {
   driver::backend_type backend = tree.context().backend();
 
@@ -158,7 +170,7 @@ void set_arguments(expression_tree const & tree, driver::Kernel & kernel, unsign
 
 
   //Traverse
-  traverse(tree, set_arguments_impl);
+  traverse(tree, root, set_arguments_impl, recurse);
 }
 
 //Symbolize
@@ -220,6 +232,9 @@ symbols_table symbolize(fusion_policy_t fusion_policy, isaac::expression_tree co
       //2D reduction
       else if (op.type_family==REDUCE_ROWS || op.type_family==REDUCE_COLUMNS)
         table.insert({root, make_symbolic<reduce_2d>(id, root, op, tree, table)});
+      //Matrix product
+      else if (op.type_family==MATRIX_PRODUCT)
+        table.insert({root, make_symbolic<matrix_product>(id, root, op, tree, table)});
     }
   };
 
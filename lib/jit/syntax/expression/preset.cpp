@@ -19,6 +19,8 @@
  * MA 02110-1301  USA
  */
 
+#include <cstring>
+
 #include "isaac/jit/syntax/expression/preset.h"
 
 namespace isaac
@@ -74,6 +76,73 @@ void matrix_product::handle_node(expression_tree::data_type const & tree, size_t
     }
 }
 
+//Whether two arrays live in the same buffer
+static bool shares_buffer(expression_tree::node const & x, expression_tree::node const & y)
+{
+    return std::memcmp(&x.array.handle, &y.array.handle, sizeof(handle_t))==0;
+}
+
+bool reads_other_view(expression_tree::data_type const & tree, size_t root, expression_tree::node const & C)
+{
+    expression_tree::node const & node = tree[root];
+    switch(node.type)
+    {
+      case DENSE_ARRAY_TYPE:
+        return shares_buffer(node, C) && (node.array.start!=C.array.start || !(node.shape==C.shape) || !(node.ld==C.ld));
+      case COMPOSITE_OPERATOR_TYPE:
+      {
+        op_element const & op = node.binary_operator.op;
+        expression_tree::node const & x = tree[node.binary_operator.lhs];
+        if((op.type==RESHAPE_TYPE || op.type==TRANS_TYPE) && x.type==DENSE_ARRAY_TYPE)
+          return shares_buffer(x, C);
+        return reads_other_view(tree, node.binary_operator.lhs, C) || reads_other_view(tree, node.binary_operator.rhs, C);
+      }
+      default:
+        return false;
+    }
+}
+
+bool matrix_product::handle_epilogue(expression_tree::data_type const & tree, size_t root, tuple const & shape, std::vector<size_t> & products)
+{
+    expression_tree::node const & node = tree[root];
+    //Operands are broadcast to the shape of C
+    auto broadcasts = [&](tuple const & x){
+      if(x.size()!=shape.size())
+        return false;
+      for(size_t i = 0 ; i < x.size() ; ++i)
+        if(x[i]!=shape[i] && x[i]!=1)
+          return false;
+      return true;
+    };
+    switch(node.type)
+    {
+      case INVALID_SUBTYPE:
+      case VALUE_SCALAR_TYPE:
+        return true;
+      case DENSE_ARRAY_TYPE:
+        return broadcasts(node.shape);
+      case COMPOSITE_OPERATOR_TYPE:
+      {
+        op_element const & op = node.binary_operator.op;
+        if(op.type_family==MATRIX_PRODUCT)
+        {
+          products.push_back(root);
+          return node.shape==shape;
+        }
+        if(op.type==RESHAPE_TYPE || op.type==TRANS_TYPE)
+          return tree[node.binary_operator.lhs].type==DENSE_ARRAY_TYPE && broadcasts(node.shape);
+        if(op.type_family!=UNARY_ARITHMETIC && op.type_family!=BINARY_ARITHMETIC)
+          return false;
+        if(is_assignment(op.type) || is_indexing(op.type) || op.type==ACCESS_INDEX_TYPE)
+          return false;
+        return handle_epilogue(tree, node.binary_operator.lhs, shape, products)
+            && handle_epilogue(tree, node.binary_operator.rhs, shape, products);
+      }
+      default:
+        return false;
+    }
+}
+
 matrix_product::args matrix_product::check(expression_tree::data_type const & tree, size_t root)
 {
     expression_tree::node const & node = tree[root];
@@ -121,6 +190,29 @@ matrix_product::args matrix_product::check(expression_tree::data_type const & tr
         result.C = &left;
     else if(result.C != &left)
         result.C = NULL;
+
+    //Form C = f(dot(A,B), X, ...). Other views of C could read elements that other work-groups have
+    //already written back, so the unfused path is used instead
+    std::vector<size_t> products;
+    if(!result && node.binary_operator.op.type==ASSIGN_TYPE && left.type==DENSE_ARRAY_TYPE
+       && handle_epilogue(tree, node.binary_operator.rhs, left.shape, products) && products.size()==1
+       && !reads_other_view(tree, node.binary_operator.rhs, left))
+    {
+        expression_tree::node const & product = tree[products[0]];
+        expression_tree::node const & A = tree[product.binary_operator.lhs];
+        expression_tree::node const & B = tree[product.binary_operator.rhs];
+        if(A.type==DENSE_ARRAY_TYPE && B.type==DENSE_ARRAY_TYPE && !shares_buffer(A, left) && !shares_buffer(B, left))
+        {
+            result = matrix_product::args();
+            handle_node(tree, products[0], result);
+            result.alpha = value_scalar(1, dtype);
+            result.beta = value_scalar(0, dtype);
+            result.C = &left;
+            result.fused = true;
+            result.epilogue = node.binary_operator.rhs;
+            result.product = products[0];
+        }
+    }
     return result;
 }
 
@@ -19,6 +19,7 @@
  * MA 02110-1301  USA
  */
 
+#include <algorithm>
 #include <assert.h>
 #include <list>
 #include <vector>
@@ -26,9 +27,13 @@
 #include "isaac/types.h"
 #include "isaac/array.h"
 #include "isaac/runtime/inference/profiles.h"
+#include "isaac/common/instrumentation.h"
 #include "isaac/runtime/execute.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/event.h"
 #include "isaac/jit/syntax/expression/expression.h"
 #include "isaac/jit/syntax/expression/preset.h"
+#include "isaac/jit/syntax/engine/process.h"
 
 namespace isaac
 {
@@ -128,14 +133,39 @@ namespace runtime
   }
 
   /** @brief Executes a expression_tree on the given models map*/
-  void execute(execution_handler const & c, profiles::map_type & profiles)
+  void execute(execution_handler const & handler, profiles::map_type const & profiles)
   {
     typedef isaac::array array;
-    expression_tree tree = c.x();
+    expression_tree tree = handler.x();
     /*----Optimize----*/
 //    detail::optimize(tree);
     /*----Process-----*/
     driver::Context const & context = tree.context();
+    /*----Dependencies across queues-----*/
+    execution_options_type options = handler.execution_options();
+    driver::CommandQueue & queue = options.queue(context);
+    bool track = driver::backend::accesses::enabled(context);
+    std::vector<uintptr_t> reads, writes;
+    std::vector<driver::Event> dependencies;
+    std::list<driver::Event> events;
+    if(track)
+    {
+      auto key = [&](expression_tree::node const & node){ return (context.backend()==driver::OPENCL)?(uintptr_t)node.array.handle.cl:(uintptr_t)node.array.handle.cu; };
+      //Arrays on the left-hand side of an assignment are written
+      for(expression_tree::node const & node: tree.data())
+        if(node.type==COMPOSITE_OPERATOR_TYPE && is_assignment(node.binary_operator.op.type))
+          symbolic::traverse(tree, node.binary_operator.lhs, [&](size_t idx){ if(tree[idx].type==DENSE_ARRAY_TYPE) writes.push_back(key(tree[idx])); });
+      for(expression_tree::node const & node: tree.data())
+        if(node.type==DENSE_ARRAY_TYPE && std::find(writes.begin(), writes.end(), key(node))==writes.end())
+          reads.push_back(key(node));
+      if(options.dependencies)
+        dependencies = *options.dependencies;
+      track = driver::backend::accesses::dependencies(queue, reads, writes, dependencies);
+      options.dependencies = &dependencies;
+      if(track && !options.events)
+        options.events = &events;
+    }
+    execution_handler c(handler.x(), options, handler.dispatcher_options(), handler.compilation_options());
     size_t rootidx = tree.root();
     std::vector<std::shared_ptr<array> > temporaries;
     expression_type final_type;
@@ -154,6 +184,10 @@ namespace runtime
         breakpoints.reserve(16);
         /*----Parse required temporaries-----*/
         final_type = detail::parse(tree, breakpoints);
+        //Work-items would overwrite elements that others still read through another view of the left-hand side
+        if(detail::is_elementwise(final_type) && root.binary_operator.op.type==ASSIGN_TYPE && lhs.type==DENSE_ARRAY_TYPE
+           && symbolic::preset::reads_other_view(tree.data(), root.binary_operator.rhs, lhs))
+          breakpoints.push_back({root.binary_operator.rhs, final_type});
         std::set<size_t> found;
         breakpoints.erase(std::remove_if(breakpoints.begin(), breakpoints.end(), [&](detail::breakpoints_t::value_type const & x){return !found.insert(x.first).second;}), breakpoints.end());
         /*----Compute required temporaries----*/
@@ -161,7 +195,7 @@ namespace runtime
         {
           expression_tree::node const & node = tree[current.first];
           expression_type type = current.second;
-          std::shared_ptr<profiles::value_type> const & profile = profiles[std::make_pair(type, node.dtype)];
+          std::shared_ptr<profiles::value_type> const & profile = profiles.at(std::make_pair(type, node.dtype));
 
           //Create temporary
           std::shared_ptr<array> tmp = std::make_shared<array>(node.shape, node.dtype, context);
@@ -173,6 +207,7 @@ namespace runtime
           root.dtype = node.dtype;
           lhs = expression_tree::node(*tmp);
           rhs = node;
+          instrumentation::dispatch(type);
           profile->execute(execution_handler(tree, c.execution_options(), c.dispatcher_options(), c.compilation_options()));
           //Update the expression tree
           root = root_save;
@@ -183,12 +218,15 @@ namespace runtime
     }
 
     /*-----Compute final expression-----*/
-    profiles[std::make_pair(final_type, tree[rootidx].dtype)]->execute(execution_handler(tree, c.execution_options(), c.dispatcher_options(), c.compilation_options()));
+    instrumentation::dispatch(final_type);
+    profiles.at(std::make_pair(final_type, tree[rootidx].dtype))->execute(execution_handler(tree, c.execution_options(), c.dispatcher_options(), c.compilation_options()));
+    if(track && !options.events->empty())
+      driver::backend::accesses::record(queue, reads, writes, options.events->back());
   }
 
   void execute(execution_handler const & c)
   {
-    execute(c, profiles::get(c.execution_options().queue(c.x().context())));
+    execute(c, *profiles::get(c.execution_options().queue(c.x().context())));
   }
 
 }
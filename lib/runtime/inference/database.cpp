@@ -24,6 +24,7 @@
 
 //Default
 #include "database/unknown/unknown.hpp"
+#include "database/unknown/cpu.hpp"
 
 //Intel
 #include "database/intel/broadwell.hpp"
@@ -50,6 +51,7 @@ const profiles::presets_type profiles::presets_ =
 {
     //DEFAULT
     DATABASE_ENTRY(UNKNOWN, UNKNOWN, UNKNOWN, database::unknown::unknown),
+    DATABASE_ENTRY(CPU, UNKNOWN, UNKNOWN, database::unknown::cpu),
     //INTEL
     DATABASE_ENTRY(GPU, INTEL, BROADWELL, database::intel::broadwell),
     //NVIDIA
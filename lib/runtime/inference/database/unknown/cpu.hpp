@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+
+namespace isaac
+{
+namespace database
+{
+namespace unknown
+{
+
+static const char cpu[] = {
+0x7b,	0x22,	0x76,	0x65,	0x72,	0x73,	0x69,	0x6f,	0x6e,	0x22,	
+0x3a,	0x20,	0x22,	0x31,	0x2e,	0x30,	0x22,	0x2c,	0x20,	0x22,	
+0x65,	0x6c,	0x65,	0x6d,	0x65,	0x6e,	0x74,	0x77,	0x69,	0x73,	
+0x65,	0x5f,	0x31,	0x64,	0x22,	0x3a,	0x20,	0x7b,	0x22,	0x66,	
+0x6c,	0x6f,	0x61,	0x74,	0x33,	0x32,	0x22,	0x3a,	0x20,	0x7b,	
+0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	0x73,	0x22,	
+0x3a,	0x20,	0x5b,	0x5b,	0x34,	0x2c,	0x20,	0x31,	0x36,	0x2c,	
+0x20,	0x36,	0x34,	0x2c,	0x20,	0x31,	0x5d,	0x5d,	0x7d,	0x2c,	
+0x20,	0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	0x36,	0x34,	0x22,	
+0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	
+0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x32,	0x2c,	0x20,	
+0x31,	0x36,	0x2c,	0x20,	0x36,	0x34,	0x2c,	0x20,	0x31,	0x5d,	
+0x5d,	0x7d,	0x7d,	0x2c,	0x20,	0x22,	0x72,	0x65,	0x64,	0x75,	
+0x63,	0x65,	0x5f,	0x31,	0x64,	0x22,	0x3a,	0x20,	0x7b,	0x22,	
+0x66,	0x6c,	0x6f,	0x61,	0x74,	0x33,	0x32,	0x22,	0x3a,	0x20,	
+0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	0x73,	
+0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x34,	0x2c,	0x20,	0x31,	0x36,	
+0x2c,	0x20,	0x36,	0x34,	0x2c,	0x20,	0x31,	0x5d,	0x5d,	0x7d,	
+0x2c,	0x20,	0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	0x36,	0x34,	
+0x22,	0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	
+0x6c,	0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x32,	0x2c,	
+0x20,	0x31,	0x36,	0x2c,	0x20,	0x36,	0x34,	0x2c,	0x20,	0x31,	
+0x5d,	0x5d,	0x7d,	0x7d,	0x2c,	0x20,	0x22,	0x65,	0x6c,	0x65,	
+0x6d,	0x65,	0x6e,	0x74,	0x77,	0x69,	0x73,	0x65,	0x5f,	0x32,	
+0x64,	0x22,	0x3a,	0x20,	0x7b,	0x22,	0x66,	0x6c,	0x6f,	0x61,	
+0x74,	0x33,	0x32,	0x22,	0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	
+0x6f,	0x66,	0x69,	0x6c,	0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	
+0x5b,	0x31,	0x2c,	0x20,	0x31,	0x36,	0x2c,	0x20,	0x34,	0x2c,	
+0x20,	0x38,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	0x5d,	0x5d,	
+0x7d,	0x2c,	0x20,	0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	0x36,	
+0x34,	0x22,	0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	
+0x69,	0x6c,	0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x31,	
+0x2c,	0x20,	0x31,	0x36,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x38,	
+0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	0x5d,	0x5d,	0x7d,	0x7d,	
+0x2c,	0x20,	0x22,	0x72,	0x65,	0x64,	0x75,	0x63,	0x65,	0x5f,	
+0x32,	0x64,	0x5f,	0x72,	0x6f,	0x77,	0x73,	0x22,	0x3a,	0x20,	
+0x7b,	0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	0x33,	0x32,	0x22,	
+0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	
+0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x31,	0x2c,	0x20,	
+0x31,	0x36,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x31,	0x2c,	0x20,	
+0x36,	0x34,	0x2c,	0x20,	0x31,	0x5d,	0x5d,	0x7d,	0x2c,	0x20,	
+0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	0x36,	0x34,	0x22,	0x3a,	
+0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	
+0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x31,	0x2c,	0x20,	0x31,	
+0x36,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x31,	0x2c,	0x20,	0x36,	
+0x34,	0x2c,	0x20,	0x31,	0x5d,	0x5d,	0x7d,	0x7d,	0x2c,	0x20,	
+0x22,	0x72,	0x65,	0x64,	0x75,	0x63,	0x65,	0x5f,	0x32,	0x64,	
+0x5f,	0x63,	0x6f,	0x6c,	0x73,	0x22,	0x3a,	0x20,	0x7b,	0x22,	
+0x66,	0x6c,	0x6f,	0x61,	0x74,	0x33,	0x32,	0x22,	0x3a,	0x20,	
+0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	0x73,	
+0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x31,	0x2c,	0x20,	0x31,	0x36,	
+0x2c,	0x20,	0x34,	0x2c,	0x20,	0x31,	0x2c,	0x20,	0x36,	0x34,	
+0x2c,	0x20,	0x31,	0x5d,	0x5d,	0x7d,	0x2c,	0x20,	0x22,	0x66,	
+0x6c,	0x6f,	0x61,	0x74,	0x36,	0x34,	0x22,	0x3a,	0x20,	0x7b,	
+0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	0x73,	0x22,	
+0x3a,	0x20,	0x5b,	0x5b,	0x31,	0x2c,	0x20,	0x31,	0x36,	0x2c,	
+0x20,	0x34,	0x2c,	0x20,	0x31,	0x2c,	0x20,	0x36,	0x34,	0x2c,	
+0x20,	0x31,	0x5d,	0x5d,	0x7d,	0x7d,	0x2c,	0x20,	0x22,	0x6d,	
+0x61,	0x74,	0x72,	0x69,	0x78,	0x5f,	0x70,	0x72,	0x6f,	0x64,	
+0x75,	0x63,	0x74,	0x5f,	0x6e,	0x6e,	0x22,	0x3a,	0x20,	0x7b,	
+0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	0x33,	0x32,	0x22,	0x3a,	
+0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	
+0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x34,	0x2c,	0x20,	0x38,	
+0x2c,	0x20,	0x31,	0x36,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	
+0x2c,	0x20,	0x38,	0x2c,	0x20,	0x32,	0x2c,	0x20,	0x38,	0x2c,	
+0x20,	0x30,	0x2c,	0x20,	0x30,	0x2c,	0x20,	0x34,	0x2c,	0x20,	
+0x31,	0x36,	0x5d,	0x5d,	0x7d,	0x2c,	0x20,	0x22,	0x66,	0x6c,	
+0x6f,	0x61,	0x74,	0x36,	0x34,	0x22,	0x3a,	0x20,	0x7b,	0x22,	
+0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	0x73,	0x22,	0x3a,	
+0x20,	0x5b,	0x5b,	0x32,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	
+0x36,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	0x2c,	0x20,	0x34,	
+0x2c,	0x20,	0x32,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x30,	0x2c,	
+0x20,	0x30,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x31,	0x36,	0x5d,	
+0x5d,	0x7d,	0x7d,	0x2c,	0x20,	0x22,	0x6d,	0x61,	0x74,	0x72,	
+0x69,	0x78,	0x5f,	0x70,	0x72,	0x6f,	0x64,	0x75,	0x63,	0x74,	
+0x5f,	0x74,	0x6e,	0x22,	0x3a,	0x20,	0x7b,	0x22,	0x66,	0x6c,	
+0x6f,	0x61,	0x74,	0x33,	0x32,	0x22,	0x3a,	0x20,	0x7b,	0x22,	
+0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	0x73,	0x22,	0x3a,	
+0x20,	0x5b,	0x5b,	0x34,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	
+0x36,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	0x2c,	0x20,	0x38,	
+0x2c,	0x20,	0x32,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x30,	0x2c,	
+0x20,	0x30,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x31,	0x36,	0x5d,	
+0x5d,	0x7d,	0x2c,	0x20,	0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	
+0x36,	0x34,	0x22,	0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	
+0x66,	0x69,	0x6c,	0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	
+0x32,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	0x36,	0x2c,	0x20,	
+0x38,	0x2c,	0x20,	0x31,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x32,	
+0x2c,	0x20,	0x34,	0x2c,	0x20,	0x30,	0x2c,	0x20,	0x30,	0x2c,	
+0x20,	0x34,	0x2c,	0x20,	0x31,	0x36,	0x5d,	0x5d,	0x7d,	0x7d,	
+0x2c,	0x20,	0x22,	0x6d,	0x61,	0x74,	0x72,	0x69,	0x78,	0x5f,	
+0x70,	0x72,	0x6f,	0x64,	0x75,	0x63,	0x74,	0x5f,	0x6e,	0x74,	
+0x22,	0x3a,	0x20,	0x7b,	0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	
+0x33,	0x32,	0x22,	0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	
+0x66,	0x69,	0x6c,	0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	
+0x34,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	0x36,	0x2c,	0x20,	
+0x38,	0x2c,	0x20,	0x31,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x32,	
+0x2c,	0x20,	0x38,	0x2c,	0x20,	0x30,	0x2c,	0x20,	0x30,	0x2c,	
+0x20,	0x34,	0x2c,	0x20,	0x31,	0x36,	0x5d,	0x5d,	0x7d,	0x2c,	
+0x20,	0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	0x36,	0x34,	0x22,	
+0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	
+0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x32,	0x2c,	0x20,	
+0x38,	0x2c,	0x20,	0x31,	0x36,	0x2c,	0x20,	0x38,	0x2c,	0x20,	
+0x31,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x32,	0x2c,	0x20,	0x34,	
+0x2c,	0x20,	0x30,	0x2c,	0x20,	0x30,	0x2c,	0x20,	0x34,	0x2c,	
+0x20,	0x31,	0x36,	0x5d,	0x5d,	0x7d,	0x7d,	0x2c,	0x20,	0x22,	
+0x6d,	0x61,	0x74,	0x72,	0x69,	0x78,	0x5f,	0x70,	0x72,	0x6f,	
+0x64,	0x75,	0x63,	0x74,	0x5f,	0x74,	0x74,	0x22,	0x3a,	0x20,	
+0x7b,	0x22,	0x66,	0x6c,	0x6f,	0x61,	0x74,	0x33,	0x32,	0x22,	
+0x3a,	0x20,	0x7b,	0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	
+0x65,	0x73,	0x22,	0x3a,	0x20,	0x5b,	0x5b,	0x34,	0x2c,	0x20,	
+0x38,	0x2c,	0x20,	0x31,	0x36,	0x2c,	0x20,	0x38,	0x2c,	0x20,	
+0x31,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x32,	0x2c,	0x20,	0x38,	
+0x2c,	0x20,	0x30,	0x2c,	0x20,	0x30,	0x2c,	0x20,	0x34,	0x2c,	
+0x20,	0x31,	0x36,	0x5d,	0x5d,	0x7d,	0x2c,	0x20,	0x22,	0x66,	
+0x6c,	0x6f,	0x61,	0x74,	0x36,	0x34,	0x22,	0x3a,	0x20,	0x7b,	
+0x22,	0x70,	0x72,	0x6f,	0x66,	0x69,	0x6c,	0x65,	0x73,	0x22,	
+0x3a,	0x20,	0x5b,	0x5b,	0x32,	0x2c,	0x20,	0x38,	0x2c,	0x20,	
+0x31,	0x36,	0x2c,	0x20,	0x38,	0x2c,	0x20,	0x31,	0x2c,	0x20,	
+0x34,	0x2c,	0x20,	0x32,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x30,	
+0x2c,	0x20,	0x30,	0x2c,	0x20,	0x34,	0x2c,	0x20,	0x31,	0x36,	
+0x5d,	0x5d,	0x7d,	0x7d,	0x7d,	0x0};
+
+static const std::size_t cpu_len = 1206;
+
+}
+}
+}
@@ -23,10 +23,15 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <limits>
+#include <chrono>
+#include <functional>
+#include <mutex>
 
 #include "rapidjson/document.h"
 #include "rapidjson/to_array.hpp"
 
+#include "isaac/driver/backend.h"
 #include "isaac/driver/program_cache.h"
 #include "isaac/runtime/inference/profiles.h"
 #include "isaac/jit/generation/elementwise_1d.h"
@@ -35,9 +40,12 @@
 #include "isaac/jit/generation/reduce_2d.h"
 #include "isaac/jit/generation/matrix_product.h"
 #include "isaac/exception/api.h"
+#include "isaac/common/instrumentation.h"
 #include "isaac/jit/syntax/engine/process.h"
 #include "isaac/tools/sys/getenv.hpp"
+#include "isaac/tools/sys/thread_pool.hpp"
 #include "isaac/tools/cpp/string.hpp"
+#include "isaac/tools/cpp/hash.hpp"
 
 namespace isaac
 {
@@ -49,17 +57,59 @@ static long time_event(long sum, driver::Event const & e)
     return sum + e.elapsed_time();
 }
 
-driver::Program const & profiles::value_type::init(runtime::execution_handler const & expression)
+//Split-K products and multi-group reductions stage partial results in the queue's workspace
+static bool fits_workspace(templates::base const & tp, expression_tree const & tree)
+{
+  return (size_t)tp.temporary_workspace(tree)*size_of(tree.dtype()) <= driver::backend::workspaces::max_size;
+}
+
+//Guards the map from queues to their current profiles; the profiles themselves are immutable snapshots
+static std::mutex & profiles_mutex()
+{
+  static std::mutex result;
+  return result;
+}
+
+//Shapes whose calls are counted by each profile until they are specialized. Beyond, counting starts over,
+//so that processes running ever-changing shapes do not grow without bound
+static const size_t max_counted_shapes = 1024;
+
+//Workers compiling programs in the background
+static tools::thread_pool & compilation_pool()
+{
+  static tools::thread_pool pool(std::max(1u, std::thread::hardware_concurrency()));
+  return pool;
+}
+
+//Programs of all the templates ('a'), of one template ('l'), or specialized for the sizes and strides of the arrays ('s')
+std::string profiles::value_type::fingerprint(runtime::execution_handler const & expression, char kind, int label) const
 {
-  driver::Context & context = (driver::Context&)expression.x().context();
-  std::string pname;
   runtime::compilation_options_type const & opt = expression.compilation_options();
-  if(opt.program_name.empty())
-    pname = symbolic::hash(expression.x());
-  else
-    pname = opt.program_name;
+  std::string structure = opt.program_name.empty()?symbolic::fingerprint(expression.x()):opt.program_name;
+  std::string compiler = opt.compiler.fingerprint();
+  std::string result(1, kind);
+  tools::append(result, id_);
+  tools::append(result, label + 1);
+  tools::append(result, structure.size());
+  result += structure;
+  result += compiler;
+  if(kind=='s')
+    for(expression_tree::node const & node: expression.x().data())
+      if(node.type==DENSE_ARRAY_TYPE)
+        for(unsigned int i = 0 ; i < node.shape.size() ; ++i)
+        {
+          tools::append(result, node.shape[i]);
+          tools::append(result, node.ld[i]);
+        }
+  return result;
+}
 
-  driver::Program const * program = cache_.find(pname);
+driver::Program profiles::value_type::init(runtime::execution_handler const & expression)
+{
+  driver::Context & context = (driver::Context&)expression.x().context();
+  std::string pname = fingerprint(expression, 'a', -1);
+
+  std::unique_ptr<driver::Program> program = cache_.find(tools::hash(pname), pname);
 
   if(program)
       return *program;
@@ -67,26 +117,157 @@ driver::Program const & profiles::value_type::init(runtime::execution_handler co
   std::string srcs;
    for(unsigned int i = 0 ; i < templates_.size() ; ++i)
      srcs += templates_[i]->generate(tools::to_string(i), expression.x(), context.device());
-   return cache_.add(context, pname, srcs);
+   return cache_.add(context, tools::hash(pname), pname, srcs, id_, expression.compilation_options().compiler);
 }
 
-profiles::value_type::value_type(expression_type etype, numeric_type dtype, predictors::random_forest const & predictor, std::vector< std::shared_ptr<templates::base> > const & templates, driver::CommandQueue const & queue) :
-  templates_(templates), predictor_(new predictors::random_forest(predictor)), queue_(queue), cache_(driver::backend::programs::get(queue,etype,dtype))
+std::unique_ptr<driver::Program> profiles::value_type::background(std::string const & name, runtime::execution_handler const & expression, std::function<std::string()> const & generate, bool wait)
 {
-  cache_.clear();
+  driver::Context const & context = expression.x().context();
+  pending_type::iterator it = pending_.find(name);
+  if(it==pending_.end())
+  {
+    if(failed_.find(name)!=failed_.end())
+      return std::unique_ptr<driver::Program>();
+    std::string src = generate();
+    if(src.empty())
+    {
+      failed_.insert(name);
+      return std::unique_ptr<driver::Program>();
+    }
+    src = driver::ProgramCache::prepare(context, src);
+    driver::Context ctx = context;
+    driver::CompilerOptions options = expression.compilation_options().compiler;
+    it = pending_.insert(std::make_pair(name, compilation_pool().enqueue([ctx, src, options]{ return driver::Program(ctx, src, options); }))).first;
+  }
+  if(!wait && it->second.wait_for(std::chrono::seconds(0))!=std::future_status::ready)
+    return std::unique_ptr<driver::Program>();
+  try{
+    driver::Program result = it->second.get();
+    pending_.erase(it);
+    return std::unique_ptr<driver::Program>(new driver::Program(cache_.add(tools::hash(name), name, result, id_)));
+  }catch(...){
+    pending_.erase(it);
+    failed_.insert(name);
+    if(wait)
+      throw;
+    return std::unique_ptr<driver::Program>();
+  }
 }
 
+driver::Program profiles::value_type::init(runtime::execution_handler const & expression, int & label)
+{
+  driver::Context const & context = expression.x().context();
+  std::string pname = fingerprint(expression, 'a', -1);
+
+  //Program holding all the templates
+  std::unique_ptr<driver::Program> program = cache_.find(tools::hash(pname), pname);
+  if(program)
+    return *program;
+
+  //Program holding the predicted template only
+  std::string lname = fingerprint(expression, 'l', label);
+  program = cache_.find(tools::hash(lname), lname);
+  if(program)
+    return *program;
 
-profiles::value_type::value_type(expression_type etype, numeric_type dtype, templates::base const & tp, driver::CommandQueue const & queue) : templates_(1,tp.clone()), queue_(queue), cache_(driver::backend::programs::get(queue,etype,dtype))
+  //Not ready: fall back on the template using the fewest registers
+  int fallback = cheapest(expression);
+  program = background(lname, expression, [&]{ return templates_[label]->generate(tools::to_string(label), expression.x(), context.device()); }, fallback==label);
+  if(program)
+    return *program;
+  label = fallback;
+  lname = fingerprint(expression, 'l', label);
+  program = cache_.find(tools::hash(lname), lname);
+  if(program)
+    return *program;
+  return cache_.add(context, tools::hash(lname), lname, templates_[label]->generate(tools::to_string(label), expression.x(), context.device()), id_, expression.compilation_options().compiler);
+}
+
+std::unique_ptr<driver::Program> profiles::value_type::specialized(runtime::execution_handler const & expression, int label)
 {
-  cache_.clear();
+  runtime::compilation_options_type const & opt = expression.compilation_options();
+  driver::Context const & context = expression.x().context();
+  //Sizes and strides of every array
+  std::string sname = fingerprint(expression, 's', label);
+  uint64_t skey = tools::hash(sname);
+  std::map<uint64_t, unsigned int>::iterator hits = hits_.find(skey);
+  if(hits==hits_.end())
+  {
+    if(hits_.size() >= max_counted_shapes)
+      hits_.clear();
+    hits = hits_.insert(std::make_pair(skey, 0)).first;
+  }
+  //Saturates once the shape is hot
+  if(hits->second < opt.specialize_after && ++hits->second < opt.specialize_after)
+    return std::unique_ptr<driver::Program>();
+
+  std::unique_ptr<driver::Program> program = cache_.find(skey, sname);
+  if(program)
+    return program;
+  std::function<std::string()> generate = [&]{ return templates_[label]->specialize(tools::to_string(label), expression.x(), context.device()); };
+  if(opt.async)
+    return background(sname, expression, generate, false);
+  if(failed_.find(sname)!=failed_.end())
+    return std::unique_ptr<driver::Program>();
+  std::string src = generate();
+  if(src.empty())
+  {
+    failed_.insert(sname);
+    return std::unique_ptr<driver::Program>();
+  }
+  return std::unique_ptr<driver::Program>(new driver::Program(cache_.add(context, skey, sname, src, id_, opt.compiler)));
+}
+
+float profiles::value_type::predict(std::vector<int_t> const & x) const
+{
+  if(!predictor_.get())
+    return 0;
+  std::vector<float> predictions = predictor_->predict(x);
+  return predictions.empty()?0:*std::max_element(predictions.begin(), predictions.end());
+}
+
+int profiles::value_type::cheapest(runtime::execution_handler const & expression) const
+{
+  driver::Device const & device = expression.x().context().device();
+  int result = 0;
+  unsigned int best = std::numeric_limits<unsigned int>::max();
+  for(unsigned int i = 0 ; i < templates_.size() ; ++i)
+  {
+    if(!fits_workspace(*templates_[i], expression.x()) || templates_[i]->is_invalid(expression.x(), device))
+      continue;
+    unsigned int registers = templates_[i]->registers_usage(expression.x());
+    if(registers < best)
+    {
+      best = registers;
+      result = i;
+    }
+  }
+  return result;
+}
+
+profiles::value_type::value_type(expression_type etype, numeric_type dtype, predictors::random_forest const & predictor, std::vector< std::shared_ptr<templates::base> > const & templates, driver::CommandQueue const & queue) :
+  templates_(templates), predictor_(new predictors::random_forest(predictor)), queue_(queue), cache_(driver::backend::programs::get(queue,etype,dtype)), id_(counter_++)
+{}
+
+
+profiles::value_type::value_type(expression_type etype, numeric_type dtype, templates::base const & tp, driver::CommandQueue const & queue) : templates_(1,tp.clone()), queue_(queue), cache_(driver::backend::programs::get(queue,etype,dtype)), id_(counter_++)
+{}
+
+profiles::value_type::~value_type()
+{
+  //Background compilations must not outlive the profile
+  for(pending_type::value_type & pending: pending_)
+    pending.second.wait();
 }
 
 void profiles::value_type::execute(runtime::execution_handler const & expr)
 {
-  driver::Program const & program = init(expr);
   std::vector<int_t> x = templates_[0]->input_sizes(expr.x());
-  static const int MAX_TEMPORARY_WORKSPACE = 1e6;
+  //Tuning and user-provided labels need the predicted template right away
+  bool async = expr.compilation_options().async && templates_.size() > 1 && !expr.dispatcher_options().tune && expr.dispatcher_options().label < 0;
+  std::unique_ptr<driver::Program> program;
+  if(!async)
+    program.reset(new driver::Program(init(expr)));
 
   //Specific tuning if requested
   if(expr.dispatcher_options().tune && hardcoded_.find(x)==hardcoded_.end())
@@ -94,13 +275,13 @@ void profiles::value_type::execute(runtime::execution_handler const & expr)
     std::vector<double> timings(templates_.size());
     for(unsigned int i = 0 ; i < templates_.size() ; ++i)
     {
-      if(templates_[i]->temporary_workspace(expr.x()) > MAX_TEMPORARY_WORKSPACE){
+      if(!fits_workspace(*templates_[i], expr.x())){
           timings[i] = INFINITY;
           continue;
       }
       std::list<driver::Event> events;
       try{
-        templates_[i]->enqueue(queue_, program, tools::to_string(i), runtime::execution_handler(expr.x(), runtime::execution_options_type(0, &events)));
+        templates_[i]->enqueue(queue_, *program, tools::to_string(i), runtime::execution_handler(expr.x(), runtime::execution_options_type(0, &events)));
         queue_.synchronize();
         timings[i] = 1e-9*std::accumulate(events.begin(), events.end(), 0, &time_event);
       }catch(...){
@@ -120,18 +301,35 @@ void profiles::value_type::execute(runtime::execution_handler const & expr)
     label = hardcoded_.at(x);
   else if(predictor_.get())
   {
-    std::vector<float> predictions = predictor_->predict(x);
+    std::vector<float> predictions;
+    {
+      instrumentation::timer timer(instrumentation::PREDICTION);
+      predictions = predictor_->predict(x);
+    }
     do{
         label = std::distance(predictions.begin(),std::max_element(predictions.begin(), predictions.end()));
         predictions[label] = 0;
-    }while(templates_[label]->temporary_workspace(expr.x()) > MAX_TEMPORARY_WORKSPACE);
+    }while(!fits_workspace(*templates_[label], expr.x()));
   }
 
   //Execution
-  if(templates_[label]->temporary_workspace(expr.x()) > MAX_TEMPORARY_WORKSPACE)
+  if(!fits_workspace(*templates_[label], expr.x()))
     throw operation_not_supported_exception("Running this operation would require an overly large temporary.");
 
-  return templates_[label]->enqueue(queue_, program, tools::to_string(label), expr);
+  if(async)
+    program.reset(new driver::Program(init(expr, label)));
+
+  //Hot shapes get kernels with their sizes and strides as constants
+  if(expr.compilation_options().specialize_after)
+    if(std::unique_ptr<driver::Program> specialized_program = specialized(expr, label))
+      program = std::move(specialized_program);
+
+  return templates_[label]->enqueue(queue_, *program, tools::to_string(label), expr);
+}
+
+void profiles::value_type::invalidate()
+{
+  cache_.invalidate(id_);
 }
 
 profiles::value_type::templates_container const & profiles::value_type::templates() const
@@ -165,9 +363,8 @@ std::shared_ptr<templates::base> profiles::create(std::string const & template_n
     throw std::invalid_argument("Invalid expression: " + template_name);
 }
 
-void profiles::import(std::string const & str, driver::CommandQueue const & queue)
+void profiles::import(std::string const & str, driver::CommandQueue const & queue, map_type & result)
 {
-  map_type & result = cache_[queue];
   //Parse the JSON document
   rapidjson::Document document;
   document.Parse<0>(str.c_str());
@@ -191,32 +388,36 @@ void profiles::import(std::string const & str, driver::CommandQueue const & queu
           rapidjson::Value const & profiles = document[opcstr][dtcstr]["profiles"];
           for (rapidjson::SizeType id = 0 ; id < profiles.Size() ; ++id)
             templates.push_back(create(operation, rapidjson::to_int_array<int>(profiles[id])));
+          std::shared_ptr<value_type> & profile = result[std::make_pair(etype, dtype)];
+          if(profile)
+            profile->invalidate();
           if(templates.size()>1)
           {
             // Get predictor
             predictors::random_forest predictor(document[opcstr][dtcstr]["predictor"]);
-            result[std::make_pair(etype, dtype)] = std::shared_ptr<value_type>(new value_type(etype, dtype, predictor, templates, queue));
+            profile = std::shared_ptr<value_type>(new value_type(etype, dtype, predictor, templates, queue));
           }
           else
-            result[std::make_pair(etype, dtype)] = std::shared_ptr<value_type>(new value_type(etype, dtype, *templates[0], queue));
+            profile = std::shared_ptr<value_type>(new value_type(etype, dtype, *templates[0], queue));
         }
       }
     }
   }
 }
 
-profiles::map_type& profiles::init(driver::CommandQueue const & queue)
+profiles::snapshot_type profiles::init(driver::CommandQueue const & queue)
 {
-  map_type & map = cache_[queue];
+  //Parsed without the lock; if another thread got there first, its map wins
+  std::shared_ptr<map_type> map = std::make_shared<map_type>();
   driver::Device const & device = queue.device();
   presets_type::const_iterator it = presets_.find(std::make_tuple(device.type(), device.vendor(), device.architecture()));
   /*-- Device not found in database --*/
   if(it==presets_.end()){
-      import(presets_.at(std::make_tuple(driver::Device::Type::UNKNOWN, driver::Device::Vendor::UNKNOWN, driver::Device::Architecture::UNKNOWN)), queue);
+      import(presets_.at(std::make_tuple(driver::Device::Type::UNKNOWN, driver::Device::Vendor::UNKNOWN, driver::Device::Architecture::UNKNOWN)), queue, *map);
   }
   /*-- Device found in database --*/
   else{
-      import(it->second, queue);
+      import(it->second, queue, *map);
   }
 
   /*-- User-provided profile --*/
@@ -225,34 +426,61 @@ profiles::map_type& profiles::init(driver::CommandQueue const & queue)
   {
     std::string json_path = homepath + "/.isaac/devices/device0.json";
     std::ifstream t(json_path);
-    if(!t)
-        return map;
-    std::string str;
-    t.seekg(0, std::ios::end);
-    str.reserve(t.tellg());
-    t.seekg(0, std::ios::beg);
-    str.assign((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
-    import(str, queue);
+    if(t)
+    {
+      std::string str;
+      t.seekg(0, std::ios::end);
+      str.reserve(t.tellg());
+      t.seekg(0, std::ios::beg);
+      str.assign((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
+      import(str, queue, *map);
+    }
   }
 
-  return map;
+  std::lock_guard<std::mutex> lock(profiles_mutex());
+  snapshot_type & result = cache_[queue];
+  if(!result)
+    result = map;
+  return result;
 }
 
-profiles::map_type& profiles::get(driver::CommandQueue const & queue)
+profiles::snapshot_type profiles::get(driver::CommandQueue const & queue)
 {
-  std::map<driver::CommandQueue, map_type>::iterator it = cache_.find(queue);
-  if(it == cache_.end())
-    return init(queue);
-  return it->second;
+  {
+    std::lock_guard<std::mutex> lock(profiles_mutex());
+    std::map<driver::CommandQueue, snapshot_type>::iterator it = cache_.find(queue);
+    if(it != cache_.end())
+      return it->second;
+  }
+  return init(queue);
 }
 
 void profiles::set(driver::CommandQueue const & queue, expression_type operation, numeric_type dtype, std::shared_ptr<value_type> const & profile)
-{ cache_[queue][std::make_pair(operation,dtype)] = profile; }
+{
+  get(queue);
+  std::shared_ptr<value_type> previous;
+  {
+    std::lock_guard<std::mutex> lock(profiles_mutex());
+    snapshot_type & snapshot = cache_[queue];
+    std::shared_ptr<map_type> map = std::make_shared<map_type>(snapshot?*snapshot:map_type());
+    std::shared_ptr<value_type> & current = (*map)[std::make_pair(operation,dtype)];
+    previous = current;
+    current = profile;
+    snapshot = map;
+  }
+  if(previous && previous!=profile)
+    previous->invalidate();
+}
 
 void profiles::release()
-{ cache_.clear(); }
+{
+  std::lock_guard<std::mutex> lock(profiles_mutex());
+  cache_.clear();
+}
+
+std::map<driver::CommandQueue, profiles::snapshot_type> profiles::cache_;
 
-std::map<driver::CommandQueue, profiles::map_type> profiles::cache_;
+std::atomic<uint64_t> profiles::value_type::counter_(0);
 
 }
 }
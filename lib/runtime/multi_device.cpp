@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#include <cmath>
+#include <memory>
+#include <numeric>
+
+#include "isaac/runtime/multi_device.h"
+#include "tools/host.hpp"
+
+namespace isaac
+{
+namespace runtime
+{
+
+//Dense device array for the units [start, start + size) of x
+static std::shared_ptr<array> block(driver::Context const & context, host_array const & x, int_t size)
+{
+  if(x.shape1==1) return std::make_shared<array>(size, x.dtype, context);
+  return std::make_shared<array>(x.shape0, size, x.dtype, context);
+}
+
+multi_device::multi_device(std::vector<driver::Context const *> const & contexts) : contexts_(contexts)
+{ }
+
+std::vector<driver::Context const *> const & multi_device::contexts() const
+{ return contexts_; }
+
+std::vector<double> multi_device::predict(expression_type type, numeric_type dtype, std::vector<int_t> const & sizes)
+{
+  if(weights.size()==contexts_.size())
+    return weights;
+  std::vector<double> result;
+  bool predicted = true;
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+  {
+    profiles::snapshot_type map = profiles::get(queue(i));
+    profiles::map_type::const_iterator it = map->find(std::make_pair(type, dtype));
+    result.push_back((it==map->end())?0:it->second->predict(sizes));
+    predicted = predicted && result.back() > 0 && std::isfinite(result.back());
+  }
+  //Without predictions for every device, falls back on their peak compute rate (clock rates are all in MHz)
+  if(!predicted)
+    for(size_t i = 0 ; i < contexts_.size() ; ++i){
+      driver::Device const & device = contexts_[i]->device();
+      result[i] = (double)device.compute_units()*device.clock_rate();
+    }
+  return result;
+}
+
+std::vector<int_t> multi_device::split(int_t extent, std::vector<double> const & weights) const
+{
+  size_t P = contexts_.size();
+  double total = std::accumulate(weights.begin(), weights.end(), 0.);
+  std::vector<int_t> bounds(P + 1, 0);
+  double cumulated = 0;
+  for(size_t i = 0 ; i < P ; ++i){
+    cumulated += weights[i];
+    bounds[i+1] = std::min<int_t>(extent, std::llround(extent*cumulated/total));
+  }
+  bounds[P] = extent;
+  return bounds;
+}
+
+driver::CommandQueue & multi_device::queue(size_t part)
+{ return thread_queue(*contexts_[part]); }
+
+void multi_device::run(size_t part, expression_tree const & tree)
+{ submit(queue(part), tree); }
+
+void multi_device::synchronize()
+{
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+    queue(i).synchronize();
+}
+
+void multi_device::elementwise(host_array const & y, std::vector<host_array> const & x, function_type const & f)
+{
+  int_t N = common_extent(y, x, "multi-device");
+  std::vector<int_t> sizes = (y.shape1==1)?std::vector<int_t>{N}:std::vector<int_t>{y.shape0, N};
+  std::vector<int_t> bounds = split(N, predict((y.shape1==1)?ELEMENTWISE_1D:ELEMENTWISE_2D, y.dtype, sizes));
+  //Device arrays must outlive the transfers
+  std::vector<std::shared_ptr<array> > blocks;
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+  {
+    int_t start = bounds[i], size = bounds[i+1] - bounds[i];
+    if(size==0)
+      continue;
+    driver::CommandQueue & queue = this->queue(i);
+    std::vector<array_base*> args;
+    for(host_array const & xi: x){
+      blocks.push_back(block(*contexts_[i], xi, size));
+      xi.upload(queue, start, size, blocks.back()->data());
+      args.push_back(blocks.back().get());
+    }
+    blocks.push_back(block(*contexts_[i], y, size));
+    run(i, assign(*blocks.back(), f(args)));
+    y.download(queue, start, size, blocks.back()->data());
+  }
+  synchronize();
+}
+
+void multi_device::gemm(value_scalar const & alpha, host_array const & A, bool transA, host_array const & B, bool transB, value_scalar const & beta, host_array const & C)
+{
+  int_t M = C.shape0, N = C.shape1, K = gemm_depth(A, transA, B, transB, C, "multi-device");
+  expression_type type = transA?(transB?MATRIX_PRODUCT_TT:MATRIX_PRODUCT_TN):(transB?MATRIX_PRODUCT_NT:MATRIX_PRODUCT_NN);
+  std::vector<int_t> bounds = split(N, predict(type, C.dtype, {M, N, K}));
+  bool has_beta = (double)beta!=0;
+  std::vector<std::shared_ptr<array> > blocks;
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+  {
+    int_t j = bounds[i], n = bounds[i+1] - bounds[i];
+    if(n==0)
+      continue;
+    driver::Context const & context = *contexts_[i];
+    driver::CommandQueue & queue = this->queue(i);
+    //A is replicated, B and C are scattered by columns of op(B) and C
+    std::shared_ptr<array> Ai = std::make_shared<array>(A.shape0, A.shape1, A.dtype, context);
+    A.upload(queue, 0, 0, A.shape0, A.shape1, Ai->data());
+    std::shared_ptr<array> Bi = transB?std::make_shared<array>(n, K, B.dtype, context):std::make_shared<array>(K, n, B.dtype, context);
+    if(transB) B.upload(queue, j, 0, n, K, Bi->data());
+    else B.upload(queue, 0, j, K, n, Bi->data());
+    std::shared_ptr<array> Ci = std::make_shared<array>(M, n, C.dtype, context);
+    if(has_beta)
+      C.upload(queue, 0, j, M, n, Ci->data());
+    expression_tree AB = product(*Ai, transA, *Bi, transB);
+    if(has_beta) run(i, assign(*Ci, alpha*AB + beta*(*Ci)));
+    else run(i, assign(*Ci, alpha*AB));
+    C.download(queue, 0, j, M, n, Ci->data());
+    blocks.insert(blocks.end(), {Ai, Bi, Ci});
+  }
+  synchronize();
+}
+
+}
+}
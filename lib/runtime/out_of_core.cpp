@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+
+#include "isaac/runtime/out_of_core.h"
+#include "isaac/tools/sys/getenv.hpp"
+#include "tools/host.hpp"
+
+namespace isaac
+{
+namespace runtime
+{
+
+//Stages
+static const unsigned int COMPUTE = 0;
+static const unsigned int UPLOAD = 1;
+static const unsigned int DOWNLOAD = 2;
+
+host_array::host_array(void* _data, numeric_type _dtype, int_t _shape0, int_t _shape1, int_t _ld) :
+  data(_data), dtype(_dtype), shape0(_shape0), shape1(_shape1), ld(_ld?_ld:_shape0)
+{ }
+
+int_t host_array::extent() const
+{ return (shape1==1)?shape0:shape1; }
+
+static int_t rows(host_array const & x)
+{ return (x.shape1==1)?1:x.shape0; }
+
+//Number of tiled units such that the given bytes per unit fit in the footprint
+static int_t units(size_t footprint, size_t bytes, int_t max)
+{
+  int_t result = std::min<int_t>(footprint/bytes, max);
+  if(result==0)
+    throw std::runtime_error("ISAAC: out-of-core footprint too small for a single tile");
+  return result;
+}
+
+void host_array::upload(driver::CommandQueue & queue, int_t r0, int_t c0, int_t nrows, int_t ncols, driver::Buffer const & buffer) const
+{
+  size_t dtsize = size_of(dtype);
+  char const * ptr = (char const *)data + (r0 + c0*ld)*dtsize;
+  if(ncols==1 || nrows==ld)
+    queue.write(buffer, false, 0, nrows*ncols*dtsize, ptr);
+  else
+    queue.write_rect(buffer, false, 0, nrows*dtsize, nrows*dtsize, ncols, ptr, ld*dtsize);
+  queue.flush();
+}
+
+void host_array::download(driver::CommandQueue & queue, int_t r0, int_t c0, int_t nrows, int_t ncols, driver::Buffer const & buffer) const
+{
+  size_t dtsize = size_of(dtype);
+  char * ptr = (char*)data + (r0 + c0*ld)*dtsize;
+  if(ncols==1 || nrows==ld)
+    queue.read(buffer, false, 0, nrows*ncols*dtsize, ptr);
+  else
+    queue.read_rect(buffer, false, 0, nrows*dtsize, nrows*dtsize, ncols, ptr, ld*dtsize);
+  queue.flush();
+}
+
+void host_array::upload(driver::CommandQueue & queue, int_t start, int_t size, driver::Buffer const & buffer) const
+{
+  if(shape1==1) upload(queue, start, 0, size, 1, buffer);
+  else upload(queue, 0, start, shape0, size, buffer);
+}
+
+void host_array::download(driver::CommandQueue & queue, int_t start, int_t size, driver::Buffer const & buffer) const
+{
+  if(shape1==1) download(queue, start, 0, size, 1, buffer);
+  else download(queue, 0, start, shape0, size, buffer);
+}
+
+//Device view of a dense block stored in buffer
+static std::shared_ptr<array> block(int_t nrows, int_t ncols, numeric_type dtype, driver::Buffer const & buffer)
+{ return std::make_shared<array>(nrows, ncols, dtype, buffer, 0, nrows); }
+
+//Device view of the units [start, start + size) of x stored in buffer
+static std::shared_ptr<array> view(host_array const & x, int_t size, driver::Buffer const & buffer)
+{
+  if(x.shape1==1) return std::make_shared<array>(size, x.dtype, buffer, 0, 1);
+  return block(x.shape0, size, x.dtype, buffer);
+}
+
+//Two slots of the given bytes per operand
+static std::vector<driver::Buffer> slots(driver::Context const & context, std::vector<size_t> const & bytes)
+{
+  std::vector<driver::Buffer> result;
+  for(size_t b: bytes)
+    for(unsigned int s = 0 ; s < 2 ; ++s)
+      result.push_back(driver::Buffer(context, b));
+  return result;
+}
+
+static size_t default_footprint(driver::Context const & context)
+{
+  std::string value = tools::getenv("ISAAC_OUT_OF_CORE_FOOTPRINT");
+  return value.empty()?context.device().global_mem_size()/2:(size_t)std::stoull(value);
+}
+
+out_of_core::out_of_core(driver::Context const & context) : footprint(default_footprint(context)), context_(context)
+{
+  //Transfers get queues of their own rather than those of other threads
+  queues_[COMPUTE] = driver::backend::queues::current();
+  queues_[UPLOAD] = driver::backend::queues::acquire();
+  queues_[DOWNLOAD] = driver::backend::queues::acquire();
+  for(unsigned int i = 0 ; i < 3 ; ++i)
+    queue(i);
+}
+
+out_of_core::~out_of_core()
+{
+  driver::backend::queues::relinquish(queues_[UPLOAD]);
+  driver::backend::queues::relinquish(queues_[DOWNLOAD]);
+}
+
+driver::CommandQueue & out_of_core::queue(unsigned int stage)
+{ return driver::backend::queues::get(context_, queues_[stage]); }
+
+void out_of_core::run(expression_tree const & tree)
+{ submit(queue(COMPUTE), tree); }
+
+void out_of_core::synchronize()
+{
+  for(unsigned int i = 0 ; i < 3 ; ++i)
+    queue(i).synchronize();
+}
+
+void out_of_core::elementwise(host_array const & y, std::vector<host_array> const & x, function_type const & f)
+{
+  int_t N = common_extent(y, x, "out-of-core");
+  std::vector<size_t> bytes;
+  for(host_array const & xi: x)
+    bytes.push_back(rows(xi)*size_of(xi.dtype));
+  bytes.push_back(rows(y)*size_of(y.dtype));
+  size_t total = 0;
+  for(size_t b: bytes) total += 2*b;
+  int_t tile = units(footprint, total, N);
+  for(size_t & b: bytes) b *= tile;
+  std::vector<driver::Buffer> buffers = slots(context_, bytes);
+  driver::Buffer const * ybuffers = &buffers[2*x.size()];
+  for(int_t start = 0, i = 0 ; start < N ; start += tile, ++i)
+  {
+    int_t size = std::min(tile, N - start);
+    unsigned int s = i%2;
+    std::vector<std::shared_ptr<array> > xtiles;
+    std::vector<array_base*> args;
+    for(size_t k = 0 ; k < x.size() ; ++k){
+      x[k].upload(queue(UPLOAD), start, size, buffers[2*k + s]);
+      xtiles.push_back(view(x[k], size, buffers[2*k + s]));
+      args.push_back(xtiles.back().get());
+    }
+    std::shared_ptr<array> ytile = view(y, size, ybuffers[s]);
+    run(assign(*ytile, f(args)));
+    y.download(queue(DOWNLOAD), start, size, ybuffers[s]);
+  }
+  synchronize();
+}
+
+value_scalar out_of_core::reduce(std::vector<host_array> const & x, function_type const & f, std::function<expression_tree(array_base const &)> const & combine)
+{
+  int_t N = common_extent(x[0], x, "out-of-core");
+  std::vector<size_t> bytes;
+  size_t total = 0;
+  for(host_array const & xi: x){
+    bytes.push_back(rows(xi)*size_of(xi.dtype));
+    total += 2*bytes.back();
+  }
+  int_t tile = units(footprint, total, N);
+  int_t ntiles = (N + tile - 1)/tile;
+  for(size_t & b: bytes) b *= tile;
+  std::vector<driver::Buffer> buffers = slots(context_, bytes);
+  std::unique_ptr<array> partials;
+  for(int_t start = 0, i = 0 ; start < N ; start += tile, ++i)
+  {
+    int_t size = std::min(tile, N - start);
+    unsigned int s = i%2;
+    std::vector<std::shared_ptr<array> > xtiles;
+    std::vector<array_base*> args;
+    for(size_t k = 0 ; k < x.size() ; ++k){
+      x[k].upload(queue(UPLOAD), start, size, buffers[2*k + s]);
+      xtiles.push_back(view(x[k], size, buffers[2*k + s]));
+      args.push_back(xtiles.back().get());
+    }
+    expression_tree tree = f(args);
+    if(!partials)
+      partials.reset(new array(ntiles, tree.dtype(), context_));
+    scalar partial(tree.dtype(), partials->data(), i);
+    run(assign(partial, tree));
+  }
+  scalar result(partials->dtype(), context_);
+  run(assign(result, combine?combine(*partials):sum(*partials)));
+  synchronize();
+  return value_scalar(result);
+}
+
+void out_of_core::gemm(value_scalar const & alpha, host_array const & A, bool transA, host_array const & B, bool transB, value_scalar const & beta, host_array const & C)
+{
+  int_t M = C.shape0, N = C.shape1, K = gemm_depth(A, transA, B, transB, C, "out-of-core");
+  size_t dtsize = size_of(C.dtype);
+  //Two slots of square blocks for each of A, B and C
+  int_t t = std::sqrt((double)footprint/(6*dtsize));
+  if(t==0)
+    throw std::runtime_error("ISAAC: out-of-core footprint too small for a single tile");
+  int_t mb = std::min(t, M), nb = std::min(t, N), kb = std::min(t, K);
+  std::vector<driver::Buffer> buffers = slots(context_, {mb*kb*dtsize, kb*nb*dtsize, mb*nb*dtsize});
+  bool has_beta = (double)beta!=0;
+  value_scalar one(1, C.dtype);
+  for(int_t j = 0, c = 0 ; j < N ; j += nb)
+    for(int_t i = 0 ; i < M ; i += mb, ++c)
+    {
+      int_t m = std::min(mb, M - i), n = std::min(nb, N - j);
+      driver::Buffer const & cbuffer = buffers[4 + c%2];
+      std::shared_ptr<array> Ct = block(m, n, C.dtype, cbuffer);
+      if(has_beta)
+        C.upload(queue(UPLOAD), i, j, m, n, cbuffer);
+      for(int_t l = 0, g = c*((K + kb - 1)/kb) ; l < K ; l += kb, ++g)
+      {
+        int_t k = std::min(kb, K - l);
+        driver::Buffer const & abuffer = buffers[g%2];
+        driver::Buffer const & bbuffer = buffers[2 + g%2];
+        //Blocks are uploaded in their stored layout
+        if(transA) A.upload(queue(UPLOAD), l, i, k, m, abuffer);
+        else A.upload(queue(UPLOAD), i, l, m, k, abuffer);
+        if(transB) B.upload(queue(UPLOAD), j, l, n, k, bbuffer);
+        else B.upload(queue(UPLOAD), l, j, k, n, bbuffer);
+        std::shared_ptr<array> At = transA?block(k, m, A.dtype, abuffer):block(m, k, A.dtype, abuffer);
+        std::shared_ptr<array> Bt = transB?block(n, k, B.dtype, bbuffer):block(k, n, B.dtype, bbuffer);
+        expression_tree AB = product(*At, transA, *Bt, transB);
+        if(l==0 && !has_beta) run(assign(*Ct, alpha*AB));
+        else run(assign(*Ct, alpha*AB + ((l==0)?beta:one)*(*Ct)));
+      }
+      C.download(queue(DOWNLOAD), i, j, m, n, cbuffer);
+    }
+  synchronize();
+}
+
+}
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+
+#include "isaac/driver/buffer.h"
+#include "isaac/runtime/partitioned.h"
+#include "tools/host.hpp"
+
+namespace isaac
+{
+namespace runtime
+{
+
+//Zero-copy buffers over whole host arrays, with their size. Each array is registered once per context,
+//since CUDA fails on overlapping registrations, and stays registered until the operation is released
+typedef std::map<std::pair<driver::Context, void*>, std::pair<driver::Buffer, size_t> > registrations_type;
+
+//Zero-copy buffer over the whole of x
+static driver::Buffer const & registration(registrations_type & registrations, driver::Context const & context, host_array const & x)
+{
+  size_t bytes = ((x.shape1 - 1)*x.ld + x.shape0)*size_of(x.dtype);
+  std::pair<driver::Context, void*> key(context, x.data);
+  registrations_type::iterator it = registrations.find(key);
+  if(it==registrations.end())
+    it = registrations.insert(std::make_pair(key, std::make_pair(driver::Buffer(context, bytes, x.data), bytes))).first;
+  else if(it->second.second < bytes)
+    throw std::invalid_argument("ISAAC: partitioned operands sharing their data must have the same shape");
+  return it->second.first;
+}
+
+//Zero-copy matrix over the block [r0, r0 + nrows) x [c0, c0 + ncols) of x, even when x has a single column
+static std::shared_ptr<array> wrap(registrations_type & registrations, driver::Context const & context, host_array const & x, int_t r0, int_t c0, int_t nrows, int_t ncols)
+{ return std::make_shared<array>(nrows, ncols, x.dtype, registration(registrations, context, x), r0 + c0*x.ld, x.ld); }
+
+//Units [start, end) of x
+static std::shared_ptr<array> wrap(registrations_type & registrations, driver::Context const & context, host_array const & x, int_t start, int_t end)
+{
+  if(x.shape1==1) return std::make_shared<array>(end - start, x.dtype, registration(registrations, context, x), start, 1);
+  return wrap(registrations, context, x, 0, start, x.shape0, end - start);
+}
+
+//Waits for the device to be done with a zero-copy array, and makes its content visible to the host
+static void release(driver::CommandQueue & queue, array const & x)
+{
+  int_t last = 0;
+  for(size_t d = 0 ; d < x.dim() ; ++d)
+    last += (x.shape()[d] - 1)*x.stride()[d];
+  size_t dtsize = size_of(x.dtype());
+  queue.unmap(x.data(), queue.map(x.data(), x.start()*dtsize, (last + 1)*dtsize));
+}
+
+static std::vector<driver::Device> numa_nodes(driver::Device const & device)
+{
+  std::vector<driver::Device> result;
+  device.partition_numa(result);
+  return result;
+}
+
+partitioned::partitioned(std::vector<driver::Device> const & devices)
+{
+  for(driver::Device const & device: devices)
+    contexts_.push_back(&driver::backend::contexts::get(device));
+  //A host range can only be registered once per process with CUDA, and operands are shared by all parts
+  for(driver::Context const * context: contexts_)
+    if(context->backend()==driver::CUDA && *context!=*contexts_[0])
+      throw std::invalid_argument("ISAAC: partitioned CUDA devices must share a context");
+}
+
+partitioned::partitioned(driver::Device const & device) : partitioned(numa_nodes(device))
+{ }
+
+std::vector<driver::Context const *> const & partitioned::contexts() const
+{ return contexts_; }
+
+std::vector<int_t> partitioned::split(int_t extent) const
+{
+  size_t P = contexts_.size();
+  std::vector<int_t> bounds(P + 1);
+  for(size_t i = 0 ; i <= P ; ++i)
+    bounds[i] = extent*i/P;
+  return bounds;
+}
+
+driver::CommandQueue & partitioned::queue(size_t part)
+{ return thread_queue(*contexts_[part]); }
+
+void partitioned::run(size_t part, expression_tree const & tree)
+{ submit(queue(part), tree); }
+
+void partitioned::first_touch(host_array const & x)
+{
+  std::vector<int_t> bounds = split(x.extent());
+  registrations_type registrations;
+  std::vector<std::shared_ptr<array> > blocks(contexts_.size());
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+    if(bounds[i] < bounds[i+1]){
+      blocks[i] = wrap(registrations, *contexts_[i], x, bounds[i], bounds[i+1]);
+      run(i, assign(*blocks[i], value_scalar(0, x.dtype)));
+    }
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+    if(blocks[i])
+      release(queue(i), *blocks[i]);
+}
+
+void partitioned::elementwise(host_array const & y, std::vector<host_array> const & x, function_type const & f)
+{
+  std::vector<int_t> bounds = split(common_extent(y, x, "partitioned"));
+  //Inputs stay registered until every part is released
+  registrations_type registrations;
+  std::vector<std::shared_ptr<array> > blocks(contexts_.size());
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+    if(bounds[i] < bounds[i+1])
+    {
+      std::vector<std::shared_ptr<array> > xblocks;
+      std::vector<array_base*> args;
+      for(host_array const & xi: x){
+        xblocks.push_back(wrap(registrations, *contexts_[i], xi, bounds[i], bounds[i+1]));
+        args.push_back(xblocks.back().get());
+      }
+      blocks[i] = wrap(registrations, *contexts_[i], y, bounds[i], bounds[i+1]);
+      run(i, assign(*blocks[i], f(args)));
+    }
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+    if(blocks[i])
+      release(queue(i), *blocks[i]);
+}
+
+void partitioned::gemm(value_scalar const & alpha, host_array const & A, bool transA, host_array const & B, bool transB, value_scalar const & beta, host_array const & C)
+{
+  int_t M = C.shape0, N = C.shape1, K = gemm_depth(A, transA, B, transB, C, "partitioned");
+  bool has_beta = (double)beta!=0;
+  std::vector<int_t> bounds = split(N);
+  //A is registered once per context and shared by its parts; inputs stay registered until every part is released
+  registrations_type registrations;
+  std::vector<std::shared_ptr<array> > blocks(contexts_.size());
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+    if(bounds[i] < bounds[i+1])
+    {
+      int_t j = bounds[i], n = bounds[i+1] - bounds[i];
+      driver::Context const & context = *contexts_[i];
+      std::shared_ptr<array> Ai = wrap(registrations, context, A, 0, 0, A.shape0, A.shape1);
+      std::shared_ptr<array> Bi = transB?wrap(registrations, context, B, j, 0, n, K):wrap(registrations, context, B, 0, j, K, n);
+      blocks[i] = wrap(registrations, context, C, 0, j, M, n);
+      expression_tree AB = product(*Ai, transA, *Bi, transB);
+      if(has_beta) run(i, assign(*blocks[i], alpha*AB + beta*(*blocks[i])));
+      else run(i, assign(*blocks[i], alpha*AB));
+    }
+  for(size_t i = 0 ; i < contexts_.size() ; ++i)
+    if(blocks[i])
+      release(queue(i), *blocks[i]);
+}
+
+}
+}
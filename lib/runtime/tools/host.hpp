@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/runtime/execute.h"
+#include "isaac/runtime/out_of_core.h"
+
+namespace isaac
+{
+namespace runtime
+{
+
+//Shared by the executors over host arrays (out_of_core, partitioned, multi_device)
+
+//Default queue of the calling thread on the context
+inline driver::CommandQueue & thread_queue(driver::Context const & context)
+{ return driver::backend::queues::get(context, driver::backend::queues::current()); }
+
+//Enqueues an expression with the profiles of the queue, and submits it right away
+inline void submit(driver::CommandQueue & queue, expression_tree const & tree)
+{
+  execute(execution_handler(tree, execution_options_type(queue)), *profiles::get(queue));
+  queue.flush();
+}
+
+//Extent shared by y and the x, which elementwise operations split
+inline int_t common_extent(host_array const & y, std::vector<host_array> const & x, std::string const & name)
+{
+  for(host_array const & xi: x)
+    if(xi.extent()!=y.extent())
+      throw std::invalid_argument("ISAAC: " + name + " operands must have the same extent");
+  return y.extent();
+}
+
+//Inner dimension K of C = op(A)*op(B)
+inline int_t gemm_depth(host_array const & A, bool transA, host_array const & B, bool transB, host_array const & C, std::string const & name)
+{
+  int_t M = C.shape0, N = C.shape1;
+  int_t K = transA?A.shape0:A.shape1;
+  if((transA?A.shape1:A.shape0)!=M || (transB?B.shape0:B.shape1)!=N || (transB?B.shape1:B.shape0)!=K)
+    throw std::invalid_argument("ISAAC: " + name + " gemm shapes mismatch");
+  return K;
+}
+
+//op(A)*op(B) on device arrays
+inline expression_tree product(array const & A, bool transA, array const & B, bool transB)
+{ return transA?(transB?dot(A.T, B.T):dot(A.T, B)):(transB?dot(A, B.T):dot(A, B)); }
+
+}
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2015, PHILIPPE TILLET. All rights reserved.
+ *
+ * This file is part of ISAAC.
+ *
+ * ISAAC is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ */
+
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "isaac/array.h"
+#include "isaac/driver/binary_cache.h"
+#include "isaac/driver/program.h"
+#include "isaac/runtime/execute.h"
+#include "isaac/runtime/warmup.h"
+#include "isaac/tools/cpp/string.hpp"
+
+namespace isaac
+{
+namespace runtime
+{
+
+static void run(expression_tree const & tree, driver::CommandQueue & queue)
+{
+  execution_options_type options(queue);
+  execute(execution_handler(tree, options), *profiles::get(queue));
+}
+
+static void warmup(driver::CommandQueue & queue, std::string const & signature)
+{
+  driver::Context const & context = queue.context();
+  std::vector<std::string> tokens = tools::split(signature, ':');
+  std::string const & operation = tokens[0];
+  numeric_type dtype = (tokens.size()>1)?numeric_type_from_string(tokens[1]):FLOAT_TYPE;
+  value_scalar alpha(1, dtype), beta(1, dtype);
+  int_t N = 2;
+  array x(N, dtype, context), y(N, dtype, context);
+  array A(N, N, dtype, context), B(N, N, dtype, context), C(N, N, dtype, context);
+  scalar s(dtype, context);
+  if(operation=="axpy") run(assign(y, alpha*x + y), queue);
+  else if(operation=="scal") run(assign(x, alpha*x), queue);
+  else if(operation=="copy") run(assign(y, x), queue);
+  else if(operation=="dot") run(assign(s, dot(x,y)), queue);
+  else if(operation=="asum") run(assign(s, sum(abs(x))), queue);
+  else if(operation=="gemv_n") run(assign(y, alpha*dot(A, x) + beta*y), queue);
+  else if(operation=="gemv_t") run(assign(y, alpha*dot(A.T, x) + beta*y), queue);
+  else if(operation=="ger") run(assign(C, alpha*outer(x, y) + beta*C), queue);
+  else if(operation=="gemm_nn") run(assign(C, alpha*dot(A, B) + beta*C), queue);
+  else if(operation=="gemm_nt") run(assign(C, alpha*dot(A, B.T) + beta*C), queue);
+  else if(operation=="gemm_tn") run(assign(C, alpha*dot(A.T, B) + beta*C), queue);
+  else if(operation=="gemm_tt") run(assign(C, alpha*dot(A.T, B.T) + beta*C), queue);
+  else throw std::invalid_argument("Invalid signature: " + signature);
+}
+
+static bool read(std::istream & is, std::string & str)
+{
+  uint64_t size;
+  if(!is.read((char*)&size, sizeof(size)))
+    return false;
+  str.assign(size, '\0');
+  return (bool)is.read(&str[0], std::streamsize(size));
+}
+
+//Sources are recorded as compiled, so the build flags are passed through as is
+static void replay(driver::CommandQueue & queue, std::string const & trace, std::set<std::pair<std::string, std::string> > & done)
+{
+  std::ifstream file(trace.c_str(), std::ios::binary);
+  if(!file)
+    throw std::invalid_argument("Invalid trace: " + trace);
+  std::string source, flags;
+  while(read(file, source) && read(file, flags))
+    if(done.insert(std::make_pair(source, flags)).second)
+    {
+      driver::CompilerOptions options;
+      options.extra = flags;
+      driver::Program(queue.context(), source, options);
+    }
+}
+
+void warmup(driver::CommandQueue & queue, std::vector<std::string> const & signatures, std::vector<std::string> const & traces, std::string const & bundle)
+{
+  std::set<std::pair<std::string, std::string> > done;
+  driver::BinaryCache::start_capture();
+  try{
+    for(std::string const & trace: traces)
+      replay(queue, trace, done);
+    for(std::string const & signature: signatures)
+      warmup(queue, signature);
+    queue.synchronize();
+  }catch(...){
+    driver::BinaryCache::stop_capture();
+    throw;
+  }
+  driver::BinaryCache::save_capture(bundle);
+  driver::BinaryCache::stop_capture();
+}
+
+}
+}
@@ -214,24 +214,25 @@ namespace detail
 
   struct model_map_indexing
   {
-      static rt::profiles::value_type& get_item(rt::profiles::map_type& container, bp::tuple i_)
+      static std::shared_ptr<rt::profiles::value_type> get_item(profiles_view const & view, bp::tuple i_)
       {
           sc::expression_type expression = tools::extract_template_type(i_[0]);
           sc::numeric_type dtype = tools::extract_dtype(i_[1]);
-          rt::profiles::map_type::iterator i = container.find(std::make_pair(expression, dtype));
-          if (i == container.end())
+          rt::profiles::snapshot_type container = rt::profiles::get(view.queue);
+          rt::profiles::map_type::const_iterator i = container->find(std::make_pair(expression, dtype));
+          if (i == container->end())
           {
               PyErr_SetString(PyExc_KeyError, "Invalid key");
               bp::throw_error_already_set();
           }
-          return *i->second;
+          return i->second;
       }
 
-      static void set_item(rt::profiles::map_type& container, bp::tuple i_, rt::profiles::value_type const & v)
+      static void set_item(profiles_view const & view, bp::tuple i_, std::shared_ptr<rt::profiles::value_type> const & v)
       {
           sc::expression_type expression = tools::extract_template_type(i_[0]);
           sc::numeric_type dtype = tools::extract_dtype(i_[1]);
-          container[std::make_pair(expression, dtype)].reset(new rt::profiles::value_type(v));
+          rt::profiles::set(view.queue, expression, dtype, v);
       }
   };
 }
@@ -412,8 +413,8 @@ void export_core()
 
   /*--- Profiles----*/
   //---------------------------------------
-  bp::class_<rt::profiles::map_type>("profiles")
-      .def("__getitem__", &detail::model_map_indexing::get_item, bp::return_internal_reference<>())
-      .def("__setitem__", &detail::model_map_indexing::set_item, bp::with_custodian_and_ward<1,2>())
+  bp::class_<profiles_view>("profiles", bp::no_init)
+      .def("__getitem__", &detail::model_map_indexing::get_item)
+      .def("__setitem__", &detail::model_map_indexing::set_item)
       ;
 }
@@ -22,6 +22,14 @@
 #ifndef ISAAC_PYTHON_CORE_HPP
 #define ISAAC_PYTHON_CORE_HPP
 
+#include "isaac/driver/command_queue.h"
+
+//Profiles of a queue as seen from Python; assignments publish a new snapshot through runtime::profiles::set
+struct profiles_view
+{
+  isaac::driver::CommandQueue queue;
+};
+
 void export_core();
 
 #endif
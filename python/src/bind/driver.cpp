@@ -22,11 +22,16 @@
 #include <memory>
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
+#include "isaac/common/instrumentation.h"
+#include "isaac/driver/backend.h"
 #include "isaac/driver/device.h"
+#include "isaac/driver/memory_pool.h"
+#include "isaac/driver/program.h"
 #include "isaac/runtime/execute.h"
 #include "isaac/runtime/handler.h"
 
 #include "common.hpp"
+#include "core.h"
 #include "driver.h"
 
 
@@ -73,6 +78,11 @@ namespace detail
 
 
 
+  profiles_view get_profiles(sc::driver::CommandQueue const & queue)
+  {
+    return profiles_view{queue};
+  }
+
   std::string to_string(sc::driver::Device::Type type)
   {
     if(type==sc::driver::Device::Type::CPU) return "CPU";
@@ -84,7 +94,45 @@ namespace detail
   std::shared_ptr<sc::driver::Context> make_context(sc::driver::Device const & dev)
   { return std::shared_ptr<sc::driver::Context>(new sc::driver::Context(dev)); }
 
-  bp::object enqueue(sc::expression_tree const & tree, unsigned int queue_id, bp::list dependencies, bool tune, int label, std::string const & program_name, bool force_recompile)
+  bp::dict memory_statistics(sc::driver::Context const & context)
+  {
+    sc::driver::MemoryPool::statistics_type stats = sc::driver::backend::pools::get(context).statistics();
+    bp::dict result;
+    result["reserved"] = stats.reserved;
+    result["in_use"] = stats.in_use;
+    result["peak"] = stats.peak;
+    result["slabs"] = stats.slabs;
+    result["hits"] = stats.hits;
+    result["misses"] = stats.misses;
+    return result;
+  }
+
+  void trim(sc::driver::Context const & context)
+  { sc::driver::backend::pools::get(context).trim(); }
+
+  bp::dict statistics()
+  {
+    sc::instrumentation::statistics_type stats = sc::instrumentation::statistics();
+    bp::dict events;
+    for(unsigned int i = 0 ; i < sc::instrumentation::NUM_EVENTS ; ++i)
+      events[sc::instrumentation::to_string((sc::instrumentation::event_type)i)] = bp::make_tuple(stats.events[i].count, stats.events[i].time);
+    bp::dict dispatches;
+    for(unsigned int i = 0 ; i < sc::instrumentation::NUM_EXPRESSION_TYPES ; ++i)
+      dispatches[(sc::expression_type)i] = stats.dispatches[i];
+    bp::dict programs;
+    programs["size"] = stats.programs;
+    programs["bytes"] = stats.program_bytes;
+    programs["hits"] = stats.program_hits;
+    programs["misses"] = stats.program_misses;
+    programs["evictions"] = stats.program_evictions;
+    bp::dict result;
+    result["events"] = events;
+    result["dispatches"] = dispatches;
+    result["programs"] = programs;
+    return result;
+  }
+
+  bp::object enqueue(sc::expression_tree const & tree, unsigned int queue_id, bp::list dependencies, bool tune, int label, std::string const & program_name, bool force_recompile, sc::driver::CompilerOptions const & compiler_options)
   {
       std::list<sc::driver::Event> events;
       std::vector<sc::driver::Event> cdependencies = tools::to_vector<sc::driver::Event>(dependencies);
@@ -92,10 +140,11 @@ namespace detail
       rt::execution_options_type execution_options(queue_id, &events, &cdependencies);
       rt::dispatcher_options_type dispatcher_options(tune, label);
       rt::compilation_options_type compilation_options(program_name, force_recompile);
+      compilation_options.compiler = compiler_options;
       sc::expression_tree::node const & root = tree[tree.root()];
       if(sc::is_assignment(root.binary_operator.op.type))
       {
-          rt::execute(rt::execution_handler(tree, execution_options, dispatcher_options, compilation_options), rt::profiles::get(execution_options.queue(tree.context())));
+          rt::execute(rt::execution_handler(tree, execution_options, dispatcher_options, compilation_options), *rt::profiles::get(execution_options.queue(tree.context())));
           sc::expression_tree::node const & lhs = tree[root.binary_operator.lhs];
           sc::driver::Buffer const & data = sc::driver::make_buffer(tree.context().backend(), lhs.array.handle.cl, lhs.array.handle.cu, false);
           std::shared_ptr<sc::array> parray(new sc::array(lhs.shape, lhs.dtype, lhs.array.start, lhs.ld, data));
@@ -157,6 +206,11 @@ void export_driver()
 
   bp::class_<sc::driver::Device>("device", bp::no_init)
       .add_property("clock_rate", &sc::driver::Device::clock_rate)
+      .add_property("compute_units", &sc::driver::Device::compute_units)
+      .add_property("global_mem_size", &sc::driver::Device::global_mem_size)
+      .add_property("host_unified_memory", &sc::driver::Device::host_unified_memory)
+      .add_property("local_mem_size", &sc::driver::Device::local_mem_size)
+      .add_property("max_sub_devices", &sc::driver::Device::max_sub_devices)
       .add_property("name", &sc::driver::Device::name)
       .add_property("type", &sc::driver::Device::type)
       .add_property("platform", &sc::driver::Device::platform)
@@ -168,13 +222,15 @@ void export_driver()
   bp::class_<sc::driver::Context, boost::noncopyable>("context", bp::no_init)
       .def("__init__", bp::make_constructor(&detail::make_context))
       .def("synchronize", &sc::driver::backend::synchronize)
+      .def("trim", &detail::trim)
+      .add_property("memory_statistics", &detail::memory_statistics)
       .add_property("queues", &detail::get_queues)
       .add_property("backend", &sc::driver::Context::backend)
       ;
 
   bp::class_<sc::driver::CommandQueue>("command_queue", bp::init<sc::driver::Context const &, sc::driver::Device const &>())
       .def("synchronize", &sc::driver::CommandQueue::synchronize)
-      .add_property("profiles", bp::make_function(&rt::profiles::get, bp::return_internal_reference<>()))
+      .add_property("profiles", &detail::get_profiles)
       .add_property("device", bp::make_function(&sc::driver::CommandQueue::device, bp::return_internal_reference<>()))
       ;
 
@@ -182,15 +238,29 @@ void export_driver()
       .add_property("elapsed_time", &sc::driver::Event::elapsed_time)
      ;
 
+  bp::class_<sc::driver::CompilerOptions>("compiler_options")
+      .def_readwrite("fast_math", &sc::driver::CompilerOptions::fast_math)
+      .def_readwrite("denormals_are_zero", &sc::driver::CompilerOptions::denormals_are_zero)
+      .def_readwrite("mad_enable", &sc::driver::CompilerOptions::mad_enable)
+      .def_readwrite("unroll", &sc::driver::CompilerOptions::unroll)
+      .def_readwrite("max_registers", &sc::driver::CompilerOptions::max_registers)
+      .def_readwrite("extra", &sc::driver::CompilerOptions::extra)
+      ;
+
   bp::def("device_type_to_string", &detail::to_string);
 
   bp::def("get_platforms", &detail::get_platforms);
 
-  bp::def("enqueue", &detail::enqueue, (bp::arg("expression"), bp::arg("queue_id") = 0, bp::arg("dependencies")=bp::list(), bp::arg("tune") = false, bp::arg("label")=-1, bp::arg("program_name")="", bp::arg("recompile") = false));
+  bp::def("statistics", &detail::statistics);
+  bp::def("reset_statistics", &sc::instrumentation::reset);
+  bp::def("statistics_summary", &sc::instrumentation::summary);
+
+  bp::def("enqueue", &detail::enqueue, (bp::arg("expression"), bp::arg("queue_id") = 0, bp::arg("dependencies")=bp::list(), bp::arg("tune") = false, bp::arg("label")=-1, bp::arg("program_name")="", bp::arg("recompile") = false, bp::arg("compiler_options") = sc::driver::CompilerOptions()));
 
   bp::class_<default_driver_values_type>("default_type")
           .def_readwrite("queue_properties",&sc::driver::backend::default_queue_properties)
           .def_readwrite("device", &sc::driver::backend::default_device)
+          .def_readwrite("workspace_limit", &sc::driver::backend::workspaces::max_size)
       ;
 
   bp::scope().attr("default") = bp::object(bp::ptr(&default_driver_parameters));
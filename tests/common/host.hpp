@@ -0,0 +1,93 @@
+#ifndef TEST_HOST_HPP_
+#define TEST_HOST_HPP_
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/runtime/out_of_core.h"
+
+//Fixture of the executors over host arrays (out-of-core, partitioned, multi-device)
+
+struct report_type
+{
+  report_type() : nfail(0), npass(0){}
+
+  void operator()(std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << std::flush;
+    if(failed){
+      std::cout << " [Failure!]" << std::endl;
+      nfail++;
+    }
+    else{
+      std::cout << std::endl;
+      npass++;
+    }
+  }
+
+  int status() const
+  { return (nfail>0)?EXIT_FAILURE:EXIT_SUCCESS; }
+
+  int nfail;
+  int npass;
+};
+
+//Runs C = alpha*op(A)*op(B) + beta*C with op(A) of size M x K and op(B) of size K x P, and returns whether it failed
+template<class Engine>
+bool host_gemm(Engine & engine, isaac::int_t M, isaac::int_t K, isaac::int_t P, bool transA, bool transB, float alpha, float beta)
+{
+  typedef isaac::int_t int_t;
+  std::vector<float> cA(M*K), cB(K*P), cC(M*P), cR(M*P);
+  for(int_t i = 0 ; i < M*K ; ++i) cA[i] = (float)(i%13)/13;
+  for(int_t i = 0 ; i < K*P ; ++i) cB[i] = (float)(i%7)/7;
+  for(int_t i = 0 ; i < M*P ; ++i) cC[i] = (float)(i%5)/5;
+  for(int_t j = 0 ; j < P ; ++j)
+    for(int_t i = 0 ; i < M ; ++i){
+      double acc = 0;
+      for(int_t k = 0 ; k < K ; ++k)
+        acc += (transA?cA[k + i*K]:cA[i + k*M])*(transB?cB[j + k*P]:cB[k + j*K]);
+      cR[i + j*M] = alpha*acc + beta*cC[i + j*M];
+    }
+  isaac::runtime::host_array hA(cA.data(), isaac::FLOAT_TYPE, transA?K:M, transA?M:K);
+  isaac::runtime::host_array hB(cB.data(), isaac::FLOAT_TYPE, transB?P:K, transB?K:P);
+  isaac::runtime::host_array hC(cC.data(), isaac::FLOAT_TYPE, M, P);
+  engine.gemm(alpha, hA, transA, hB, transB, beta, hC);
+  bool failed = false;
+  for(int_t i = 0 ; i < M*P ; ++i)
+    failed = failed || std::fabs(cC[i] - cR[i]) > 1e-3*std::fabs(cR[i]) + 1e-3;
+  return failed;
+}
+
+//The four transpositions, with and without beta
+template<class Engine>
+void host_gemms(report_type & report, Engine & engine, isaac::int_t M, isaac::int_t K, isaac::int_t P, std::string const & suffix = "")
+{
+  report("C = A*B" + suffix, host_gemm(engine, M, K, P, false, false, 1, 0));
+  report("C = 2*A*B' + C" + suffix, host_gemm(engine, M, K, P, false, true, 2, 1));
+  report("C = A'*B - C" + suffix, host_gemm(engine, M, K, P, true, false, 1, -1));
+  report("C = A'*B' + 0.5*C" + suffix, host_gemm(engine, M, K, P, true, true, 1, 0.5));
+}
+
+//z = 2*x + y on vectors of size N, and returns whether it failed
+template<class Engine>
+bool host_axpy(Engine & engine, isaac::int_t N)
+{
+  typedef isaac::int_t int_t;
+  std::vector<float> cx(N), cy(N), cz(N);
+  for(int_t i = 0 ; i < N ; ++i){
+    cx[i] = (float)i/N;
+    cy[i] = (float)(N - i)/N;
+  }
+  isaac::runtime::host_array x(cx.data(), isaac::FLOAT_TYPE, N), y(cy.data(), isaac::FLOAT_TYPE, N), z(cz.data(), isaac::FLOAT_TYPE, N);
+  engine.elementwise(z, {x, y}, [](std::vector<isaac::array_base*> const & t){ return 2*(*t[0]) + *t[1]; });
+  bool failed = false;
+  for(int_t i = 0 ; i < N ; ++i)
+    failed = failed || std::fabs(cz[i] - (2*cx[i] + cy[i])) > 1e-4;
+  return failed;
+}
+
+#endif
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "isaac/driver/binary_cache.h"
+
+namespace drv = isaac::driver;
+
+static std::string const path = "binary-cache-test/";
+
+static std::vector<char> binary(size_t size, char seed)
+{
+  std::vector<char> result(size);
+  for(size_t i = 0 ; i < size ; ++i)
+    result[i] = (char)(seed + i*7);
+  return result;
+}
+
+static std::string contents(std::string const & name)
+{
+  std::ifstream file((path + name).c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void overwrite(std::string const & name, std::string const & data)
+{
+  std::ofstream file((path + name).c_str(), std::ios::binary | std::ios::trunc);
+  file.write(data.data(), (std::streamsize)data.size());
+}
+
+//Entries, and their total size in bytes
+static size_t entries(size_t & bytes)
+{
+  size_t count = 0;
+  bytes = 0;
+  DIR * dir = opendir(path.c_str());
+  while(struct dirent * ent = readdir(dir))
+  {
+    struct stat st;
+    std::string name = path + ent->d_name;
+    if(ent->d_name[0]=='.' || stat(name.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+      continue;
+    count++;
+    bytes += (size_t)st.st_size;
+  }
+  closedir(dir);
+  return count;
+}
+
+static void clear()
+{
+  DIR * dir = opendir(path.c_str());
+  if(!dir)
+    return;
+  while(struct dirent * ent = readdir(dir))
+    if(ent->d_name[0]!='.')
+      std::remove((path + ent->d_name).c_str());
+  closedir(dir);
+  std::remove((path + ".lock").c_str());
+}
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  clear();
+  mkdir(path.c_str(), 0755);
+  drv::BinaryCache cache(path, "test-");
+  std::vector<char> x = binary(1000, 1), y;
+
+  cache.store("valid", x);
+  report("round trip", !cache.load("valid", y) || y!=x);
+  report("missing entry", cache.load("missing", y));
+  report("other tag", drv::BinaryCache(path, "other-").load("valid", y));
+
+  //Corrupted entries are rejected
+  std::string entry = contents("valid");
+  overwrite("truncated", entry.substr(0, entry.size() - 10));
+  report("truncated entry", cache.load("truncated", y));
+  overwrite("trailing", entry + "junk");
+  report("trailing bytes", cache.load("trailing", y));
+  std::string corrupted = entry;
+  corrupted[corrupted.size() - 1] ^= 1;
+  overwrite("checksum", corrupted);
+  report("bad checksum", cache.load("checksum", y));
+  std::string version = entry;
+  version[8]++;
+  overwrite("version", version);
+  report("wrong version", cache.load("version", y));
+  overwrite("header", entry.substr(0, 4));
+  report("truncated header", cache.load("header", y));
+
+  //Concurrent writers of a key never leave a corrupted entry, and readers only see complete ones
+  std::vector<std::vector<char> > versions;
+  for(char t = 0 ; t < 4 ; ++t)
+    versions.push_back(binary(1000 + 3000*t, t));
+  std::atomic<bool> torn(false);
+  std::vector<std::thread> threads;
+  for(size_t t = 0 ; t < versions.size() ; ++t)
+    threads.push_back(std::thread([&, t]{
+      std::vector<char> read;
+      for(int i = 0 ; i < 50 ; ++i){
+        cache.store("shared", versions[t]);
+        if(cache.load("shared", read) && std::find(versions.begin(), versions.end(), read)==versions.end())
+          torn = true;
+      }
+    }));
+  for(std::thread & thread: threads)
+    thread.join();
+  size_t bytes;
+  bool found = cache.load("shared", y) && std::find(versions.begin(), versions.end(), y)!=versions.end();
+  report("concurrent writers", torn || !found);
+
+  //The directory stays within budget, and the entry just stored is kept
+  clear();
+  cache.store("first", x);
+  size_t size = contents("first").size();
+  drv::BinaryCache::max_size = 4*size;
+  for(char i = 0 ; i < 10 ; ++i)
+    cache.store(std::string("entry") + (char)('0' + i), x);
+  size_t count = entries(bytes);
+  report("eviction", bytes > drv::BinaryCache::max_size || count < 3 || !cache.load("entry9", y));
+  //Within the budget counted by the process, storing does not scan the directory
+  for(char i = 0 ; i < 10 ; ++i)
+    overwrite(std::string("other") + (char)('0' + i), entry);
+  cache.trim();
+  size_t before = entries(bytes);
+  for(char i = 0 ; i < 10 ; ++i)
+    overwrite(std::string("late") + (char)('0' + i), entry);
+  cache.store("last", x);
+  report("no scan within budget", entries(bytes)!=before + 11);
+  //Entries written behind the process' back are counted by trim()
+  cache.trim();
+  entries(bytes);
+  report("trim", bytes > drv::BinaryCache::max_size);
+
+  clear();
+  rmdir(path.c_str());
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
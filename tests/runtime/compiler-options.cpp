@@ -0,0 +1,98 @@
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/program.h"
+#include "isaac/driver/recording.h"
+#include "isaac/runtime/execute.h"
+#include "isaac/tools/cpp/string.hpp"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+namespace rt = isaac::runtime;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  drv::Context const & context = drv::backend::contexts::get_default();
+  drv::Device const & device = context.device();
+
+  //Flags, for the OpenCL device of the host backend
+  drv::CompilerOptions options;
+  report("default flags", !options.flags(device).empty());
+  options.fast_math = true;
+  options.denormals_are_zero = true;
+  options.mad_enable = true;
+  options.max_registers = 32;
+  options.extra = "  -DA=1   -DB ";
+  std::vector<std::string> flags = options.flags(device);
+  std::vector<std::string> expected = {"-cl-fast-relaxed-math", "-cl-denorms-are-zero", "-cl-mad-enable", "-DA=1", "-DB"};
+  if(device.vendor()==drv::Device::Vendor::NVIDIA)
+    expected.insert(expected.begin() + 3, "-cl-nv-maxrregcount=32");
+  report("flags", flags!=expected);
+
+  //Unroll factors only apply to bare pragmas
+  drv::CompilerOptions unroll;
+  std::string source = "#pragma unroll\nfor(;;);\n#pragma unroll 2\nfor(;;);\n";
+  report("no unroll factor", unroll.apply(source)!=source);
+  unroll.unroll = 4;
+  report("unroll factor", unroll.apply(source)!="#pragma unroll 4\nfor(;;);\n#pragma unroll 2\nfor(;;);\n");
+
+  //Every field changes the hash, and extra flags cannot be confused with the other fields
+  std::vector<drv::CompilerOptions> variants(8);
+  variants[1].fast_math = true;
+  variants[2].denormals_are_zero = true;
+  variants[3].mad_enable = true;
+  variants[4].unroll = 2;
+  variants[5].max_registers = 64;
+  variants[6].extra = "-DX";
+  variants[7].extra = "-DY";
+  std::set<uint64_t> hashes;
+  std::set<std::string> fingerprints;
+  for(drv::CompilerOptions const & variant: variants)
+  {
+    hashes.insert(variant.hash());
+    fingerprints.insert(variant.fingerprint());
+  }
+  report("hashes", hashes.size()!=variants.size() || fingerprints.size()!=variants.size()
+                   || drv::CompilerOptions().hash()!=variants[0].hash() || variants[6].fingerprint()==variants[0].fingerprint() + "-DX");
+
+  //Options reach the device compiler, and programs built with other options are not reused
+  drv::recording::clear();
+  drv::Program(context, "__kernel void f(__global float* x){ x[0] = 1; }", options);
+  std::vector<drv::recording::build_type> builds = drv::recording::builds();
+  report("build options", builds.size()!=1 || builds[0].options!=sc::tools::join(flags, " "));
+
+  int_t N = 1000;
+  sc::array x(N, sc::FLOAT_TYPE), y(N, sc::FLOAT_TYPE);
+  rt::compilation_options_type relaxed;
+  relaxed.async = false;
+  relaxed.compiler.fast_math = true;
+  rt::compilation_options_type strict = relaxed;
+  strict.compiler.fast_math = false;
+  auto run = [&](rt::compilation_options_type const & compilation)
+  {
+    drv::recording::clear();
+    rt::execute(rt::execution_handler(sc::assign(x, y + 1), rt::execution_options_type(), rt::dispatcher_options_type(), compilation));
+    std::vector<drv::recording::build_type> builds = drv::recording::builds();
+    return builds.empty()?std::string("(none)"):builds.back().options;
+  };
+  report("relaxed expression", run(relaxed)!="-cl-fast-relaxed-math");
+  report("strict expression", run(strict)!="");
+  report("relaxed expression, cached", run(relaxed)!="(none)");
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
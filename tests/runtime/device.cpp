@@ -0,0 +1,61 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/driver/backend.h"
+#include "isaac/driver/context.h"
+#include "isaac/driver/device.h"
+
+namespace drv = isaac::driver;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  drv::Device const & device = drv::backend::contexts::get_default().device();
+  drv::Device::properties_type const & properties = device.properties();
+
+  //Values answered by the host and recording platforms
+  bool host = device.type()==drv::Device::CPU;
+  std::vector<size_t> sizes = {1024, 1024, 64};
+  report("properties", properties.name!=(host?"Host device":"Recording device") || properties.vendor_str!="ISAAC" || properties.vendor!=drv::Device::Vendor::UNKNOWN
+                       || properties.address_bits!=8*sizeof(size_t) || properties.clock_rate!=1000 || properties.global_mem_size!=(size_t)1 << 32
+                       || properties.local_mem_size!=48 << 10 || properties.mem_base_addr_align!=128 || properties.max_work_group_size!=1024
+                       || properties.max_work_item_sizes!=sizes || properties.fp64_support!=host || properties.host_unified_memory!=host
+                       || properties.compute_units==0 || properties.max_sub_devices!=properties.compute_units);
+  //Vendor-specific queries do not fail on other vendors' devices
+  report("vendor-specific properties", properties.warp_wavefront_size!=0 || properties.nv_compute_capability!=std::make_pair(0u, 0u));
+
+  //Accessors read the snapshot
+  report("accessors", device.name()!=properties.name || device.vendor()!=properties.vendor || device.architecture()!=properties.architecture
+                      || device.type()!=properties.type || device.address_bits()!=properties.address_bits || device.clock_rate()!=properties.clock_rate
+                      || device.compute_units()!=properties.compute_units || device.global_mem_size()!=properties.global_mem_size
+                      || device.local_mem_size()!=properties.local_mem_size || device.mem_base_addr_align()!=properties.mem_base_addr_align
+                      || device.max_work_group_size()!=properties.max_work_group_size || device.max_work_item_sizes()!=properties.max_work_item_sizes
+                      || device.extensions()!=properties.extensions || device.fp64_support()!=properties.fp64_support
+                      || device.max_sub_devices()!=properties.max_sub_devices || device.platform().name()!=properties.platform.name());
+
+  //Copies, and devices wrapping the same handle again, share the snapshot
+  drv::Device copy = device;
+  drv::Device wrapped(device.handle().cl(), false);
+  report("shared snapshot", &copy.properties()!=&properties || &wrapped.properties()!=&properties);
+
+  //Sub-devices have their own
+  std::vector<drv::Device> parts;
+  if(properties.compute_units >= 2)
+  {
+    device.partition_equally(properties.compute_units/2, parts);
+    report("sub-devices", parts.empty() || &parts[0].properties()==&properties || parts[0].compute_units()!=properties.compute_units/2
+                          || parts[0].name()!=properties.name);
+  }
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/common/instrumentation.h"
+
+namespace sc = isaac;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  int_t M = 67, K = 45, N = 53;
+  std::vector<float> cA(M*K), cB(K*N), cD(M*N), cbias(N), crow(M), cP(M*N, 0), cS(M*M, 0), cT(M*M), cW(2*M*N);
+  for(int_t i = 0 ; i < M*K ; ++i) cA[i] = (float)(i % 17)/17 - .5f;
+  for(int_t i = 0 ; i < K*N ; ++i) cB[i] = (float)(i % 13)/13 - .5f;
+  for(int_t i = 0 ; i < M*N ; ++i) cD[i] = std::cos((float)i);
+  for(int_t j = 0 ; j < N ; ++j) cbias[j] = std::sin((float)j);
+  for(int_t i = 0 ; i < M ; ++i) crow[i] = 1 + (float)i/M;
+  for(int_t i = 0 ; i < M ; ++i)
+    for(int_t j = 0 ; j < N ; ++j)
+      for(int_t k = 0 ; k < K ; ++k)
+        cP[i + j*M] += cA[i + k*M]*cB[k + j*K];
+  //A square product, so that C can be transposed
+  for(int_t i = 0 ; i < M ; ++i)
+    for(int_t j = 0 ; j < M ; ++j)
+      for(int_t k = 0 ; k < K ; ++k)
+        cS[i + j*M] += cA[i + k*M]*cA[k + j*K];
+  for(int_t i = 0 ; i < M*M ; ++i) cT[i] = std::cos((float)i/5);
+  for(int_t i = 0 ; i < 2*M*N ; ++i) cW[i] = std::sin((float)i/3);
+
+  sc::array A(M, K, cA), B(K, N, cB), D(M, N, cD), C(M, N, cD), E(K, M, cA), S(M, M, cT), W(M, 2*N, cW), bias(cbias), row(crow);
+
+  //When FUSED, the epilogue must be computed by the matrix product kernel itself. Otherwise the
+  //product must be computed first, into a temporary. cC holds OUT, of COLS columns, beforehand
+  #define ADD_EPILOGUE_TEST(NAME, FUSED, OUT, COLS, EXPR, CPU_EXPR) \
+  {\
+    std::cout << NAME << "..." << std::flush;\
+    std::vector<float> cC(M*COLS), cx(M*COLS);\
+    sc::copy(OUT, cC);\
+    sc::instrumentation::reset();\
+    EXPR;\
+    sc::copy(OUT, cx);\
+    sc::instrumentation::statistics_type stats = sc::instrumentation::statistics();\
+    uint64_t dispatches = 0;\
+    for(unsigned int t = 0 ; t < sc::instrumentation::NUM_EXPRESSION_TYPES ; ++t)\
+      dispatches += stats.dispatches[t];\
+    bool failed = FUSED?(dispatches!=1 || stats.dispatches[sc::MATRIX_PRODUCT_NN]!=1):dispatches<2;\
+    for(int_t i = 0 ; i < M && !failed ; ++i)\
+      for(int_t j = 0 ; j < COLS && !failed ; ++j){\
+        float ref = CPU_EXPR;\
+        failed = std::fabs(cx[i + j*M] - ref) > 1e-3*std::max(1.f, std::fabs(ref));\
+      }\
+    if(failed){\
+      std::cout << " [Failure!]" << std::endl;\
+      nfail++;\
+    }\
+    else{\
+      std::cout << std::endl;\
+      npass++;\
+    }\
+  }
+
+  ADD_EPILOGUE_TEST("C = relu(dot(A,B) + bias)", true, C, N, C = sc::maximum(dot(A, B) + bias, 0.f),
+                    std::max(cP[i + j*M] + cbias[j], 0.f))
+  ADD_EPILOGUE_TEST("C = sigmoid(2*dot(A,B)) + D", true, C, N, C = 1.f/(1.f + sc::exp(-2.f*dot(A, B))) + D,
+                    1/(1 + std::exp(-2*cP[i + j*M])) + cD[i + j*M])
+  ADD_EPILOGUE_TEST("C = dot(A,B)*row", true, C, N, C = dot(A, B)*sc::reshape(row, {M, 1}),
+                    cP[i + j*M]*crow[i])
+  ADD_EPILOGUE_TEST("C = tanh(dot(A,B) + C)", true, C, N, C = sc::tanh(dot(A, B) + C),
+                    std::tanh(cP[i + j*M] + cC[i + j*M]))
+
+  //Other views of the buffer of C are read while the work-groups write C back
+  ADD_EPILOGUE_TEST("S = tanh(dot(A,E) + S')", false, S, M, S = sc::tanh(dot(A, E) + S.T),
+                    std::tanh(cS[i + j*M] + cC[j + i*M]))
+  sc::view W0(W, sc::all, {0, N}), W1(W, sc::all, {N, 2*N});
+  ADD_EPILOGUE_TEST("W[:, :N] = tanh(dot(A,B) + W[:, N:])", false, W0, N, W0 = sc::tanh(dot(A, B) + W1),
+                    std::tanh(cP[i + j*M] + cW[i + (j + N)*M]))
+  sc::view W2(W, sc::all, {1, N + 1});
+  sc::copy(W, cW);
+  ADD_EPILOGUE_TEST("W[:, :N] = tanh(dot(A,B) + W[:, 1:N+1])", false, W0, N, W0 = sc::tanh(dot(A, B) + W2),
+                    std::tanh(cP[i + j*M] + cW[i + (j + 1)*M]))
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
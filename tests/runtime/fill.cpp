@@ -0,0 +1,77 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/buffer.h"
+#include "isaac/driver/command_queue.h"
+#include "isaac/driver/recording.h"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+
+int main()
+{
+  //Must precede any other call to ISAAC
+  drv::recording::enable();
+
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+  //Kinds and sizes of the transfers recorded since the last clear
+  auto transfers = []
+  {
+    std::vector<std::pair<drv::recording::command_type::kind_type, size_t> > result;
+    for(drv::recording::command_type const & command: drv::recording::commands())
+      if(command.kind!=drv::recording::command_type::KERNEL && command.kind!=drv::recording::command_type::MARKER)
+        result.push_back(std::make_pair(command.kind, command.bytes));
+    return result;
+  };
+  typedef std::vector<std::pair<drv::recording::command_type::kind_type, size_t> > transfers_type;
+  drv::recording::command_type::kind_type const FILL = drv::recording::command_type::FILL;
+
+  drv::Context const & context = drv::backend::contexts::get_default();
+  drv::CommandQueue & queue = drv::backend::queues::get(context, 0);
+  bool fill = context.device().fill_support();
+  report("fill support", !fill);
+
+  //Scalars built from host values, and assigned host values, are filled rather than written
+  drv::recording::clear();
+  sc::scalar s(sc::value_scalar(3.5f), context);
+  report("scalar from a host value", transfers()!=transfers_type{{FILL, 4}} || (float)s!=3.5f);
+  drv::recording::clear();
+  s = 7;
+  report("scalar assigned a host value", transfers()!=transfers_type{{FILL, 4}} || (float)s!=7);
+  sc::scalar d(sc::value_scalar(1e100), context);
+  report("double scalar", (double)d!=1e100);
+
+  //Patterns are repeated over the range, and need not outlive the call
+  drv::Buffer buffer(context, 64);
+  std::vector<int> init(16, -1), result(16);
+  queue.write(buffer, true, 0, 64, init.data());
+  drv::recording::clear();
+  {
+    short pattern[2] = {1, 2};
+    queue.fill(buffer, 8, 32, pattern, sizeof(pattern));
+    pattern[0] = pattern[1] = 0;
+  }
+  report("fill recorded", transfers()!=transfers_type{{FILL, 32}});
+  queue.read(buffer, true, 0, 64, result.data());
+  short pattern[2] = {1, 2};
+  int repeated;
+  std::memcpy(&repeated, pattern, sizeof(repeated));
+  bool failed = false;
+  for(unsigned int i = 0 ; i < 16 ; ++i)
+    failed = failed || result[i]!=((i >= 2 && i < 10)?repeated:-1);
+  report("fill pattern and range", failed);
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/host.h"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  //Must precede any other call to ISAAC
+  drv::host::enable();
+
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+  auto check = [&](std::string const & name, std::vector<float> const & ref, sc::array_base const & x)
+  {
+    std::vector<float> cx(ref.size());
+    sc::copy(x, cx);
+    bool failed = false;
+    for(size_t i = 0 ; i < ref.size() ; ++i)
+      failed = failed || std::fabs(cx[i] - ref[i]) > 1e-3*std::max(1.f, std::fabs(ref[i]));
+    report(name, failed);
+  };
+
+  drv::Device const & device = drv::backend::contexts::get_default().device();
+  report("device", device.type()!=drv::Device::Type::CPU);
+  //Cached kernels are keyed by the instruction set they target
+  std::string const & target = drv::host::target();
+  report("target", target!="generic" && target.compare(0, 7, "native-")!=0);
+
+  int_t N = 10007;
+  std::vector<float> cy(N), cz(N), cx(N);
+  for(int_t i = 0 ; i < N ; ++i){
+    cy[i] = (float)i/N;
+    cz[i] = std::cos((float)i);
+  }
+  sc::array x(N, sc::FLOAT_TYPE), y(cy), z(cz);
+
+  //Elementwise
+  x = y + 2*sc::exp(z);
+  for(int_t i = 0 ; i < N ; ++i)
+    cx[i] = cy[i] + 2*std::exp(cz[i]);
+  check("x = y + 2*exp(z)", cx, x);
+
+  //Reductions
+  float csum = 0, cmax = -INFINITY;
+  for(int_t i = 0 ; i < N ; ++i){
+    csum += cy[i]*cz[i];
+    cmax = std::max(cmax, cz[i]);
+  }
+  sc::scalar s(sc::FLOAT_TYPE);
+  s = dot(y, z);
+  report("s = dot(y, z)", std::fabs((float)s - csum) > 1e-3*std::fabs(csum));
+  s = max(z);
+  report("s = max(z)", (float)s!=cmax);
+
+  //Matrix product
+  int_t M = 67, K = 45, P = 53;
+  std::vector<float> cA(M*K), cB(K*P), cC(M*P, 0);
+  for(int_t i = 0 ; i < M*K ; ++i) cA[i] = (float)(i % 17)/17;
+  for(int_t i = 0 ; i < K*P ; ++i) cB[i] = (float)(i % 13)/13;
+  for(int_t i = 0 ; i < M ; ++i)
+    for(int_t j = 0 ; j < P ; ++j)
+      for(int_t k = 0 ; k < K ; ++k)
+        cC[i + j*M] += cA[i + k*M]*cB[k + j*K];
+  sc::array A(M, K, cA), B(K, P, cB), C(M, P, sc::FLOAT_TYPE);
+  C = dot(A, B);
+  check("C = A*B", cC, C);
+
+  //Row sums
+  std::vector<float> crow(M, 0);
+  for(int_t i = 0 ; i < M ; ++i)
+    for(int_t k = 0 ; k < K ; ++k)
+      crow[i] += cA[i + k*M];
+  sc::array row(M, sc::FLOAT_TYPE);
+  row = sum(A, 1);
+  check("row = sum(A, 1)", crow, row);
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
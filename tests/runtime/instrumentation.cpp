@@ -0,0 +1,84 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "isaac/array.h"
+#include "isaac/common/instrumentation.h"
+#include "isaac/driver/backend.h"
+#include "isaac/runtime/execute.h"
+
+namespace sc = isaac;
+namespace rt = isaac::runtime;
+namespace instr = isaac::instrumentation;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  //Events
+  instr::reset();
+  instr::statistics_type stats = instr::statistics();
+  bool failed = false;
+  for(unsigned int i = 0 ; i < instr::NUM_EVENTS ; ++i)
+    failed = failed || stats.events[i].count!=0 || stats.events[i].time!=0;
+  for(unsigned int i = 0 ; i < instr::NUM_EXPRESSION_TYPES ; ++i)
+    failed = failed || stats.dispatches[i]!=0;
+  report("reset", failed);
+  instr::record(instr::PREDICTION, 2000);
+  instr::record(instr::PREDICTION, 500);
+  {
+    instr::timer timer(instr::CODEGEN);
+  }
+  stats = instr::statistics();
+  report("events", stats.events[instr::PREDICTION].count!=2 || std::fabs(stats.events[instr::PREDICTION].time - 2.5e-6) > 1e-12
+                   || stats.events[instr::CODEGEN].count!=1 || stats.events[instr::CODEGEN].time < 0);
+  try{
+    instr::to_string(instr::NUM_EVENTS);
+    report("unknown event", true);
+  }catch(std::invalid_argument const &){
+    report("unknown event", false);
+  }
+
+  //Dispatches, code generation and compilation
+  int_t N = 64;
+  sc::array x(N, sc::FLOAT_TYPE), y(N, sc::FLOAT_TYPE), A(N, N, sc::FLOAT_TYPE), B(N, N, sc::FLOAT_TYPE), C(N, N, sc::FLOAT_TYPE);
+  sc::scalar s(sc::FLOAT_TYPE);
+  rt::compilation_options_type options;
+  options.async = false;
+  auto run = [&](sc::expression_tree const & tree)
+  { rt::execute(rt::execution_handler(tree, rt::execution_options_type(), rt::dispatcher_options_type(), options)); };
+  instr::reset();
+  run(sc::assign(x, y + 1));
+  run(sc::assign(s, sum(x)));
+  run(sc::assign(C, dot(A, B)));
+  run(sc::assign(C, dot(A.T, B)));
+  stats = instr::statistics();
+  report("dispatches", stats.dispatches[sc::ELEMENTWISE_1D]!=1 || stats.dispatches[sc::REDUCE_1D]!=1
+                       || stats.dispatches[sc::MATRIX_PRODUCT_NN]!=1 || stats.dispatches[sc::MATRIX_PRODUCT_TN]!=1);
+  uint64_t hits = stats.events[instr::BINARY_CACHE_HIT].count, misses = stats.events[instr::BINARY_CACHE_MISS].count;
+  report("compilations", stats.events[instr::CODEGEN].count < 4 || hits + misses < 4 || stats.events[instr::OPENCL_COMPILATION].count!=misses);
+  //Programs are reused, without code generation
+  size_t programs = stats.programs, program_hits = stats.program_hits;
+  instr::reset();
+  run(sc::assign(x, y + 1));
+  stats = instr::statistics();
+  report("program cache", stats.dispatches[sc::ELEMENTWISE_1D]!=1 || stats.events[instr::CODEGEN].count!=0
+                          || stats.programs!=programs || stats.program_hits<=program_hits);
+
+  //Summary
+  std::string summary = instr::summary();
+  report("summary", summary.find("elementwise_1d")==std::string::npos || summary.find("matrix_product")!=std::string::npos
+                    || summary.find("codegen")==std::string::npos);
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+#include <iostream>
+#include <string>
+
+#include "isaac/jit/generation/engine/stream.h"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+
+static std::string generate(drv::backend_type backend, std::string const & code, unsigned int tabs = 0)
+{
+  sc::kernel_generation_stream stream(backend);
+  for(unsigned int i = 0 ; i < tabs ; ++i)
+    stream.inc_tab();
+  stream << code << std::endl;
+  return stream.str();
+}
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  std::string kernel = "$KERNEL void f($GLOBAL float* x, $LOCAL_PTR float* y){ $LOCAL float z[4]; x[$GLOBAL_IDX_0] = $MAD(y[$LOCAL_IDX_1], z[$GROUP_IDX_2], $GLOBAL_SIZE_0); $LOCAL_BARRIER; }";
+  report("opencl keywords", generate(drv::OPENCL, kernel)!="__kernel void f(__global float* x, __local float* y){ __local float z[4]; "
+                                                            "x[get_global_id(0)] = mad(y[get_local_id(1)], z[get_group_id(2)], get_global_size(0)); barrier(CLK_LOCAL_MEM_FENCE); }\n");
+  report("cuda keywords", generate(drv::CUDA, kernel)!="extern \"C\" __global__ void f( float* x,  float* y){ __shared__ float z[4]; "
+                                                       "x[(blockIdx.x*blockDim.x + threadIdx.x)] = fma(y[threadIdx.y], z[blockIdx.z], (blockDim.x*gridDim.x)); __syncthreads(); }\n");
+
+  //The longest keyword wins, and the text that follows it is kept
+  report("longest keyword", generate(drv::OPENCL, "$LOCAL_SIZE_1 $LOCAL_SIZE $LOCAL_X $GLOBAL_IDX_2x")!="get_local_size(1) __local_SIZE __local_X get_global_id(2)x\n");
+  //Unknown keywords and lone dollars are left alone
+  report("unknown keywords", generate(drv::OPENCL, "$UNKNOWN $$GLOBAL a$ $")!="$UNKNOWN $__global a$ $\n");
+  report("no keywords", generate(drv::CUDA, "int x = 0;")!="int x = 0;\n");
+
+  //Lines are indented when flushed, keywords are substituted once the kernel is complete
+  sc::kernel_generation_stream stream(drv::CUDA);
+  stream << "$KERNEL void f(){" << std::endl;
+  stream.inc_tab();
+  stream << "int i = $LOCAL_IDX_0;" << std::endl;
+  stream.dec_tab();
+  stream << "}" << std::endl;
+  report("indentation", stream.str()!="extern \"C\" __global__ void f(){\n  int i = threadIdx.x;\n}\n");
+  report("tabs", generate(drv::OPENCL, "$MAD", 2)!="    mad\n");
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
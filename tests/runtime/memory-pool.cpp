@@ -0,0 +1,126 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/memory_pool.h"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  drv::Context const & context = drv::backend::contexts::get_default();
+  drv::CommandQueue & queue = drv::backend::queues::get(context, 0);
+  drv::CommandQueue & other = drv::backend::queues::get(context, 1);
+  drv::MemoryPool pool(context);
+  size_t alignment = std::max<size_t>(256, context.device().mem_base_addr_align());
+
+  //Size classes: four per power of two, aligned for sub-buffers
+  bool failed = false;
+  for(size_t size = 1 ; size < (size_t(1) << 24) ; size = size*3 + 1)
+  {
+    size_t bytes = pool.size_class(size);
+    failed = failed || bytes < size || bytes % alignment || bytes - size >= std::max(bytes/4, alignment);
+  }
+  failed = failed || pool.size_class(1000)!=pool.size_class(1024) || pool.size_class(1025)==pool.size_class(1024);
+  report("size classes", failed);
+
+  //Small blocks of a class are carved out of a single slab
+  std::vector<std::shared_ptr<void> > owners(8);
+  std::set<cl_mem> handles;
+  size_t bytes = pool.size_class(1000);
+  for(std::shared_ptr<void> & owner: owners)
+    handles.insert(pool.allocate(1000, queue, owner).cl());
+  drv::MemoryPool::statistics_type stats = pool.statistics();
+  report("slab carving", handles.size()!=owners.size() || stats.slabs!=1 || stats.reserved!=drv::MemoryPool::SLAB_SIZE/bytes*bytes
+                         || stats.in_use!=8*bytes || stats.misses!=8 || stats.hits!=0);
+
+  //Released blocks are reused for the same class, and only for it
+  std::shared_ptr<void> owner, bigger;
+  cl_mem released = pool.allocate(1000, queue, owner).cl();
+  owner.reset();
+  cl_mem unrelated = pool.allocate(3000, queue, bigger).cl();
+  cl_mem reused = pool.allocate(900, queue, owner).cl();
+  stats = pool.statistics();
+  report("size-class reuse", reused!=released || unrelated==released || stats.hits!=1 || stats.misses!=10 || stats.slabs!=2
+                             || stats.in_use!=9*bytes + pool.size_class(3000) || stats.peak!=stats.in_use);
+  //Large blocks get a slab of their own
+  std::shared_ptr<void> large;
+  size_t reserved = stats.reserved;
+  pool.allocate(drv::MemoryPool::SMALL_SIZE + 1, queue, large);
+  stats = pool.statistics();
+  report("large blocks", stats.slabs!=3 || stats.reserved!=reserved + pool.size_class(drv::MemoryPool::SMALL_SIZE + 1));
+
+  //A block last used by another queue is handed out after the idle ones, once that queue is done
+  std::shared_ptr<void> first, second;
+  cl_mem on_queue = pool.allocate(1000, queue, first).cl();
+  cl_mem on_other = pool.allocate(1000, other, second).cl();
+  first.reset();
+  second.reset();
+  cl_mem x = pool.allocate(1000, other, first).cl();
+  cl_mem y = pool.allocate(1000, other, second).cl();
+  report("cross-queue reuse", x!=on_other || y!=on_queue);
+
+  //Unused slabs go back to the driver, the others stay
+  owners.clear();
+  owner.reset();
+  bigger.reset();
+  first.reset();
+  second.reset();
+  pool.trim();
+  stats = pool.statistics();
+  report("trim with a block in use", stats.slabs!=1 || stats.reserved!=pool.size_class(drv::MemoryPool::SMALL_SIZE + 1) || stats.in_use!=stats.reserved);
+  large.reset();
+  pool.trim();
+  stats = pool.statistics();
+  report("trim", stats.slabs!=0 || stats.reserved!=0 || stats.in_use!=0);
+
+  //Blocks may outlive their pool
+  {
+    drv::MemoryPool temporary(context);
+    temporary.allocate(1000, queue, owner);
+  }
+  owner.reset();
+
+  //Temporaries released by a queue and reused by another still hold the right values
+  int_t N = 100000;
+  std::vector<float> cx(N), cz(N);
+  for(int_t i = 0 ; i < N ; ++i)
+    cx[i] = (float)i/N;
+  sc::array x0(cx), z(N, sc::FLOAT_TYPE);
+  {
+    drv::queue_guard guard(1);
+    sc::array t(N, sc::FLOAT_TYPE);
+    t = x0 + 1;
+    z = 2*t;
+  }
+  {
+    drv::queue_guard guard(2);
+    sc::array t(N, sc::FLOAT_TYPE);
+    t = x0 - 1;
+    z = z + t;
+  }
+  sc::copy(z, cz);
+  failed = false;
+  for(int_t i = 0 ; i < N ; ++i)
+    failed = failed || std::fabs(cz[i] - (3*cx[i] + 1)) > 1e-4;
+  report("temporaries across queues", failed);
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/device.h"
+#include "isaac/runtime/multi_device.h"
+#include "host.hpp"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+namespace rt = isaac::runtime;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  report_type report;
+
+  //Two halves of the default device when it can be partitioned, the device twice otherwise
+  drv::Context const & context = drv::backend::contexts::get_default();
+  std::vector<drv::Device> devices;
+  context.device().partition_equally(std::max<size_t>(context.device().compute_units()/2, 1), devices);
+  std::vector<drv::Context const *> contexts;
+  for(drv::Device const & device: devices)
+    contexts.push_back(&drv::backend::contexts::get(device));
+  if(contexts.size() < 2)
+    contexts.push_back(&context);
+  rt::multi_device devs(contexts);
+
+  //Predicted weights
+  report("z = 2*x + y", host_axpy(devs, 10007));
+  host_gemms(report, devs, 97, 83, 71);
+
+  //Uneven weights
+  devs.weights = std::vector<double>(contexts.size(), 1);
+  devs.weights.back() = 3;
+  report("z = 2*x + y (weighted)", host_axpy(devs, 10007));
+  host_gemms(report, devs, 97, 83, 71, " (weighted)");
+
+  //A device without weight gets no work
+  devs.weights = std::vector<double>(contexts.size(), 1);
+  devs.weights.front() = 0;
+  report("z = 2*x + y (idle device)", host_axpy(devs, 1000));
+  host_gemms(report, devs, 13, 11, 10, " (idle device)");
+
+  //Fewer units than devices, and weights far apart that round a part to nothing
+  devs.weights = std::vector<double>(contexts.size(), 1);
+  report("z = 2*x + y (N = 1)", host_axpy(devs, 1));
+  host_gemms(report, devs, 3, 2, 1, " (P = 1)");
+  devs.weights.back() = 1000;
+  report("z = 2*x + y (N = 7, skewed)", host_axpy(devs, 7));
+
+  return report.status();
+}
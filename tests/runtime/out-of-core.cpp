@@ -0,0 +1,91 @@
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/context.h"
+#include "isaac/runtime/out_of_core.h"
+#include "host.hpp"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+namespace rt = isaac::runtime;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  report_type report;
+
+  //Caps the footprint well below the operands so that every operation is tiled
+  rt::out_of_core engine;
+  engine.footprint = 1 << 14;
+
+  int_t N = 10007;
+  std::vector<float> cx(N), cy(N);
+  for(int_t i = 0 ; i < N ; ++i){
+    cx[i] = (float)i/N;
+    cy[i] = (float)(N - i)/N;
+  }
+  rt::host_array x(cx.data(), sc::FLOAT_TYPE, N), y(cy.data(), sc::FLOAT_TYPE, N);
+
+  //Elementwise
+  report("z = 2*x + y", host_axpy(engine, N));
+
+  //Reductions
+  double csum = 0, cdot = 0;
+  for(int_t i = 0 ; i < N ; ++i){
+    csum += cx[i];
+    cdot += cx[i]*cy[i];
+  }
+  float sum = engine.reduce({x}, [](std::vector<sc::array_base*> const & t){ return sc::sum(*t[0]); });
+  report("sum(x)", std::fabs(sum - csum)/csum > 1e-4);
+  float dot = engine.reduce({x, y}, [](std::vector<sc::array_base*> const & t){ return sc::dot(*t[0], *t[1]); });
+  report("dot(x, y)", std::fabs(dot - cdot)/cdot > 1e-4);
+  float max = engine.reduce({x}, [](std::vector<sc::array_base*> const & t){ return sc::max(*t[0]); }, [](sc::array_base const & p){ return sc::max(p); });
+  report("max(x)", max != cx[N - 1]);
+
+  //Matrices, with a leading dimension larger than the number of rows
+  int_t M = 97, K = 83, ld = M + 3;
+  std::vector<float> cA(ld*K), cD(ld*K);
+  for(int_t i = 0 ; i < ld*K ; ++i) cA[i] = (float)(i%13)/13;
+  rt::host_array A(cA.data(), sc::FLOAT_TYPE, M, K, ld), D(cD.data(), sc::FLOAT_TYPE, M, K, ld);
+  engine.elementwise(D, {A}, [](std::vector<sc::array_base*> const & t){ return *t[0] + 1; });
+  bool failed = false;
+  for(int_t j = 0 ; j < K ; ++j)
+    for(int_t i = 0 ; i < M ; ++i)
+      failed = failed || std::fabs(cD[i + j*ld] - (cA[i + j*ld] + 1)) > 1e-4;
+  report("D = A + 1", failed);
+
+  //GEMM
+  host_gemms(report, engine, M, K, 71);
+
+  //Tiles of a single unit (element or block of 1x1), so that both slots of every operand are reused many times
+  rt::out_of_core unit;
+  unit.footprint = 6*sizeof(float);
+  report("z = 2*x + y (1-element tiles)", host_axpy(unit, 33));
+  float usum = unit.reduce({x}, [](std::vector<sc::array_base*> const & t){ return sc::sum(*t[0]); });
+  report("sum(x) (1-element tiles)", std::fabs(usum - csum)/csum > 1e-4);
+  host_gemms(report, unit, 5, 4, 3, " (1x1 tiles)");
+
+  //Operands smaller than a tile
+  report("z = 2*x + y (N = 1)", host_axpy(engine, 1));
+  host_gemms(report, engine, 1, 1, 1, " (1x1x1)");
+
+  //Footprints that cannot hold a single tile are rejected
+  rt::out_of_core tiny;
+  tiny.footprint = sizeof(float);
+  bool thrown = false;
+  try{ host_axpy(tiny, 16); }
+  catch(std::runtime_error const &){ thrown = true; }
+  report("footprint too small", !thrown);
+
+  //The executor keeps its own copy of the context
+  drv::Context const & context = drv::backend::contexts::get_default();
+  rt::out_of_core copied{drv::Context(context)};
+  copied.footprint = 1 << 12;
+  report("z = 2*x + y (temporary context)", host_axpy(copied, 1000));
+
+  return report.status();
+}
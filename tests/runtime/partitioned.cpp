@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/device.h"
+#include "isaac/runtime/partitioned.h"
+#include "host.hpp"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+namespace rt = isaac::runtime;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  report_type report;
+
+  //Two halves of the default device when it can be partitioned, the device itself otherwise
+  drv::Device const & device = drv::backend::contexts::get_default().device();
+  std::vector<drv::Device> devices;
+  device.partition_equally(std::max<size_t>(device.compute_units()/2, 1), devices);
+  rt::partitioned parts(devices);
+  std::cout << "Parts: " << parts.contexts().size() << std::endl;
+
+  int_t N = 10007;
+  std::vector<float> cy(N, -1);
+  rt::host_array y(cy.data(), sc::FLOAT_TYPE, N);
+  parts.first_touch(y);
+  bool failed = false;
+  for(int_t i = 0 ; i < N ; ++i)
+    failed = failed || cy[i] != 0;
+  report("first touch", failed);
+
+  report("z = 2*x + y", host_axpy(parts, N));
+  host_gemms(report, parts, 97, 83, 71);
+
+  //Three parts on the same device, which share one registration of each operand and view it at
+  //their own offsets. The extents are not multiples of the number of parts
+  rt::partitioned thirds(std::vector<drv::Device>(3, device));
+  report("z = 2*x + y (3 parts)", host_axpy(thirds, 1000));
+  host_gemms(report, thirds, 13, 11, 10, " (3 parts)");
+
+  //Fewer units than parts leaves some parts without work
+  report("z = 2*x + y (N = 2, 3 parts)", host_axpy(thirds, 2));
+  host_gemms(report, thirds, 3, 2, 1, " (P = 1, 3 parts)");
+
+  //Every element is written by exactly one part
+  std::vector<float> cw(1001, -1);
+  rt::host_array w(cw.data(), sc::FLOAT_TYPE, cw.size());
+  thirds.first_touch(w);
+  report("first touch (3 parts)", std::count(cw.begin(), cw.end(), 0.f) != (int_t)cw.size());
+
+  //Matrices split by columns, with a leading dimension larger than the number of rows
+  int_t M = 7, K = 10, ld = M + 2;
+  std::vector<float> cA(ld*K), cD(ld*K, -1);
+  for(int_t i = 0 ; i < ld*K ; ++i) cA[i] = (float)(i%13)/13;
+  rt::host_array A(cA.data(), sc::FLOAT_TYPE, M, K, ld), D(cD.data(), sc::FLOAT_TYPE, M, K, ld);
+  thirds.elementwise(D, {A}, [](std::vector<sc::array_base*> const & t){ return *t[0] + 1; });
+  failed = false;
+  for(int_t j = 0 ; j < K ; ++j)
+    for(int_t i = 0 ; i < ld ; ++i)
+      failed = failed || std::fabs(cD[i + j*ld] - ((i < M)?cA[i + j*ld] + 1:-1)) > 1e-4;
+  report("D = A + 1 (3 parts)", failed);
+
+  return report.status();
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "isaac/driver/backend.h"
+#include "isaac/driver/program_cache.h"
+
+namespace drv = isaac::driver;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+  auto stats_are = [](drv::ProgramCache const & cache, size_t size, size_t hits, size_t misses, size_t evictions)
+  {
+    drv::ProgramCache::statistics_type stats = cache.statistics();
+    return stats.size==size && stats.hits==hits && stats.misses==misses && stats.evictions==evictions;
+  };
+
+  //Fingerprints of the keys, which never collide here
+  auto name = [](uint64_t key){ return std::to_string(key); };
+
+  //A single program is compiled, and cached under several keys
+  drv::Context const & context = drv::backend::contexts::get_default();
+  drv::Program program(context, "__kernel void zero(__global float* x){ x[get_global_id(0)] = 0; }");
+  size_t bytes = program.source().size();
+
+  //Bounded number of entries: the least recently used entry goes first
+  drv::ProgramCache entries(3, 0);
+  for(uint64_t key = 1 ; key <= 3 ; ++key)
+    entries.add(key, name(key), program);
+  report("hits and misses", !entries.find(1, name(1)) || !entries.find(2, name(2)) || entries.find(4, name(4)) || !stats_are(entries, 3, 2, 1, 0));
+  entries.add(4, name(4), program);
+  report("evicts the least recently used", entries.find(3, name(3)) || !entries.find(1, name(1)) || !entries.find(2, name(2)) || !entries.find(4, name(4))
+                                           || !stats_are(entries, 3, 5, 2, 1));
+  entries.add(5, name(5), program, 7);
+  entries.add(6, name(6), program, 7);
+  report("evicts in order", entries.find(1, name(1)) || entries.find(2, name(2)) || !entries.find(4, name(4)) || !stats_are(entries, 3, 6, 4, 3));
+  entries.invalidate(7);
+  report("invalidates a scope", entries.find(5, name(5)) || entries.find(6, name(6)) || !entries.find(4, name(4)) || !stats_are(entries, 1, 7, 6, 3));
+
+  //Bounded number of bytes
+  drv::ProgramCache sized(0, 2*bytes);
+  sized.add(1, name(1), program);
+  sized.add(2, name(2), program);
+  sized.add(3, name(3), program);
+  report("evicts past the byte budget", sized.find(1, name(1)) || !sized.find(2, name(2)) || !sized.find(3, name(3))
+                                        || !stats_are(sized, 2, 2, 1, 1) || sized.statistics().bytes!=2*bytes);
+  //The most recent entry is kept even when it exceeds the budget
+  drv::ProgramCache tiny(0, 1);
+  tiny.add(1, name(1), program);
+  tiny.add(2, name(2), program);
+  report("keeps the most recent entry", tiny.find(1, name(1)) || !tiny.find(2, name(2)) || !stats_are(tiny, 1, 1, 1, 1));
+
+  //Programs found stay valid after their entry is evicted
+  std::unique_ptr<drv::Program> found = entries.find(4, name(4));
+  for(uint64_t key = 10 ; key < 20 ; ++key)
+    entries.add(key, name(key), program);
+  report("outlives eviction", entries.find(4, name(4)) || !found || found->source()!=program.source());
+
+  //Colliding keys never share a program: a lookup with another fingerprint misses, and inserting it replaces the entry
+  drv::ProgramCache colliding(0, 0);
+  drv::Program other(context, "__kernel void one(__global float* x){ x[get_global_id(0)] = 1; }");
+  colliding.add(1, "first", program);
+  bool failed = colliding.find(1, "second") || !colliding.find(1, "first");
+  drv::Program inserted = colliding.add(1, "second", other);
+  std::unique_ptr<drv::Program> second = colliding.find(1, "second");
+  failed = failed || inserted!=other || !second || *second!=other || colliding.find(1, "first");
+  drv::ProgramCache::statistics_type collisions = colliding.statistics();
+  report("key collisions", failed || collisions.size!=1 || collisions.collisions!=1 || collisions.hits!=2 || collisions.misses!=2);
+  //Compiling through the cache checks the fingerprint too
+  inserted = colliding.add(context, 1, "first", "__kernel void two(__global float* x){ x[get_global_id(0)] = 2; }");
+  report("key collisions when compiling", inserted==other || inserted.source().find("two")==std::string::npos
+                                          || colliding.statistics().collisions!=2 || colliding.find(1, "second"));
+
+  //Concurrent lookups and insertions on a cache that keeps evicting
+  drv::ProgramCache shared(2, 0);
+  std::vector<std::thread> threads;
+  for(unsigned int t = 0 ; t < 4 ; ++t)
+    threads.push_back(std::thread([&shared, &program, &name, t]{
+      for(uint64_t i = 0 ; i < 1000 ; ++i){
+        uint64_t key = (i*7 + t) % 5;
+        if(std::unique_ptr<drv::Program> x = shared.find(key, name(key)))
+          (void)x->source().size();
+        else
+          shared.add(key, name(key), program);
+      }
+    }));
+  for(std::thread & thread: threads)
+    thread.join();
+  drv::ProgramCache::statistics_type stats = shared.statistics();
+  report("concurrent accesses", stats.size!=2 || stats.hits + stats.misses!=4000);
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
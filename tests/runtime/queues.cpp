@@ -0,0 +1,121 @@
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/runtime/inference/profiles.h"
+
+namespace sc = isaac;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  int_t N = 1 << 20;
+  std::vector<float> cx(N), cz(N);
+  for(int_t i = 0 ; i < N ; ++i)
+    cx[i] = (float)i/N;
+
+  sc::array x(cx), y(N, sc::FLOAT_TYPE), z(N, sc::FLOAT_TYPE);
+
+  #define ADD_QUEUE_TEST(NAME, CPU_EXPR) \
+  {\
+    std::cout << NAME << "..." << std::flush;\
+    sc::copy(z, cz);\
+    bool failed = false;\
+    for(int_t i = 0 ; i < N && !failed ; ++i)\
+      failed = std::fabs(cz[i] - (CPU_EXPR)) > 1e-4;\
+    if(failed){\
+      std::cout << " [Failure!]" << std::endl;\
+      nfail++;\
+    }\
+    else{\
+      std::cout << std::endl;\
+      npass++;\
+    }\
+  }
+
+  //Producer and consumer on different queues
+  {
+    sc::driver::queue_guard guard(1);
+    y = x + 1;
+  }
+  {
+    sc::driver::queue_guard guard(2);
+    z = 2*y;
+  }
+  ADD_QUEUE_TEST("z = 2*(x + 1) across queues", 2*(cx[i] + 1))
+
+  //Write-after-read across queues
+  {
+    sc::driver::queue_guard guard(1);
+    z = y + x;
+  }
+  y = x;
+  ADD_QUEUE_TEST("z = (x + 1) + x, then y = x", 2*cx[i] + 1)
+
+  //Threads submit to their own default queue
+  {
+    std::cout << "z = x + t on concurrent threads..." << std::flush;
+    unsigned int nthreads = 4;
+    std::vector<unsigned int> ids(nthreads);
+    std::vector<int> failures(nthreads, 0);
+    std::vector<std::thread> threads;
+    for(unsigned int t = 0 ; t < nthreads ; ++t)
+      threads.push_back(std::thread([&, t](){
+        ids[t] = sc::driver::backend::queues::current();
+        std::vector<float> ct(N);
+        sc::array tz(N, sc::FLOAT_TYPE);
+        tz = x + (float)t;
+        sc::copy(tz, ct);
+        for(int_t i = 0 ; i < N && !failures[t] ; ++i)
+          failures[t] = std::fabs(ct[i] - (cx[i] + t)) > 1e-4;
+      }));
+    for(std::thread & thread: threads)
+      thread.join();
+    bool failed = std::set<unsigned int>(ids.begin(), ids.end()).size() < nthreads;
+    for(int f: failures)
+      failed = failed || f;
+    if(failed){
+      std::cout << " [Failure!]" << std::endl;
+      nfail++;
+    }
+    else{
+      std::cout << std::endl;
+      npass++;
+    }
+  }
+
+  //Profiles taken before a replacement stay valid
+  {
+    std::cout << "profiles snapshot across set..." << std::flush;
+    namespace rt = sc::runtime;
+    sc::driver::CommandQueue & queue = sc::driver::backend::queues::get(x.context(), 0);
+    std::pair<sc::expression_type, sc::numeric_type> key(sc::ELEMENTWISE_1D, sc::FLOAT_TYPE);
+    rt::profiles::snapshot_type before = rt::profiles::get(queue);
+    std::shared_ptr<rt::profiles::value_type> previous = before->at(key);
+    std::shared_ptr<rt::profiles::value_type> replacement(new rt::profiles::value_type(key.first, key.second, *previous->templates()[0], queue));
+    rt::profiles::set(queue, key.first, key.second, replacement);
+    bool failed = before->at(key)!=previous || rt::profiles::get(queue)->at(key)!=replacement;
+    z = x + 1;
+    sc::copy(z, cz);
+    for(int_t i = 0 ; i < N && !failed ; ++i)
+      failed = std::fabs(cz[i] - (cx[i] + 1)) > 1e-4;
+    rt::profiles::set(queue, key.first, key.second, previous);
+    if(failed){
+      std::cout << " [Failure!]" << std::endl;
+      nfail++;
+    }
+    else{
+      std::cout << std::endl;
+      npass++;
+    }
+  }
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/recording.h"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  //Must precede any other call to ISAAC
+  drv::recording::enable();
+
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+  auto kernels = [](std::vector<drv::recording::command_type> const & commands)
+  {
+    std::vector<std::string> result;
+    for(drv::recording::command_type const & command: commands)
+      if(command.kind==drv::recording::command_type::KERNEL)
+        result.push_back(command.name);
+    return result;
+  };
+  auto starts_with = [](std::string const & str, std::string const & prefix)
+  { return str.compare(0, prefix.size(), prefix)==0; };
+
+  int_t N = 1000;
+  std::vector<float> cx(N), cz(N);
+  for(int_t i = 0 ; i < N ; ++i)
+    cx[i] = (float)i/N;
+  sc::array x(N, sc::FLOAT_TYPE), y(N, sc::FLOAT_TYPE), z(N, sc::FLOAT_TYPE);
+
+  //Transfers operate on host memory
+  sc::copy(cx, y);
+  sc::copy(y, cz);
+  bool failed = false;
+  for(int_t i = 0 ; i < N ; ++i)
+    failed = failed || cz[i]!=cx[i];
+  report("round trip", failed);
+
+  //Elementwise operations enqueue a single kernel
+  drv::recording::clear();
+  x = y + z;
+  std::vector<std::string> names = kernels(drv::recording::commands());
+  report("x = y + z", names.size()!=1 || !starts_with(names[0], "elementwise_1d"));
+  size_t nbuffers = 0;
+  for(drv::recording::argument_type const & argument: drv::recording::commands().back().arguments)
+    nbuffers += argument.buffer >= 0;
+  report("x = y + z arguments", nbuffers!=3);
+
+  //Programs are cached
+  size_t builds = drv::recording::builds().size();
+  report("x = y + z build", builds!=1);
+  x = y + z;
+  report("x = y + z cached", drv::recording::builds().size()!=builds);
+
+  //Reductions enqueue a partial and a final kernel
+  drv::recording::clear();
+  sc::scalar s(sc::FLOAT_TYPE);
+  s = sum(y);
+  names = kernels(drv::recording::commands());
+  report("s = sum(y)", names.size()!=2 || !starts_with(names[0], "prod") || !starts_with(names[1], "reduce"));
+
+  //Buffers touched by a single queue are not tracked, even once the context has several
+  {
+    drv::queue_guard guard(1);
+    sc::array a(N, sc::FLOAT_TYPE), b(N, sc::FLOAT_TYPE);
+    drv::recording::clear();
+    a = b + 1;
+    failed = drv::recording::commands().back().dependencies!=0;
+    for(drv::recording::command_type const & command: drv::recording::commands())
+      failed = failed || command.kind==drv::recording::command_type::MARKER;
+    report("a = b + 1 on a single queue", failed);
+  }
+
+  //A write waits for all the reads since the last write, on every other queue
+  {
+    sc::array r(N, sc::FLOAT_TYPE), u(N, sc::FLOAT_TYPE), v(N, sc::FLOAT_TYPE);
+    r = 1.f;
+    {
+      drv::queue_guard guard(1);
+      u = r + 1;
+    }
+    {
+      drv::queue_guard guard(2);
+      v = 2*r;
+    }
+    drv::queue_guard guard(3);
+    drv::recording::clear();
+    r = 3.f;
+    //Commands of queue 0, summarized by a marker, and the reads of queues 1 and 2
+    report("r = 3 after reads on two queues", drv::recording::commands().back().dependencies!=3);
+  }
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,67 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/runtime/execute.h"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+namespace rt = isaac::runtime;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  rt::compilation_options_type options;
+  options.async = false;
+  options.specialize_after = 3;
+
+  //C = A*B, executed specialize_after + 1 times. Only the call that makes the shape hot adds a program
+  auto gemm = [&](int_t M, int_t K, int_t N, bool transA)
+  {
+    std::string name = "C = " + std::string(transA?"A'":"A") + "*B (" + std::to_string(M) + "x" + std::to_string(K) + "x" + std::to_string(N) + ")";
+    std::vector<float> cA(M*K), cB(K*N), cC(M*N, 0), cx(M*N);
+    for(int_t i = 0 ; i < M*K ; ++i) cA[i] = (float)(i % 17)/17 - .5f;
+    for(int_t i = 0 ; i < K*N ; ++i) cB[i] = (float)(i % 13)/13 - .5f;
+    for(int_t i = 0 ; i < M ; ++i)
+      for(int_t j = 0 ; j < N ; ++j)
+        for(int_t k = 0 ; k < K ; ++k)
+          cC[i + j*M] += (transA?cA[k + i*K]:cA[i + k*M])*cB[k + j*K];
+    sc::array A(transA?K:M, transA?M:K, cA), B(K, N, cB), C(M, N, sc::FLOAT_TYPE);
+    std::vector<size_t> programs;
+    bool failed = false;
+    for(unsigned int call = 0 ; call <= options.specialize_after ; ++call)
+    {
+      C = 0;
+      rt::execute(rt::execution_handler(transA?sc::assign(C, dot(A.T, B)):sc::assign(C, dot(A, B)), rt::execution_options_type(), rt::dispatcher_options_type(), options));
+      programs.push_back(drv::backend::programs::statistics().size);
+      sc::copy(C, cx);
+      for(int_t i = 0 ; i < M*N ; ++i)
+        failed = failed || std::fabs(cx[i] - cC[i]) > 1e-3*std::max(1.f, std::fabs(cC[i]));
+    }
+    report(name, failed);
+    //programs[0] includes the generic program of the shape
+    bool hot = programs[1]==programs[0] && programs[2]==programs[1] + 1 && programs[3]==programs[2];
+    report(name + " specialized after " + std::to_string(options.specialize_after) + " calls", !hot);
+  };
+
+  //Sizes that the tiles divide, for which bound checks are dropped, and sizes that they do not divide
+  gemm(64, 64, 64, false);
+  gemm(67, 45, 53, false);
+  gemm(67, 45, 53, true);
+  gemm(1, 3, 1, false);
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+
+namespace sc = isaac;
+typedef isaac::int_t int_t;
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  //Not a multiple of the staging chunks
+  int_t N = (5*sc::driver::backend::staging::CHUNK)/(2*sizeof(float)) + 3;
+  std::vector<float> cx(N), cy(N), cz(N);
+  for(int_t i = 0 ; i < N ; ++i)
+    cx[i] = (float)i/N;
+
+  #define ADD_TRANSFER_TEST(NAME, CPU_EXPR) \
+  {\
+    std::cout << NAME << "..." << std::flush;\
+    bool failed = false;\
+    for(int_t i = 0 ; i < N && !failed ; ++i)\
+      failed = std::fabs(cz[i] - (CPU_EXPR)) > 1e-4;\
+    if(failed){\
+      std::cout << " [Failure!]" << std::endl;\
+      nfail++;\
+    }\
+    else{\
+      std::cout << std::endl;\
+      npass++;\
+    }\
+  }
+
+  //Large transfers
+  sc::array x(N, sc::FLOAT_TYPE);
+  sc::copy(cx, x);
+  sc::copy(x, cz);
+  ADD_TRANSFER_TEST("round trip", cx[i])
+
+  //Zero-copy arrays
+  sc::array y(sc::tuple{N}, sc::FLOAT_TYPE, (void*)cy.data());
+  y = x + 1;
+  sc::copy(y, cz);
+  ADD_TRANSFER_TEST("zero-copy y = x + 1", cx[i] + 1)
+  sc::copy(y, cy);
+  cz = cy;
+  ADD_TRANSFER_TEST("zero-copy in place", cx[i] + 1)
+
+  //Strided views of a column-major matrix
+  int_t M = 68, K = 45;
+  std::vector<float> cA(M*K);
+  for(int_t i = 0 ; i < M*K ; ++i)
+    cA[i] = i;
+  sc::array A(M, K, cA);
+  auto check = [&](std::string const & name, sc::view const & view, int_t rows, int_t cols, int_t start, int_t ld0, int_t ld1)
+  {
+    std::cout << name << "..." << std::flush;
+    std::vector<float> cview(rows*cols);
+    sc::copy(view, cview);
+    bool failed = false;
+    for(int_t j = 0 ; j < cols ; ++j)
+      for(int_t i = 0 ; i < rows ; ++i)
+        failed = failed || cview[i + j*rows] != cA[start + i*ld0 + j*ld1];
+    if(failed){
+      std::cout << " [Failure!]" << std::endl;
+      nfail++;
+    }
+    else{
+      std::cout << std::endl;
+      npass++;
+    }
+  };
+  check("column", A(sc::slice(0, M), 3), M, 1, 3*M, 1, 0);
+  check("row", A(5, sc::slice(0, K)), 1, K, 5, 0, M);
+  check("submatrix", A(sc::slice(1, M - 1), sc::slice(2, K)), M - 2, K - 2, 1 + 2*M, 1, M);
+  check("strided submatrix", A(sc::slice(0, M, 2), sc::slice(0, K, 3)), M/2, K/3, 0, 2, 3*M);
+
+  //Writes leave the rest of the matrix untouched
+  sc::view B = A(sc::slice(0, M, 2), sc::slice(1, K));
+  sc::copy(std::vector<float>(B.shape()[0]*B.shape()[1], -1), B);
+  for(int_t j = 1 ; j < K ; ++j)
+    for(int_t i = 0 ; i < M ; i += 2)
+      cA[i + j*M] = -1;
+  check("strided write", A(sc::slice(0, M), sc::slice(0, K)), M, K, 0, 1, M);
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
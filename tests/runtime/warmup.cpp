@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/common/instrumentation.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/program.h"
+#include "isaac/runtime/warmup.h"
+
+namespace drv = isaac::driver;
+namespace rt = isaac::runtime;
+
+//Number of programs in a bundle
+static uint32_t bundle_size(std::string const & path)
+{
+  std::ifstream file(path.c_str(), std::ios::binary);
+  char magic[8];
+  uint32_t version = 0, count = 0;
+  file.read(magic, sizeof(magic));
+  file.read((char*)&version, sizeof(version));
+  file.read((char*)&count, sizeof(count));
+  return file?count:0;
+}
+
+int main()
+{
+  //Must precede any other call to ISAAC: no on-disk cache, and programs are traced
+  std::string trace = "warmup-test.trace", bundle = "warmup-test.bundle";
+  std::remove(trace.c_str());
+  unsetenv("ISAAC_CACHE_PATH");
+  unsetenv("HOME");
+  setenv("ISAAC_TRACE", trace.c_str(), 1);
+
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  drv::Context const & context = drv::backend::contexts::get_default();
+  drv::CommandQueue & queue = drv::backend::queues::get(context, 0);
+  namespace instr = isaac::instrumentation;
+
+  //Programs built with and without options are served from a bundle built from their trace
+  std::string source = "__kernel void f(__global float* x){\n#pragma unroll\nfor(int i = 0 ; i < 4 ; ++i) x[i] = 0; }";
+  drv::CompilerOptions options;
+  options.fast_math = true;
+  options.unroll = 2;
+  options.extra = "-DUNUSED=1";
+  auto compile = [&]{
+    drv::Program(context, source);
+    drv::Program(context, source, options);
+  };
+  compile();
+  rt::warmup(queue, {}, {trace}, bundle);
+  drv::backend::programs::load(bundle);
+  instr::reset();
+  compile();
+  instr::statistics_type stats = instr::statistics();
+  report("trace with compiler options", bundle_size(bundle)!=2 || stats.events[instr::BINARY_CACHE_HIT].count!=2
+                                        || stats.events[instr::BINARY_CACHE_MISS].count!=0);
+
+  //Binaries are captured even without a cache path
+  rt::warmup(queue, {"axpy", "dot"}, {}, bundle);
+  report("signatures without cache path", bundle_size(bundle)==0);
+
+  std::remove(bundle.c_str());
+  std::remove(trace.c_str());
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
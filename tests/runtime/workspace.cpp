@@ -0,0 +1,84 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "isaac/array.h"
+#include "isaac/driver/backend.h"
+#include "isaac/driver/dispatch.h"
+
+namespace sc = isaac;
+namespace drv = isaac::driver;
+typedef isaac::int_t int_t;
+typedef drv::backend::workspaces workspaces;
+
+//Bytes allocated for a buffer, rounded up by the memory pool
+static size_t size(drv::Buffer const & buffer)
+{
+  size_t result = 0;
+  drv::dispatch::clGetMemObjectInfo(buffer.handle().cl(), CL_MEM_SIZE, sizeof(result), &result, NULL);
+  return result;
+}
+
+int main()
+{
+  int nfail = 0, npass = 0;
+  auto report = [&](std::string const & name, bool failed)
+  {
+    std::cout << name << "..." << (failed?" [Failure!]":"") << std::endl;
+    if(failed) nfail++;
+    else npass++;
+  };
+
+  drv::Context const & context = drv::backend::contexts::get_default();
+  drv::CommandQueue & queue = drv::backend::queues::get(context, 0);
+  drv::CommandQueue & other = drv::backend::queues::get(context, 1);
+  size_t limit = workspaces::max_size;
+
+  //Queues start with SIZE bytes each, and keep them for smaller requests
+  drv::Buffer & workspace = workspaces::get(queue);
+  cl_mem initial = workspace.handle().cl();
+  report("initial size", size(workspace) < workspaces::SIZE);
+  report("smaller request", &workspaces::get(queue, workspaces::SIZE/2)!=&workspace || workspace.handle().cl()!=initial);
+  report("one workspace per queue", &workspaces::get(other)==&workspace);
+
+  //Larger requests at least double the workspace, in place
+  drv::Buffer & grown = workspaces::get(queue, workspaces::SIZE + 1);
+  report("growth", &grown!=&workspace || size(grown) < 2*workspaces::SIZE);
+
+  //Up to the cap, beyond which requests throw and leave the workspace alone
+  workspaces::max_size = 3*workspaces::SIZE;
+  workspaces::get(queue, 2*workspaces::SIZE + 1);
+  report("capped growth", size(workspace) < workspaces::max_size || size(workspace) >= 4*workspaces::SIZE);
+  cl_mem capped = workspace.handle().cl();
+  bool thrown = false;
+  try{
+    workspaces::get(queue, workspaces::max_size + 1);
+  }catch(std::runtime_error const &){
+    thrown = true;
+  }
+  report("over the cap", !thrown || workspace.handle().cl()!=capped);
+  workspaces::max_size = limit;
+
+  //Deep products may use split-K templates, whose partial results go to the workspace
+  int_t M = 8, N = 8, K = 1 << 16;
+  std::vector<float> cA(M*K), cB(K*N), cC(M*N, 0), cx(M*N);
+  for(int_t i = 0 ; i < M*K ; ++i) cA[i] = (float)(i % 7)/7 - .5f;
+  for(int_t i = 0 ; i < K*N ; ++i) cB[i] = (float)(i % 5)/5 - .5f;
+  for(int_t j = 0 ; j < N ; ++j)
+    for(int_t k = 0 ; k < K ; ++k)
+      for(int_t i = 0 ; i < M ; ++i)
+        cC[i + j*M] += cA[i + k*M]*cB[k + j*K];
+  sc::array A(M, K, cA), B(K, N, cB), C(M, N, sc::FLOAT_TYPE);
+  C = dot(A, B);
+  sc::copy(C, cx);
+  bool failed = false;
+  for(int_t i = 0 ; i < M*N ; ++i)
+    failed = failed || std::fabs(cx[i] - cC[i]) > 1e-3*std::max(1.f, std::fabs(cC[i]));
+  report("deep product", failed);
+
+  if(nfail>0)
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
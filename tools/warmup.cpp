@@ -0,0 +1,50 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "isaac/driver/backend.h"
+#include "isaac/driver/context.h"
+#include "isaac/driver/command_queue.h"
+#include "isaac/runtime/warmup.h"
+
+namespace sc = isaac;
+
+static int usage(const char * name)
+{
+  std::cerr << "Usage: " << name << " [--device ID] [--trace FILE]... [--signature OP[:DTYPE]]... --output BUNDLE" << std::endl;
+  std::cerr << "Compiles the programs needed by the given traces (recorded with ISAAC_TRACE=FILE)" << std::endl;
+  std::cerr << "and signatures for the target device, and packs them into BUNDLE (loaded with ISAAC_BUNDLE=BUNDLE)." << std::endl;
+  return 1;
+}
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> traces, signatures;
+  std::string output;
+  for(int i = 1 ; i < argc ; ++i)
+  {
+    std::string arg = argv[i];
+    if(i + 1 >= argc)
+      return usage(argv[0]);
+    if(arg=="--device")
+      sc::driver::backend::default_device = std::atoi(argv[++i]);
+    else if(arg=="--trace")
+      traces.push_back(argv[++i]);
+    else if(arg=="--signature")
+      signatures.push_back(argv[++i]);
+    else if(arg=="--output")
+      output = argv[++i];
+    else
+      return usage(argv[0]);
+  }
+  if(output.empty() || (traces.empty() && signatures.empty()))
+    return usage(argv[0]);
+
+  sc::driver::Context const & context = sc::driver::backend::contexts::get_default();
+  sc::driver::CommandQueue & queue = sc::driver::backend::queues::get(context, 0);
+  std::cout << "Device: " << context.device().name() << std::endl;
+  sc::runtime::warmup(queue, signatures, traces, output);
+  std::cout << "Bundle written to " << output << std::endl;
+  return 0;
+}